@@ -0,0 +1,525 @@
+// Microbenchmarks for every operation the visualizers expose, run directly on
+// the headless core library (no animation, no SFML).
+//
+//   dsbench [--min-n N] [--max-n N] [--reps R] [--warmup W] [--seed S]
+//           [--filter TEXT] [--out FILE] [--track-allocs] [--workload NAME]
+//   dsbench --check-complexity [--filter TEXT] [--seed S]
+//
+// N runs over powers of ten between --min-n and --max-n (default 10 .. 10^7).
+// Each sample times a batch of operations on one structure of size N and then
+// restores the size outside the timed region. The batch is calibrated during
+// warm-up so that a sample takes roughly 200us. Results are written as JSON
+// with per-operation nanoseconds (median and percentiles over the samples).
+// --track-allocs also reports heap allocations and bytes per operation, counted
+// over the timed part of every sample. --workload fills the array, list and BST
+// from a core/workload.h sequence (e.g. "sorted" degenerates the BST) instead
+// of uniform random values.
+//
+// --check-complexity instead runs the complexity explorer's sweeps and exits
+// with 1 if the slope class of any is not its textbook one. The least-error
+// fit is printed beside it.
+
+#include "../core/alloc_tracker.h"
+#include "../core/complexity.h"
+#include "../core/search.h"
+#include "../core/structures.h"
+#include "../core/workload.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+struct Options {
+    size_t minN = 10;
+    size_t maxN = 10000000;
+    int reps = 25;
+    int warmup = 3;
+    unsigned long long seed = 42;
+    std::string filter;
+    std::string outPath;
+    bool trackAllocs = false;
+    bool checkComplexity = false;
+    bool hasWorkload = false;
+    core::Workload workload = core::Workload::Uniform;
+};
+
+struct Result {
+    std::string name;
+    size_t n;
+    size_t batch;
+    std::vector<double> samples;  // ns per operation
+    core::AllocCounts allocs;     // Over all timed samples
+    size_t operations = 0;
+};
+
+// Keeps benchmarked reads from being optimized away
+volatile size_t sink = 0;
+
+const double TARGET_SAMPLE_NS = 200000.0;
+
+// Times `op(i)` for i in [0, batch) per sample and then calls `undo(batch)`
+// untimed so every sample starts from a structure of the same size. The batch
+// is capped at maxBatch so that size drift within a sample stays small.
+template <typename Op, typename Undo>
+Result measure(const std::string& name, size_t n, const Options& options,
+               size_t maxBatch, Op op, Undo undo) {
+    core::AllocCounts allocs;
+    auto runBatch = [&](size_t batch) {
+        core::AllocCounts before = core::AllocTracker::snapshot();
+        auto start = Clock::now();
+        for (size_t i = 0; i < batch; ++i) {
+            op(i);
+        }
+        auto end = Clock::now();
+        allocs += core::AllocTracker::snapshot() - before;
+        undo(batch);
+        return std::chrono::duration<double, std::nano>(end - start).count();
+    };
+
+    // Calibrate on the warm-up runs
+    size_t batch = 1;
+    for (int i = 0; i < options.warmup; ++i) {
+        double elapsed = runBatch(batch);
+        double perOp = std::max(elapsed / batch, 1.0);
+        batch = static_cast<size_t>(TARGET_SAMPLE_NS / perOp);
+        batch = std::max<size_t>(1, std::min(batch, maxBatch));
+    }
+
+    Result result{name, n, batch, {}, {}, batch * options.reps};
+    result.samples.reserve(options.reps);
+    allocs = core::AllocCounts();
+    for (int i = 0; i < options.reps; ++i) {
+        result.samples.push_back(runBatch(batch) / batch);
+    }
+    result.allocs = allocs;
+    return result;
+}
+
+// Most size-changing operations may drift the size by at most 1/8th
+size_t growthBatch(size_t n) { return std::max<size_t>(1, n / 8); }
+const size_t READ_BATCH = 1 << 16;
+
+int randomValue(std::mt19937_64& rng, size_t n) {
+    return static_cast<int>(rng() % (4 * n + 1));
+}
+
+size_t randomIndex(std::mt19937_64& rng, size_t count) {
+    return static_cast<size_t>(rng() % count);
+}
+
+// Initial contents of a structure of size n: uniform random, or the --workload
+// sequence seeded from the run's generator
+std::vector<int> initialValues(size_t n, const Options& options, std::mt19937_64& rng) {
+    if (!options.hasWorkload) {
+        std::vector<int> values(n);
+        for (int& value : values) value = randomValue(rng, n);
+        return values;
+    }
+    core::WorkloadSpec spec;
+    spec.kind = options.workload;
+    spec.count = n;
+    spec.seed = rng();
+    spec.maxValue = static_cast<int>(4 * n);
+    return core::generateWorkload(spec);
+}
+
+// Each benchmark builds its structure for a given N and appends one Result
+using Benchmark = std::function<void(size_t n, const Options&, std::mt19937_64&, std::vector<Result>&)>;
+
+struct Entry {
+    const char* name;
+    Benchmark run;
+};
+
+std::vector<Entry> makeBenchmarks() {
+    std::vector<Entry> benchmarks;
+
+    // Array
+
+    auto fillArray = [](core::Array& array, size_t n, const Options& o, std::mt19937_64& rng) {
+        std::vector<int> values = initialValues(n, o, rng);
+        for (size_t i = 0; i < n; ++i) {
+            array.insert(i, values[i]);
+        }
+    };
+
+    benchmarks.push_back({"array.insert", [=](size_t n, const Options& o, std::mt19937_64& rng, std::vector<Result>& out) {
+        core::Array array;
+        fillArray(array, n, o, rng);
+        out.push_back(measure("array.insert", n, o, growthBatch(n),
+            [&](size_t) { array.insert(randomIndex(rng, array.size() + 1), 1); },
+            [&](size_t batch) { for (size_t i = 0; i < batch; ++i) array.remove(array.size() - 1); }));
+    }});
+
+    benchmarks.push_back({"array.remove", [=](size_t n, const Options& o, std::mt19937_64& rng, std::vector<Result>& out) {
+        core::Array array;
+        fillArray(array, n, o, rng);
+        out.push_back(measure("array.remove", n, o, growthBatch(n),
+            [&](size_t) { array.remove(randomIndex(rng, array.size())); },
+            [&](size_t batch) { for (size_t i = 0; i < batch; ++i) array.insert(array.size(), 1); }));
+    }});
+
+    benchmarks.push_back({"array.update", [=](size_t n, const Options& o, std::mt19937_64& rng, std::vector<Result>& out) {
+        core::Array array;
+        fillArray(array, n, o, rng);
+        out.push_back(measure("array.update", n, o, READ_BATCH,
+            [&](size_t i) { array.update(randomIndex(rng, n), static_cast<int>(i)); },
+            [](size_t) {}));
+    }});
+
+    benchmarks.push_back({"array.search", [=](size_t n, const Options& o, std::mt19937_64& rng, std::vector<Result>& out) {
+        core::Array array;
+        fillArray(array, n, o, rng);
+        out.push_back(measure("array.search", n, o, READ_BATCH,
+            [&](size_t) { sink = sink + array.find(randomValue(rng, n)); },
+            [](size_t) {}));
+    }});
+
+    // The same lookups over the sorted contents, one entry per core/search.h mode
+    auto addSortedSearch = [&](const char* name, core::SortedSearch method) {
+        benchmarks.push_back({name, [=](size_t n, const Options& o, std::mt19937_64& rng, std::vector<Result>& out) {
+            std::vector<int> values = initialValues(n, o, rng);
+            std::sort(values.begin(), values.end());
+            out.push_back(measure(name, n, o, READ_BATCH,
+                [&](size_t) { sink = sink + core::sortedSearch(method, values.data(), n, randomValue(rng, n)); },
+                [](size_t) {}));
+        }});
+    };
+    addSortedSearch("array.search_binary", core::SortedSearch::Binary);
+    addSortedSearch("array.search_branchless", core::SortedSearch::Branchless);
+    addSortedSearch("array.search_interpolation", core::SortedSearch::Interpolation);
+    addSortedSearch("array.search_exponential", core::SortedSearch::Exponential);
+
+    // String
+
+    auto fillString = [](core::String& text, size_t n, std::mt19937_64& rng) {
+        std::string value(n, 'a');
+        for (char& c : value) {
+            c = static_cast<char>('a' + rng() % 26);
+        }
+        text = core::String(value);
+    };
+
+    benchmarks.push_back({"string.insert", [=](size_t n, const Options& o, std::mt19937_64& rng, std::vector<Result>& out) {
+        core::String text;
+        fillString(text, n, rng);
+        const std::string value = "x";
+        out.push_back(measure("string.insert", n, o, growthBatch(n),
+            [&](size_t) { text.insert(randomIndex(rng, text.size() + 1), value); },
+            [&](size_t batch) { for (size_t i = 0; i < batch; ++i) text.remove(text.size() - 1); }));
+    }});
+
+    benchmarks.push_back({"string.remove", [=](size_t n, const Options& o, std::mt19937_64& rng, std::vector<Result>& out) {
+        core::String text;
+        fillString(text, n, rng);
+        const std::string value = "x";
+        out.push_back(measure("string.remove", n, o, growthBatch(n),
+            [&](size_t) { text.remove(randomIndex(rng, text.size())); },
+            [&](size_t batch) { for (size_t i = 0; i < batch; ++i) text.insert(text.size(), value); }));
+    }});
+
+    // Linked list. Undo always works at the head, which is O(1).
+
+    auto fillList = [](core::LinkedList& list, size_t n, const Options& o, std::mt19937_64& rng) {
+        for (int value : initialValues(n, o, rng)) {
+            list.pushBack(value);
+        }
+    };
+    auto shrinkList = [](core::LinkedList& list) {
+        return [&list](size_t batch) { for (size_t i = 0; i < batch; ++i) list.remove(0); };
+    };
+
+    benchmarks.push_back({"list.insert_head", [=](size_t n, const Options& o, std::mt19937_64& rng, std::vector<Result>& out) {
+        core::LinkedList list;
+        fillList(list, n, o, rng);
+        out.push_back(measure("list.insert_head", n, o, growthBatch(n),
+            [&](size_t i) { list.pushFront(static_cast<int>(i)); }, shrinkList(list)));
+    }});
+
+    benchmarks.push_back({"list.insert_tail", [=](size_t n, const Options& o, std::mt19937_64& rng, std::vector<Result>& out) {
+        core::LinkedList list;
+        fillList(list, n, o, rng);
+        out.push_back(measure("list.insert_tail", n, o, growthBatch(n),
+            [&](size_t i) { list.pushBack(static_cast<int>(i)); }, shrinkList(list)));
+    }});
+
+    benchmarks.push_back({"list.insert_position", [=](size_t n, const Options& o, std::mt19937_64& rng, std::vector<Result>& out) {
+        core::LinkedList list;
+        fillList(list, n, o, rng);
+        out.push_back(measure("list.insert_position", n, o, growthBatch(n),
+            [&](size_t i) { list.insert(randomIndex(rng, list.size() + 1), static_cast<int>(i)); },
+            shrinkList(list)));
+    }});
+
+    benchmarks.push_back({"list.delete", [=](size_t n, const Options& o, std::mt19937_64& rng, std::vector<Result>& out) {
+        core::LinkedList list;
+        fillList(list, n, o, rng);
+        out.push_back(measure("list.delete", n, o, growthBatch(n),
+            [&](size_t) { list.remove(randomIndex(rng, list.size())); },
+            [&](size_t batch) { for (size_t i = 0; i < batch; ++i) list.pushFront(1); }));
+    }});
+
+    benchmarks.push_back({"list.search", [=](size_t n, const Options& o, std::mt19937_64& rng, std::vector<Result>& out) {
+        core::LinkedList list;
+        fillList(list, n, o, rng);
+        out.push_back(measure("list.search", n, o, READ_BATCH,
+            [&](size_t) { sink = sink + list.find(randomValue(rng, n)); },
+            [](size_t) {}));
+    }});
+
+    // Stack and queue
+
+    benchmarks.push_back({"stack.push", [=](size_t n, const Options& o, std::mt19937_64&, std::vector<Result>& out) {
+        core::Stack stack;
+        for (size_t i = 0; i < n; ++i) stack.push(static_cast<int>(i));
+        out.push_back(measure("stack.push", n, o, growthBatch(n),
+            [&](size_t i) { stack.push(static_cast<int>(i)); },
+            [&](size_t batch) { for (size_t i = 0; i < batch; ++i) stack.pop(); }));
+    }});
+
+    benchmarks.push_back({"stack.pop", [=](size_t n, const Options& o, std::mt19937_64&, std::vector<Result>& out) {
+        core::Stack stack;
+        for (size_t i = 0; i < n; ++i) stack.push(static_cast<int>(i));
+        out.push_back(measure("stack.pop", n, o, growthBatch(n),
+            [&](size_t) { stack.pop(); },
+            [&](size_t batch) { for (size_t i = 0; i < batch; ++i) stack.push(1); }));
+    }});
+
+    benchmarks.push_back({"queue.enqueue", [=](size_t n, const Options& o, std::mt19937_64&, std::vector<Result>& out) {
+        core::Queue queue;
+        for (size_t i = 0; i < n; ++i) queue.enqueue(static_cast<int>(i));
+        out.push_back(measure("queue.enqueue", n, o, growthBatch(n),
+            [&](size_t i) { queue.enqueue(static_cast<int>(i)); },
+            [&](size_t batch) { for (size_t i = 0; i < batch; ++i) queue.dequeue(); }));
+    }});
+
+    benchmarks.push_back({"queue.dequeue", [=](size_t n, const Options& o, std::mt19937_64&, std::vector<Result>& out) {
+        core::Queue queue;
+        for (size_t i = 0; i < n; ++i) queue.enqueue(static_cast<int>(i));
+        out.push_back(measure("queue.dequeue", n, o, growthBatch(n),
+            [&](size_t) { queue.dequeue(); },
+            [&](size_t batch) { for (size_t i = 0; i < batch; ++i) queue.enqueue(1); }));
+    }});
+
+    // BST, built from random keys so the expected height is O(log n) (unless a
+    // --workload says otherwise)
+
+    auto fillTree = [](core::BinarySearchTree& tree, std::vector<int>& keys, size_t n,
+                       const Options& o, std::mt19937_64& rng) {
+        keys = initialValues(n, o, rng);
+        // The tree inserting the keys in order builds, without the O(n^2)
+        // cost of actually inserting sorted or reversed keys
+        tree.assignInsertOrder(keys.data(), keys.size());
+    };
+
+    benchmarks.push_back({"bst.insert", [=](size_t n, const Options& o, std::mt19937_64& rng, std::vector<Result>& out) {
+        core::BinarySearchTree tree;
+        std::vector<int> keys, inserted;
+        fillTree(tree, keys, n, o, rng);
+        out.push_back(measure("bst.insert", n, o, growthBatch(n),
+            [&](size_t) { int key = randomValue(rng, n); tree.insert(key); inserted.push_back(key); },
+            [&](size_t) { for (int key : inserted) tree.remove(key); inserted.clear(); }));
+    }});
+
+    benchmarks.push_back({"bst.remove", [=](size_t n, const Options& o, std::mt19937_64& rng, std::vector<Result>& out) {
+        core::BinarySearchTree tree;
+        std::vector<int> keys, removed;
+        fillTree(tree, keys, n, o, rng);
+        out.push_back(measure("bst.remove", n, o, growthBatch(n),
+            [&](size_t) {
+                int key = keys[randomIndex(rng, keys.size())];
+                if (tree.remove(key)) removed.push_back(key);
+            },
+            [&](size_t) { for (int key : removed) tree.insert(key); removed.clear(); }));
+    }});
+
+    benchmarks.push_back({"bst.search", [=](size_t n, const Options& o, std::mt19937_64& rng, std::vector<Result>& out) {
+        core::BinarySearchTree tree;
+        std::vector<int> keys;
+        fillTree(tree, keys, n, o, rng);
+        out.push_back(measure("bst.search", n, o, READ_BATCH,
+            [&](size_t) { sink = sink + tree.contains(randomValue(rng, n)); },
+            [](size_t) {}));
+    }});
+
+    benchmarks.push_back({"bst.traversals", [=](size_t n, const Options& o, std::mt19937_64& rng, std::vector<Result>& out) {
+        core::BinarySearchTree tree;
+        std::vector<int> keys;
+        fillTree(tree, keys, n, o, rng);
+        out.push_back(measure("bst.inorder", n, o, READ_BATCH,
+            [&](size_t) { sink = sink + tree.inorder().size(); }, [](size_t) {}));
+        out.push_back(measure("bst.preorder", n, o, READ_BATCH,
+            [&](size_t) { sink = sink + tree.preorder().size(); }, [](size_t) {}));
+        out.push_back(measure("bst.postorder", n, o, READ_BATCH,
+            [&](size_t) { sink = sink + tree.postorder().size(); }, [](size_t) {}));
+    }});
+
+    // One op is a whole O(n) build from sorted keys
+    benchmarks.push_back({"bst.build_balanced", [=](size_t n, const Options& o, std::mt19937_64& rng, std::vector<Result>& out) {
+        std::vector<int> keys = initialValues(n, o, rng);
+        std::sort(keys.begin(), keys.end());
+        core::BinarySearchTree tree;
+        out.push_back(measure("bst.build_balanced", n, o, READ_BATCH,
+            [&](size_t) { tree.assignSorted(keys.data(), keys.size()); sink = sink + tree.size(); },
+            [](size_t) {}));
+    }});
+
+    return benchmarks;
+}
+
+// Linear interpolation between closest ranks, p in [0, 100]
+double percentile(std::vector<double> sorted, double p) {
+    std::sort(sorted.begin(), sorted.end());
+    if (sorted.empty()) {
+        return 0.0;
+    }
+    double rank = p / 100.0 * (sorted.size() - 1);
+    size_t low = static_cast<size_t>(rank);
+    size_t high = std::min(low + 1, sorted.size() - 1);
+    return sorted[low] + (sorted[high] - sorted[low]) * (rank - low);
+}
+
+void writeJson(FILE* out, const Options& options, const std::vector<Result>& results) {
+    std::fprintf(out, "{\n  \"unit\": \"ns/op\",\n  \"reps\": %d,\n  \"warmup\": %d,\n  \"seed\": %llu,\n",
+                 options.reps, options.warmup, options.seed);
+    std::fprintf(out, "  \"workload\": \"%s\",\n",
+                 options.hasWorkload ? core::workloadName(options.workload) : "random");
+    std::fprintf(out, "  \"benchmarks\": [\n");
+    for (size_t i = 0; i < results.size(); ++i) {
+        const Result& r = results[i];
+        std::fprintf(out,
+            "    {\"name\": \"%s\", \"n\": %zu, \"batch\": %zu, \"median\": %.2f, "
+            "\"p10\": %.2f, \"p90\": %.2f, \"p99\": %.2f, \"min\": %.2f, \"max\": %.2f",
+            r.name.c_str(), r.n, r.batch,
+            percentile(r.samples, 50), percentile(r.samples, 10), percentile(r.samples, 90),
+            percentile(r.samples, 99), percentile(r.samples, 0), percentile(r.samples, 100));
+        if (options.trackAllocs) {
+            double ops = static_cast<double>(std::max<size_t>(r.operations, 1));
+            std::fprintf(out, ", \"allocs_per_op\": %.3f, \"bytes_per_op\": %.1f",
+                         r.allocs.allocations / ops, r.allocs.bytes / ops);
+        }
+        std::fprintf(out, "}%s\n", i + 1 < results.size() ? "," : "");
+    }
+    std::fprintf(out, "  ]\n}\n");
+}
+
+void printUsage() {
+    std::fprintf(stderr,
+        "usage: dsbench [--min-n N] [--max-n N] [--reps R] [--warmup W] [--seed S]\n"
+        "               [--filter TEXT] [--out FILE] [--track-allocs] [--workload NAME]\n"
+        "       dsbench --check-complexity [--filter TEXT] [--seed S]\n"
+        "workloads: uniform sorted reverse nearly-sorted zipf duplicates zigzag organ-pipe\n");
+}
+
+bool parseOptions(int argc, char** argv, Options& options) {
+    for (int i = 1; i < argc; ++i) {
+        const char* arg = argv[i];
+        if (std::strcmp(arg, "--track-allocs") == 0) {
+            options.trackAllocs = true;
+            continue;
+        }
+        if (std::strcmp(arg, "--check-complexity") == 0) {
+            options.checkComplexity = true;
+            continue;
+        }
+        if (i + 1 >= argc) {
+            return false;
+        }
+        const char* value = argv[++i];
+        if (std::strcmp(arg, "--min-n") == 0) {
+            options.minN = std::strtoull(value, nullptr, 10);
+        } else if (std::strcmp(arg, "--max-n") == 0) {
+            options.maxN = std::strtoull(value, nullptr, 10);
+        } else if (std::strcmp(arg, "--reps") == 0) {
+            options.reps = std::atoi(value);
+        } else if (std::strcmp(arg, "--warmup") == 0) {
+            options.warmup = std::atoi(value);
+        } else if (std::strcmp(arg, "--seed") == 0) {
+            options.seed = std::strtoull(value, nullptr, 10);
+        } else if (std::strcmp(arg, "--filter") == 0) {
+            options.filter = value;
+        } else if (std::strcmp(arg, "--out") == 0) {
+            options.outPath = value;
+        } else if (std::strcmp(arg, "--workload") == 0) {
+            if (!core::parseWorkload(value, options.workload)) {
+                return false;
+            }
+            options.hasWorkload = true;
+        } else {
+            return false;
+        }
+    }
+    return options.minN >= 1 && options.minN <= options.maxN && options.reps >= 1 && options.warmup >= 1;
+}
+
+// Every sweep's slope class against its expected one; false if any differs
+bool checkComplexity(const Options& options) {
+    bool ok = true;
+    for (const core::SweepOperation& operation : core::sweepOperations()) {
+        if (!options.filter.empty() && std::string(operation.name).find(options.filter) == std::string::npos) {
+            continue;
+        }
+        core::ComplexitySweep sweep(operation, 16, options.seed);
+        while (sweep.step()) {
+        }
+        core::ComplexityFit fit = core::fitComplexity(sweep.getSamples()).front();
+        core::Complexity measured = core::complexityForSlope(fit.slope);
+        bool match = measured == operation.expected;
+        std::printf("%-30s slope %5.2f: %-10s best fit %-10s  %s\n", operation.name, fit.slope,
+                    core::complexityName(measured), core::complexityName(fit.model),
+                    match ? "ok" : (std::string("expected ") + core::complexityName(operation.expected)).c_str());
+        ok = ok && match;
+    }
+    return ok;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Options options;
+    if (!parseOptions(argc, argv, options)) {
+        printUsage();
+        return 1;
+    }
+    if (options.checkComplexity) {
+        return checkComplexity(options) ? 0 : 1;
+    }
+    core::AllocTracker::enable(options.trackAllocs);
+
+    std::mt19937_64 rng(options.seed);
+    std::vector<Result> results;
+
+    for (const Entry& entry : makeBenchmarks()) {
+        if (!options.filter.empty() && std::string(entry.name).find(options.filter) == std::string::npos) {
+            continue;
+        }
+        for (size_t n = options.minN; n <= options.maxN; n *= 10) {
+            std::fprintf(stderr, "%-22s n=%zu\n", entry.name, n);
+            entry.run(n, options, rng, results);
+        }
+    }
+
+    FILE* out = stdout;
+    if (!options.outPath.empty()) {
+        out = std::fopen(options.outPath.c_str(), "w");
+        if (out == nullptr) {
+            std::fprintf(stderr, "dsbench: cannot open %s\n", options.outPath.c_str());
+            return 1;
+        }
+    }
+    writeJson(out, options, results);
+    if (out != stdout) {
+        std::fclose(out);
+    }
+    return 0;
+}
@@ -0,0 +1,291 @@
+// Rendering scalability benchmark. Fills each visualizer to N elements, renders
+// a fixed number of frames into an offscreen texture at each quality tier and
+// reports frame time, draw calls, vertices, primitive types, texture binds,
+// state changes, text draws and heap allocations per frame.
+//
+//   renderbench [--min-n N] [--max-n N] [--frames F] [--tier NAME|all]
+//               [--only NAME] [--cutoff-ms MS] [--font FILE] [--out FILE]
+//
+// N runs over powers of ten (default 10 .. 10^6). Once a visualizer's mean
+// frame time at some tier passes --cutoff-ms (default 1000) the larger sizes
+// are skipped for that tier, since they are long past interactive.
+//
+// Builds against main.cpp itself so the real draw() code is measured.
+
+#define DSV_NO_MAIN
+#include "../main.cpp"
+
+#include <SFML/OpenGL.hpp>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+
+namespace {
+
+struct Options {
+    size_t minN = 10;
+    size_t maxN = 1000000;
+    int frames = 60;
+    int warmupFrames = 5;
+    double cutoffMs = 1000.0;
+    std::string tier = "all";
+    std::string only;
+    std::string fontPath = "arial.ttf";
+    std::string outPath;
+};
+
+struct Row {
+    const char* visualizer;
+    QualityTier tier;
+    size_t n;
+    int frames;
+    double meanMs;
+    double p99Ms;
+    double drawCalls;
+    double vertices;
+    double textDraws;
+    double textureBinds;
+    double stateChanges;
+    double primitives[RenderStats::PRIMITIVE_TYPES];
+    double allocations;
+    double allocationBytes;
+};
+
+// One visualizer under test: knows its window size and how to fill and draw it
+struct Scenario {
+    const char* name;
+    sf::Vector2u size;
+    std::function<void(size_t n, std::mt19937& rng)> load;
+    std::function<void(RenderContext& context, QualityTier tier)> draw;
+};
+
+std::vector<int> randomValues(size_t n, std::mt19937& rng) {
+    std::vector<int> values(n);
+    for (int& value : values) {
+        value = static_cast<int>(rng() % 1000);
+    }
+    return values;
+}
+
+double percentile(std::vector<double> values, double p) {
+    if (values.empty()) {
+        return 0.0;
+    }
+    std::sort(values.begin(), values.end());
+    double rank = p / 100.0 * (values.size() - 1);
+    size_t low = static_cast<size_t>(rank);
+    size_t high = std::min(low + 1, values.size() - 1);
+    return values[low] + (values[high] - values[low]) * (rank - low);
+}
+
+Row runFrames(const Scenario& scenario, sf::RenderTexture& texture, QualityTier tier,
+              size_t n, const Options& options) {
+    RenderContext context(texture);
+    std::vector<double> frameMs;
+    RenderStats totals;
+    double allocations = 0, bytes = 0;
+
+    for (int frame = 0; frame < options.warmupFrames + options.frames; ++frame) {
+        core::AllocCounts allocsBefore = core::AllocTracker::snapshot();
+        context.resetStats();
+
+        sf::Clock clock;
+        texture.clear(sf::Color(30, 30, 30));
+        scenario.draw(context, tier);
+        texture.display();
+        glFinish();  // Include GPU time, not just command submission
+        double ms = clock.getElapsedTime().asMicroseconds() / 1000.0;
+
+        if (frame < options.warmupFrames) {
+            continue;
+        }
+        frameMs.push_back(ms);
+        const RenderStats& stats = context.getStats();
+        totals.drawCalls += stats.drawCalls;
+        totals.vertices += stats.vertices;
+        totals.textDraws += stats.textDraws;
+        totals.textureBinds += stats.textureBinds;
+        totals.stateChanges += stats.stateChanges;
+        for (int type = 0; type < RenderStats::PRIMITIVE_TYPES; ++type) {
+            totals.primitives[type] += stats.primitives[type];
+        }
+        core::AllocCounts allocs = core::AllocTracker::snapshot() - allocsBefore;
+        allocations += allocs.allocations;
+        bytes += allocs.bytes;
+
+        // No point grinding through every frame of a hopeless configuration
+        if (ms > options.cutoffMs * 4) {
+            break;
+        }
+    }
+
+    double frames = static_cast<double>(frameMs.size());
+    double total = 0;
+    for (double ms : frameMs) total += ms;
+    Row row{scenario.name, tier, n, static_cast<int>(frameMs.size()),
+            total / frames, percentile(frameMs, 99),
+            totals.drawCalls / frames, totals.vertices / frames, totals.textDraws / frames,
+            totals.textureBinds / frames, totals.stateChanges / frames, {},
+            allocations / frames, bytes / frames};
+    for (int type = 0; type < RenderStats::PRIMITIVE_TYPES; ++type) {
+        row.primitives[type] = totals.primitives[type] / frames;
+    }
+    return row;
+}
+
+void writeJson(FILE* out, const Options& options, const std::vector<Row>& rows) {
+    std::fprintf(out, "{\n  \"frames\": %d,\n  \"warmup_frames\": %d,\n  \"results\": [\n",
+                 options.frames, options.warmupFrames);
+    for (size_t i = 0; i < rows.size(); ++i) {
+        const Row& r = rows[i];
+        std::fprintf(out,
+            "    {\"visualizer\": \"%s\", \"tier\": \"%s\", \"n\": %zu, \"frames\": %d, "
+            "\"mean_ms\": %.3f, \"p99_ms\": %.3f, \"draw_calls\": %.1f, \"vertices\": %.1f, "
+            "\"text_draws\": %.1f, \"texture_binds\": %.1f, \"state_changes\": %.1f, \"primitives\": {",
+            r.visualizer, QualityGovernor::tierName(r.tier), r.n, r.frames,
+            r.meanMs, r.p99Ms, r.drawCalls, r.vertices, r.textDraws, r.textureBinds, r.stateChanges);
+        for (int type = 0; type < RenderStats::PRIMITIVE_TYPES; ++type) {
+            std::fprintf(out, "%s\"%s\": %.1f", type > 0 ? ", " : "",
+                         RenderStats::primitiveName(type), r.primitives[type]);
+        }
+        std::fprintf(out, "}, \"allocations\": %.1f, \"alloc_bytes\": %.1f}%s\n",
+                     r.allocations, r.allocationBytes, i + 1 < rows.size() ? "," : "");
+    }
+    std::fprintf(out, "  ]\n}\n");
+}
+
+bool parseOptions(int argc, char** argv, Options& options) {
+    for (int i = 1; i < argc; ++i) {
+        const char* arg = argv[i];
+        if (i + 1 >= argc) {
+            return false;
+        }
+        const char* value = argv[++i];
+        if (std::strcmp(arg, "--min-n") == 0) {
+            options.minN = std::strtoull(value, nullptr, 10);
+        } else if (std::strcmp(arg, "--max-n") == 0) {
+            options.maxN = std::strtoull(value, nullptr, 10);
+        } else if (std::strcmp(arg, "--frames") == 0) {
+            options.frames = std::atoi(value);
+        } else if (std::strcmp(arg, "--tier") == 0) {
+            options.tier = value;
+        } else if (std::strcmp(arg, "--only") == 0) {
+            options.only = value;
+        } else if (std::strcmp(arg, "--cutoff-ms") == 0) {
+            options.cutoffMs = std::atof(value);
+        } else if (std::strcmp(arg, "--font") == 0) {
+            options.fontPath = value;
+        } else if (std::strcmp(arg, "--out") == 0) {
+            options.outPath = value;
+        } else {
+            return false;
+        }
+    }
+    return options.minN >= 1 && options.minN <= options.maxN && options.frames >= 1;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Options options;
+    if (!parseOptions(argc, argv, options)) {
+        std::fprintf(stderr,
+            "usage: renderbench [--min-n N] [--max-n N] [--frames F] [--tier NAME|all]\n"
+            "                   [--only NAME] [--cutoff-ms MS] [--font FILE] [--out FILE]\n");
+        return 1;
+    }
+
+    core::AllocTracker::enable(true);
+
+    sf::Font font;
+    if (!font.loadFromFile(options.fontPath)) {
+        return EXIT_FAILURE;
+    }
+
+    // Same construction parameters as the run*visualizer functions
+    ArrayVisualizer arrayVis(font, {50.f, 500.f}, 60.f, 60.f);
+    StringVisualizer stringVis(font, {730.f, 500}, 40.f, 40.f);
+    Linkedlistvisualizer linkedlistVis(font, {50.f, 500.f}, 60.f, 60.f);
+    StackVisualizer stackVis(font, {50.f, 500.f}, 60.f, 60.f);
+    QueueVisualizer queueVis(font, {50.f, 500.f}, 60.f, 60.f);
+    BinaryTreeVisualizer binarytreeVis(font, {1100.f, 150.f}, 25.f);
+
+    std::vector<Scenario> scenarios = {
+        {"array", {1200, 672},
+            [&](size_t n, std::mt19937& rng) { arrayVis.load(randomValues(n, rng)); },
+            [&](RenderContext& c, QualityTier t) { arrayVis.quality = t; arrayVis.draw(c); }},
+        {"string", {1200, 672},
+            [&](size_t n, std::mt19937& rng) {
+                std::string text(n, 'a');
+                for (char& ch : text) ch = static_cast<char>('a' + rng() % 26);
+                stringVis.load(text);
+            },
+            [&](RenderContext& c, QualityTier t) { stringVis.quality = t; stringVis.draw(c); }},
+        {"linked-list", {1200, 672},
+            [&](size_t n, std::mt19937& rng) { linkedlistVis.load(randomValues(n, rng)); },
+            [&](RenderContext& c, QualityTier t) { linkedlistVis.quality = t; linkedlistVis.draw(c); }},
+        {"stack", {1200, 672},
+            [&](size_t n, std::mt19937& rng) { stackVis.load(randomValues(n, rng)); },
+            [&](RenderContext& c, QualityTier t) { stackVis.quality = t; stackVis.draw(c); }},
+        {"queue", {1200, 672},
+            [&](size_t n, std::mt19937& rng) { queueVis.load(randomValues(n, rng)); },
+            [&](RenderContext& c, QualityTier t) { queueVis.quality = t; queueVis.draw(c); }},
+        {"binary-tree", {1800, 800},
+            [&](size_t n, std::mt19937& rng) { binarytreeVis.load(randomValues(n, rng)); },
+            [&](RenderContext& c, QualityTier t) { binarytreeVis.quality = t; binarytreeVis.draw(c); }},
+    };
+
+    std::vector<QualityTier> tiers;
+    for (int t = 0; t <= static_cast<int>(QualityTier::Aggregate); ++t) {
+        QualityTier tier = static_cast<QualityTier>(t);
+        if (options.tier == "all" || options.tier == QualityGovernor::tierName(tier)) {
+            tiers.push_back(tier);
+        }
+    }
+    if (tiers.empty()) {
+        std::fprintf(stderr, "renderbench: unknown tier '%s'\n", options.tier.c_str());
+        return 1;
+    }
+
+    std::mt19937 rng(42);
+    std::vector<Row> rows;
+
+    for (const Scenario& scenario : scenarios) {
+        if (!options.only.empty() && options.only != scenario.name) {
+            continue;
+        }
+        sf::RenderTexture texture;
+        if (!texture.create(scenario.size.x, scenario.size.y)) {
+            std::fprintf(stderr, "renderbench: cannot create offscreen target\n");
+            return 1;
+        }
+
+        std::vector<bool> tierCutOff(tiers.size(), false);
+        for (size_t n = options.minN; n <= options.maxN; n *= 10) {
+            scenario.load(n, rng);
+            for (size_t t = 0; t < tiers.size(); ++t) {
+                if (tierCutOff[t]) {
+                    continue;
+                }
+                std::fprintf(stderr, "%-12s %-16s n=%zu\n", scenario.name,
+                             QualityGovernor::tierName(tiers[t]), n);
+                rows.push_back(runFrames(scenario, texture, tiers[t], n, options));
+                tierCutOff[t] = rows.back().meanMs > options.cutoffMs;
+            }
+        }
+    }
+
+    FILE* out = stdout;
+    if (!options.outPath.empty()) {
+        out = std::fopen(options.outPath.c_str(), "w");
+        if (out == nullptr) {
+            std::fprintf(stderr, "renderbench: cannot open %s\n", options.outPath.c_str());
+            return 1;
+        }
+    }
+    writeJson(out, options, rows);
+    if (out != stdout) {
+        std::fclose(out);
+    }
+    return 0;
+}
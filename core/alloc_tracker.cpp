@@ -0,0 +1,107 @@
+#include "alloc_tracker.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+#ifdef _WIN32
+#include <malloc.h>
+#endif
+
+namespace {
+
+std::atomic<bool> tracking{false};
+thread_local core::AllocCounts counts;  // Trivial type, so no allocation on first use
+
+void* trackedAlloc(std::size_t size) {
+    if (tracking.load(std::memory_order_relaxed)) {
+        counts.allocations++;
+        counts.bytes += size;
+    }
+    if (void* p = std::malloc(size ? size : 1)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void trackedFree(void* p) {
+    if (p && tracking.load(std::memory_order_relaxed)) {
+        counts.frees++;
+    }
+    std::free(p);
+}
+
+// Over-aligned types (alignas above the default) come through these. The
+// Windows CRT has no aligned_alloc, and its aligned blocks need their own free.
+void* trackedAlignedAlloc(std::size_t size, std::align_val_t align) {
+    if (tracking.load(std::memory_order_relaxed)) {
+        counts.allocations++;
+        counts.bytes += size;
+    }
+    std::size_t alignment = static_cast<std::size_t>(align);
+    // aligned_alloc wants a whole number of alignments
+    std::size_t rounded = (std::max<std::size_t>(size, 1) + alignment - 1) / alignment * alignment;
+#ifdef _WIN32
+    void* p = _aligned_malloc(rounded, alignment);
+#else
+    void* p = std::aligned_alloc(alignment, rounded);
+#endif
+    if (p) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void trackedAlignedFree(void* p) {
+    if (p && tracking.load(std::memory_order_relaxed)) {
+        counts.frees++;
+    }
+#ifdef _WIN32
+    _aligned_free(p);
+#else
+    std::free(p);
+#endif
+}
+
+} // namespace
+
+namespace core {
+
+void AllocTracker::enable(bool on) { tracking.store(on, std::memory_order_relaxed); }
+
+bool AllocTracker::enabled() { return tracking.load(std::memory_order_relaxed); }
+
+AllocCounts AllocTracker::snapshot() { return counts; }
+
+} // namespace core
+
+void* operator new(std::size_t size) { return trackedAlloc(size); }
+void* operator new[](std::size_t size) { return trackedAlloc(size); }
+void operator delete(void* p) noexcept { trackedFree(p); }
+void operator delete[](void* p) noexcept { trackedFree(p); }
+void operator delete(void* p, std::size_t) noexcept { trackedFree(p); }
+void operator delete[](void* p, std::size_t) noexcept { trackedFree(p); }
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+    try { return trackedAlloc(size); } catch (...) { return nullptr; }
+}
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept {
+    try { return trackedAlloc(size); } catch (...) { return nullptr; }
+}
+void operator delete(void* p, const std::nothrow_t&) noexcept { trackedFree(p); }
+void operator delete[](void* p, const std::nothrow_t&) noexcept { trackedFree(p); }
+
+void* operator new(std::size_t size, std::align_val_t align) { return trackedAlignedAlloc(size, align); }
+void* operator new[](std::size_t size, std::align_val_t align) { return trackedAlignedAlloc(size, align); }
+void operator delete(void* p, std::align_val_t) noexcept { trackedAlignedFree(p); }
+void operator delete[](void* p, std::align_val_t) noexcept { trackedAlignedFree(p); }
+void operator delete(void* p, std::size_t, std::align_val_t) noexcept { trackedAlignedFree(p); }
+void operator delete[](void* p, std::size_t, std::align_val_t) noexcept { trackedAlignedFree(p); }
+void* operator new(std::size_t size, std::align_val_t align, const std::nothrow_t&) noexcept {
+    try { return trackedAlignedAlloc(size, align); } catch (...) { return nullptr; }
+}
+void* operator new[](std::size_t size, std::align_val_t align, const std::nothrow_t&) noexcept {
+    try { return trackedAlignedAlloc(size, align); } catch (...) { return nullptr; }
+}
+void operator delete(void* p, std::align_val_t, const std::nothrow_t&) noexcept { trackedAlignedFree(p); }
+void operator delete[](void* p, std::align_val_t, const std::nothrow_t&) noexcept { trackedAlignedFree(p); }
@@ -0,0 +1,43 @@
+#pragma once
+
+// Opt-in heap allocation tracking. Linking this file replaces the global
+// operator new/delete, aligned forms included; while tracking is off they
+// only pay one relaxed atomic load. Counts are per thread, so a snapshot
+// taken before and after a block gives exactly what that block allocated on
+// this thread.
+
+#include <cstddef>
+
+namespace core {
+
+struct AllocCounts {
+    size_t allocations = 0;
+    size_t frees = 0;
+    size_t bytes = 0;     // Bytes requested by allocations
+
+    AllocCounts& operator+=(const AllocCounts& other) {
+        allocations += other.allocations;
+        frees += other.frees;
+        bytes += other.bytes;
+        return *this;
+    }
+};
+
+inline AllocCounts operator-(const AllocCounts& a, const AllocCounts& b) {
+    AllocCounts d;
+    d.allocations = a.allocations - b.allocations;
+    d.frees = a.frees - b.frees;
+    d.bytes = a.bytes - b.bytes;
+    return d;
+}
+
+class AllocTracker {
+public:
+    static void enable(bool on);
+    static bool enabled();
+
+    // Running totals for the calling thread since tracking was first enabled
+    static AllocCounts snapshot();
+};
+
+} // namespace core
@@ -0,0 +1,427 @@
+#include "batch.h"
+#include "snapshot.h"
+#include "structures.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <climits>
+#include <cstdio>
+#include <cstdlib>
+#include <istream>
+#include <limits>
+#include <ostream>
+
+namespace core {
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+enum class Args { None, Int, IntInt, IntText, Char, IntChar };
+
+struct OpSpec {
+    const char* name;
+    Args args;
+};
+
+// One parsed line. Arguments are parsed before the clock starts so only the
+// operation itself is timed.
+struct Command {
+    size_t op = 0;
+    long long a = 0;
+    long long b = 0;
+    std::string text;
+};
+
+// `found` value when an operation has nothing to report
+const long long NO_RESULT = std::numeric_limits<long long>::min();
+
+// Negative indices become huge and are rejected by the structure like any
+// other out-of-range index
+size_t toIndex(long long value) {
+    return value < 0 ? std::numeric_limits<size_t>::max() : static_cast<size_t>(value);
+}
+
+// Each adapter lists its operations and runs them on one core structure.
+// execute() returns false when the structure rejects the operation; `found`
+// is set for lookups (index or value, -1 for a miss).
+
+struct ArrayAdapter {
+    static std::vector<OpSpec> ops() {
+        return {{"insert", Args::IntInt}, {"remove", Args::Int}, {"update", Args::IntInt}, {"search", Args::Int}};
+    }
+    Array data;
+
+    bool execute(const Command& c, long long& found) {
+        switch (c.op) {
+            case 0: return data.insert(toIndex(c.a), static_cast<int>(c.b));
+            case 1: return data.remove(toIndex(c.a));
+            case 2: return data.update(toIndex(c.a), static_cast<int>(c.b));
+            default: {
+                size_t index = data.find(static_cast<int>(c.a));
+                found = index == npos ? -1 : static_cast<long long>(index);
+                return true;
+            }
+        }
+    }
+    size_t size() const { return data.size(); }
+    void print(std::ostream& out, size_t i) const { out << data[i]; }
+    void finish(BatchResult& result) const { result.values = data.values(); }
+    bool start(const SnapshotReader& s) {
+        data = Array(std::vector<int>(s.values(), s.values() + s.count()));
+        return true;
+    }
+};
+
+struct StringAdapter {
+    static std::vector<OpSpec> ops() {
+        return {{"insert", Args::IntText}, {"remove", Args::Int}, {"update", Args::IntChar}, {"search", Args::Char}};
+    }
+    String data;
+
+    bool execute(const Command& c, long long& found) {
+        switch (c.op) {
+            case 0: return data.insert(toIndex(c.a), c.text);
+            case 1: return data.remove(toIndex(c.a));
+            case 2: return data.update(toIndex(c.a), c.text[0]);
+            default: {
+                size_t index = data.find(c.text[0]);
+                found = index == npos ? -1 : static_cast<long long>(index);
+                return true;
+            }
+        }
+    }
+    size_t size() const { return data.size(); }
+    void print(std::ostream& out, size_t i) const { out << data[i]; }
+    void finish(BatchResult& result) const { result.text = data.str(); }
+    bool start(const SnapshotReader& s) {
+        data = String(std::string(s.text(), s.count()));
+        return true;
+    }
+};
+
+struct LinkedListAdapter {
+    static std::vector<OpSpec> ops() {
+        return {{"insert_head", Args::Int}, {"insert_tail", Args::Int}, {"insert", Args::IntInt},
+                {"delete", Args::Int}, {"update", Args::IntInt}, {"search", Args::Int}};
+    }
+    LinkedList data;
+
+    // Script positions are 1-based like the visualizer's; 0 and below map out
+    // of range, checked before subtracting so the smallest value cannot wrap
+    static size_t position(long long value) { return value < 1 ? toIndex(-1) : toIndex(value - 1); }
+
+    bool execute(const Command& c, long long& found) {
+        switch (c.op) {
+            case 0: data.pushFront(static_cast<int>(c.a)); return true;
+            case 1: data.pushBack(static_cast<int>(c.a)); return true;
+            case 2: return data.insert(position(c.a), static_cast<int>(c.b));
+            case 3: return data.remove(position(c.a));
+            case 4: return data.update(position(c.a), static_cast<int>(c.b));
+            default: {
+                size_t index = data.find(static_cast<int>(c.a));
+                found = index == npos ? -1 : static_cast<long long>(index + 1);
+                return true;
+            }
+        }
+    }
+    size_t size() const { return data.size(); }
+    void print(std::ostream& out, size_t i) const { out << data.nodeAt(i)->data; }
+    void finish(BatchResult& result) const { result.values = data.values(); }
+    bool start(const SnapshotReader& s) {
+        for (size_t i = 0; i < s.count(); ++i) data.pushBack(s.values()[i]);
+        return true;
+    }
+};
+
+struct StackAdapter {
+    static std::vector<OpSpec> ops() {
+        return {{"push", Args::Int}, {"pop", Args::None}, {"peek", Args::None}};
+    }
+    Stack data;
+
+    bool execute(const Command& c, long long& found) {
+        switch (c.op) {
+            case 0: data.push(static_cast<int>(c.a)); return true;
+            case 1: return data.pop();
+            default:
+                if (data.empty()) return false;
+                found = data.top();
+                return true;
+        }
+    }
+    size_t size() const { return data.size(); }
+    void print(std::ostream& out, size_t i) const { out << data[i]; }
+    void finish(BatchResult& result) const {
+        result.values.clear();
+        for (size_t i = 0; i < data.size(); ++i) result.values.push_back(data[i]);
+    }
+    bool start(const SnapshotReader& s) {
+        data = Stack(std::vector<int>(s.values(), s.values() + s.count()));
+        return true;
+    }
+};
+
+struct QueueAdapter {
+    static std::vector<OpSpec> ops() {
+        return {{"enqueue", Args::Int}, {"dequeue", Args::None}, {"front", Args::None}};
+    }
+    Queue data;
+
+    bool execute(const Command& c, long long& found) {
+        switch (c.op) {
+            case 0: data.enqueue(static_cast<int>(c.a)); return true;
+            case 1: return data.dequeue();
+            default:
+                if (data.empty()) return false;
+                found = data.front();
+                return true;
+        }
+    }
+    size_t size() const { return data.size(); }
+    void print(std::ostream& out, size_t i) const { out << data[i]; }
+    void finish(BatchResult& result) const {
+        result.values.clear();
+        for (size_t i = 0; i < data.size(); ++i) result.values.push_back(data[i]);
+    }
+    bool start(const SnapshotReader& s) {
+        data = Queue(std::vector<int>(s.values(), s.values() + s.count()));
+        return true;
+    }
+};
+
+struct BinaryTreeAdapter {
+    static std::vector<OpSpec> ops() {
+        return {{"insert", Args::Int}, {"remove", Args::Int}, {"search", Args::Int},
+                {"inorder", Args::None}, {"preorder", Args::None}, {"postorder", Args::None}};
+    }
+    BinarySearchTree data;
+    std::vector<int> inorderCache;  // For printing the final state
+
+    bool execute(const Command& c, long long& found) {
+        switch (c.op) {
+            case 0: data.insert(static_cast<int>(c.a)); return true;
+            case 1: return data.remove(static_cast<int>(c.a));
+            case 2: found = data.contains(static_cast<int>(c.a)) ? c.a : -1; return true;
+            case 3: found = static_cast<long long>(data.inorder().size()); return true;
+            case 4: found = static_cast<long long>(data.preorder().size()); return true;
+            default: found = static_cast<long long>(data.postorder().size()); return true;
+        }
+    }
+    size_t size() const { return data.size(); }
+    void print(std::ostream& out, size_t i) {
+        if (i == 0) inorderCache = data.inorder();
+        out << inorderCache[i];
+    }
+    void finish(BatchResult& result) const { result.values = data.preorder(); }
+    bool start(const SnapshotReader& s) { return data.assignPreorder(s.values(), s.count()); }
+};
+
+struct OpStats {
+    size_t count = 0;
+    size_t failed = 0;
+    double totalNs = 0;
+    double minNs = std::numeric_limits<double>::max();
+    double maxNs = 0;
+};
+
+// Splits off the next whitespace-separated token starting at `pos`
+bool nextToken(const std::string& line, size_t& pos, std::string& token) {
+    size_t start = line.find_first_not_of(" \t", pos);
+    if (start == std::string::npos) {
+        return false;
+    }
+    size_t end = line.find_first_of(" \t", start);
+    if (end == std::string::npos) {
+        end = line.size();
+    }
+    token.assign(line, start, end - start);
+    pos = end;
+    return true;
+}
+
+bool nextInt(const std::string& line, size_t& pos, std::string& token, long long& value) {
+    if (!nextToken(line, pos, token)) {
+        return false;
+    }
+    // Values and positions are stored as int, so anything past the 32-bit
+    // range is malformed, as it is in an import
+    char* end = nullptr;
+    errno = 0;
+    value = std::strtoll(token.c_str(), &end, 10);
+    return *end == '\0' && errno != ERANGE && value >= INT_MIN && value <= INT_MAX;
+}
+
+// Hand-rolled rather than istringstream: parsing dominates batch wall time
+bool parseLine(const std::string& line, const std::vector<OpSpec>& ops, Command& command,
+               std::string& error) {
+    size_t pos = 0;
+    std::string name, token;
+    nextToken(line, pos, name);
+
+    auto spec = std::find_if(ops.begin(), ops.end(),
+                             [&](const OpSpec& op) { return name == op.name; });
+    if (spec == ops.end()) {
+        error = "unknown operation '" + name + "'";
+        return false;
+    }
+    command.op = static_cast<size_t>(spec - ops.begin());
+    command.text.clear();
+
+    bool ok = true;
+    switch (spec->args) {
+        case Args::None:
+            break;
+        case Args::Int:
+            ok = nextInt(line, pos, token, command.a);
+            break;
+        case Args::IntInt:
+            ok = nextInt(line, pos, token, command.a) && nextInt(line, pos, token, command.b);
+            break;
+        case Args::IntText: {
+            ok = nextInt(line, pos, token, command.a);
+            size_t start = line.find_first_not_of(" \t", pos);
+            ok = ok && start != std::string::npos;
+            if (ok) command.text.assign(line, start, std::string::npos);
+            pos = line.size();
+            break;
+        }
+        case Args::Char:
+            ok = nextToken(line, pos, command.text) && command.text.size() == 1;
+            break;
+        case Args::IntChar:
+            ok = nextInt(line, pos, token, command.a) && nextToken(line, pos, command.text) &&
+                 command.text.size() == 1;
+            break;
+    }
+    if (!ok || nextToken(line, pos, token)) {
+        error = "bad arguments for '" + name + "'";
+        return false;
+    }
+    return true;
+}
+
+template <typename Adapter>
+bool run(std::istream& in, std::ostream& out, std::ostream& err,
+         const BatchOptions& options, BatchResult& result) {
+    Adapter adapter;
+    if (options.initial && !adapter.start(*options.initial)) {
+        err << "snapshot is not a valid " << options.initial->structure() << "\n";
+        return false;
+    }
+    const std::vector<OpSpec> ops = Adapter::ops();
+    std::vector<OpStats> stats(ops.size());
+
+    std::string line;
+    size_t lineNumber = 0;
+    Command command;
+    std::string error;
+    char buffer[160];
+
+    auto runStart = Clock::now();
+    while (std::getline(in, line)) {
+        lineNumber++;
+        size_t start = line.find_first_not_of(" \t\r");
+        if (start == std::string::npos || line[start] == '#') {
+            continue;
+        }
+        if (line.back() == '\r') {
+            line.pop_back();
+        }
+        if (!parseLine(line.substr(start), ops, command, error)) {
+            err << "line " << lineNumber << ": " << error << "\n";
+            return false;
+        }
+
+        long long found = NO_RESULT;
+        auto opStart = Clock::now();
+        bool accepted = adapter.execute(command, found);
+        auto opEnd = Clock::now();
+        double ns = std::chrono::duration<double, std::nano>(opEnd - opStart).count();
+
+        OpStats& s = stats[command.op];
+        s.count++;
+        s.failed += accepted ? 0 : 1;
+        s.totalNs += ns;
+        s.minNs = std::min(s.minNs, ns);
+        s.maxNs = std::max(s.maxNs, ns);
+
+        if (options.verbose) {
+            std::snprintf(buffer, sizeof(buffer), "%6zu  %-12s %-8s %10.0f ns", lineNumber,
+                          ops[command.op].name, accepted ? "ok" : "rejected", ns);
+            out << buffer;
+            if (found != NO_RESULT) out << "  -> " << found;
+            out << "\n";
+        }
+    }
+    double wallMs = std::chrono::duration<double, std::milli>(Clock::now() - runStart).count();
+
+    size_t total = 0;
+    out << "operation        count   failed    total_ms     mean_ns      min_ns      max_ns\n";
+    for (size_t i = 0; i < ops.size(); ++i) {
+        const OpStats& s = stats[i];
+        if (s.count == 0) continue;
+        total += s.count;
+        std::snprintf(buffer, sizeof(buffer), "%-12s %9zu %8zu %11.3f %11.1f %11.1f %11.1f\n",
+                      ops[i].name, s.count, s.failed, s.totalNs / 1e6, s.totalNs / s.count,
+                      s.minNs, s.maxNs);
+        out << buffer;
+    }
+    std::snprintf(buffer, sizeof(buffer), "%zu operations in %.3f ms (wall, including parsing)\n",
+                  total, wallMs);
+    out << buffer;
+
+    out << "final size " << adapter.size() << ": [";
+    size_t shown = std::min(adapter.size(), options.showLimit);
+    for (size_t i = 0; i < shown; ++i) {
+        if (i > 0) out << ", ";
+        adapter.print(out, i);
+    }
+    if (shown < adapter.size()) out << ", ...";
+    out << "]\n";
+
+    adapter.finish(result);
+    return true;
+}
+
+} // namespace
+
+bool isBatchStructure(const std::string& structure) {
+    return structure == "array" || structure == "string" || structure == "linked-list" ||
+           structure == "stack" || structure == "queue" || structure == "binary-tree";
+}
+
+bool runBatch(const std::string& structure, std::istream& in, std::ostream& out,
+              std::ostream& err, const BatchOptions& options, BatchResult& result) {
+    if (options.initial && options.initial->structure() != structure) {
+        err << "snapshot holds " << options.initial->structure() << " data, not " << structure << "\n";
+        return false;
+    }
+    if (structure == "array") return run<ArrayAdapter>(in, out, err, options, result);
+    if (structure == "string") return run<StringAdapter>(in, out, err, options, result);
+    if (structure == "linked-list") return run<LinkedListAdapter>(in, out, err, options, result);
+    if (structure == "stack") return run<StackAdapter>(in, out, err, options, result);
+    if (structure == "queue") return run<QueueAdapter>(in, out, err, options, result);
+    if (structure == "binary-tree") return run<BinaryTreeAdapter>(in, out, err, options, result);
+    err << "unknown structure '" << structure << "'\n";
+    return false;
+}
+
+bool writeFillScript(const std::string& structure, const std::vector<int>& values, std::ostream& out) {
+    if (!isBatchStructure(structure)) {
+        return false;
+    }
+    for (size_t i = 0; i < values.size(); ++i) {
+        int v = values[i];
+        if (structure == "array") out << "insert " << i << ' ' << v << '\n';
+        else if (structure == "string") out << "insert " << i << ' ' << static_cast<char>('a' + ((v % 26) + 26) % 26) << '\n';
+        else if (structure == "linked-list") out << "insert_tail " << v << '\n';
+        else if (structure == "stack") out << "push " << v << '\n';
+        else if (structure == "queue") out << "enqueue " << v << '\n';
+        else out << "insert " << v << '\n';
+    }
+    return static_cast<bool>(out);
+}
+
+} // namespace core
@@ -0,0 +1,54 @@
+#pragma once
+
+// Batch mode: runs a script of operations against one core structure at full
+// speed and reports per-operation timings. One operation per line, blank lines
+// and lines starting with '#' are skipped. Each timing includes one clock read,
+// so sub-50ns operations are dominated by timer overhead.
+//
+//   array        insert <index> <value> | remove <index> | update <index> <value> | search <value>
+//   string       insert <index> <text>  | remove <index> | update <index> <char>  | search <char>
+//   linked-list  insert_head <value> | insert_tail <value> | insert <position> <value>
+//                | delete <position> | update <position> <value> | search <value>
+//                (positions are 1-based, as in the visualizer)
+//   stack        push <value> | pop | peek
+//   queue        enqueue <value> | dequeue | front
+//   binary-tree  insert <value> | remove <value> | search <value>
+//                | inorder | preorder | postorder
+
+#include <cstddef>
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+namespace core {
+
+class SnapshotReader;
+
+struct BatchOptions {
+    bool verbose = false;      // Print every operation's result and time
+    size_t showLimit = 50;     // Elements printed for the final state
+    const SnapshotReader* initial = nullptr;  // Starting contents instead of empty
+};
+
+// Final contents, so a caller can render the end state. Integer structures
+// fill `values` (a BST in preorder, which rebuilds the same shape); the
+// string fills `text`.
+struct BatchResult {
+    std::vector<int> values;
+    std::string text;
+};
+
+bool isBatchStructure(const std::string& structure);
+
+// Returns false on an unknown structure, a malformed line (reported on `err`
+// with its line number) or an initial snapshot of another structure. Operations the structure rejects, like a bad
+// index or popping an empty stack, are counted as failed but do not stop the run.
+bool runBatch(const std::string& structure, std::istream& in, std::ostream& out,
+              std::ostream& err, const BatchOptions& options, BatchResult& result);
+
+// Writes the script that fills an empty `structure` with `values` in order:
+// appends, tail inserts, pushes, enqueues or BST inserts. String values become
+// the letter 'a' + value % 26. Returns false on an unknown structure.
+bool writeFillScript(const std::string& structure, const std::vector<int>& values, std::ostream& out);
+
+} // namespace core
@@ -0,0 +1,330 @@
+#include "complexity.h"
+
+#include "structures.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+namespace core {
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+const double TARGET_SAMPLE_NS = 100000.0;  // Per timed batch
+const int SAMPLES = 7;
+const size_t READ_BATCH = 1 << 14;
+
+// Keeps timed reads from being optimized away
+volatile size_t sink = 0;
+
+// Cost of the two clock reads around a batch, which would otherwise swamp the
+// small batches growth operations get at small n
+double clockOverheadNs() {
+    static const double overhead = [] {
+        double best = 1e9;
+        for (int i = 0; i < 1000; ++i) {
+            auto start = Clock::now();
+            auto end = Clock::now();
+            best = std::min(best, std::chrono::duration<double, std::nano>(end - start).count());
+        }
+        return best;
+    }();
+    return overhead;
+}
+
+// Median ns of op(i) over SAMPLES batches, with undo(batch) run untimed after
+// each batch to bring the structure back to its size. Same scheme as dsbench.
+template <typename Op, typename Undo>
+double timeOperation(size_t maxBatch, Op op, Undo undo) {
+    auto runBatch = [&](size_t batch) {
+        auto start = Clock::now();
+        for (size_t i = 0; i < batch; ++i) {
+            op(i);
+        }
+        auto end = Clock::now();
+        undo(batch);
+        double elapsed = std::chrono::duration<double, std::nano>(end - start).count() - clockOverheadNs();
+        return std::max(elapsed, 0.1);
+    };
+
+    size_t batch = 1;
+    for (int i = 0; i < 3; ++i) {
+        double perOp = std::max(runBatch(batch) / batch, 1.0);
+        batch = std::max<size_t>(1, std::min(static_cast<size_t>(TARGET_SAMPLE_NS / perOp), maxBatch));
+    }
+
+    std::vector<double> perOp;
+    for (int i = 0; i < SAMPLES; ++i) {
+        perOp.push_back(runBatch(batch) / batch);
+    }
+    std::nth_element(perOp.begin(), perOp.begin() + SAMPLES / 2, perOp.end());
+    return perOp[SAMPLES / 2];
+}
+
+// Size-changing operations drift the size by at most 1/8th per batch
+size_t growthBatch(size_t n) { return std::max<size_t>(1, n / 8); }
+
+std::vector<int> randomValues(size_t n, std::mt19937_64& rng) {
+    std::vector<int> values(n);
+    for (int& value : values) {
+        value = static_cast<int>(rng() % (4 * n + 1));
+    }
+    return values;
+}
+
+void fillList(LinkedList& list, size_t n) {
+    for (size_t i = 0; i < n; ++i) {
+        list.pushBack(static_cast<int>(i));
+    }
+}
+
+std::vector<SweepOperation> makeOperations() {
+    std::vector<SweepOperation> operations;
+
+    operations.push_back({"Array insert at front", 1 << 20, Complexity::Linear,
+                          [](size_t n, std::mt19937_64& rng) {
+        Array array(randomValues(n, rng));
+        return timeOperation(growthBatch(n),
+            [&](size_t i) { array.insert(0, static_cast<int>(i)); },
+            [&](size_t batch) { for (size_t i = 0; i < batch; ++i) array.remove(0); });
+    }});
+
+    operations.push_back({"Array update", 1 << 20, Complexity::Constant,
+                          [](size_t n, std::mt19937_64& rng) {
+        Array array(randomValues(n, rng));
+        return timeOperation(READ_BATCH,
+            [&](size_t i) { array.update(static_cast<size_t>(rng() % n), static_cast<int>(i)); },
+            [](size_t) {});
+    }});
+
+    operations.push_back({"Array search (miss)", 1 << 20, Complexity::Linear,
+                          [](size_t n, std::mt19937_64& rng) {
+        Array array(randomValues(n, rng));
+        return timeOperation(READ_BATCH,
+            [&](size_t) { sink = sink + array.find(-1); },
+            [](size_t) {});
+    }});
+
+    // Total time of a whole fill, so each sample is n front inserts
+    operations.push_back({"Array fill by front inserts", 1 << 14, Complexity::Quadratic,
+                          [](size_t n, std::mt19937_64&) {
+        return timeOperation(1,
+            [&](size_t) {
+                Array array;
+                for (size_t i = 0; i < n; ++i) array.insert(0, static_cast<int>(i));
+                sink = sink + array.size();
+            },
+            [](size_t) {});
+    }});
+
+    operations.push_back({"Stack push", 1 << 20, Complexity::Constant,
+                          [](size_t n, std::mt19937_64& rng) {
+        Stack stack(randomValues(n, rng));
+        return timeOperation(growthBatch(n),
+            [&](size_t i) { stack.push(static_cast<int>(i)); },
+            [&](size_t batch) { for (size_t i = 0; i < batch; ++i) stack.pop(); });
+    }});
+
+    operations.push_back({"Queue enqueue", 1 << 20, Complexity::Constant,
+                          [](size_t n, std::mt19937_64& rng) {
+        Queue queue(randomValues(n, rng));
+        return timeOperation(growthBatch(n),
+            [&](size_t i) { queue.enqueue(static_cast<int>(i)); },
+            [&](size_t batch) { for (size_t i = 0; i < batch; ++i) queue.dequeue(); });
+    }});
+
+    operations.push_back({"Linked list insertAtHead", 1 << 20, Complexity::Constant,
+                          [](size_t n, std::mt19937_64&) {
+        LinkedList list;
+        fillList(list, n);
+        return timeOperation(growthBatch(n),
+            [&](size_t i) { list.pushFront(static_cast<int>(i)); },
+            [&](size_t batch) { for (size_t i = 0; i < batch; ++i) list.remove(0); });
+    }});
+
+    // The list keeps a tail pointer, so this stays flat
+    operations.push_back({"Linked list insertAtTail", 1 << 20, Complexity::Constant,
+                          [](size_t n, std::mt19937_64&) {
+        LinkedList list;
+        fillList(list, n);
+        return timeOperation(growthBatch(n),
+            [&](size_t i) { list.pushBack(static_cast<int>(i)); },
+            [&](size_t batch) { for (size_t i = 0; i < batch; ++i) list.remove(0); });
+    }});
+
+    operations.push_back({"Linked list insert at middle", 1 << 17, Complexity::Linear,
+                          [](size_t n, std::mt19937_64&) {
+        LinkedList list;
+        fillList(list, n);
+        return timeOperation(growthBatch(n),
+            [&](size_t i) { list.insert(list.size() / 2, static_cast<int>(i)); },
+            [&](size_t batch) { for (size_t i = 0; i < batch; ++i) list.remove(0); });
+    }});
+
+    operations.push_back({"Linked list search (miss)", 1 << 18, Complexity::Linear,
+                          [](size_t n, std::mt19937_64&) {
+        LinkedList list;
+        fillList(list, n);
+        return timeOperation(READ_BATCH,
+            [&](size_t) { sink = sink + list.find(-1); },
+            [](size_t) {});
+    }});
+
+    operations.push_back({"BST search (random inserts)", 1 << 19, Complexity::Logarithmic,
+                          [](size_t n, std::mt19937_64& rng) {
+        BinarySearchTree tree;
+        std::vector<int> keys = randomValues(n, rng);
+        for (int key : keys) tree.insert(key);
+        return timeOperation(READ_BATCH,
+            [&](size_t) { sink = sink + tree.contains(keys[rng() % n]); },
+            [](size_t) {});
+    }});
+
+    // Sorted inserts degenerate the tree into a list, so searches walk O(n).
+    // 0, 1, .. is also that chain's preorder, which builds it in O(n) rather
+    // than O(n^2), so the sweep reaches sizes well past the first cache level.
+    operations.push_back({"BST search (sorted inserts)", 1 << 17, Complexity::Linear,
+                          [](size_t n, std::mt19937_64& rng) {
+        BinarySearchTree tree;
+        std::vector<int> keys(n);
+        for (size_t i = 0; i < n; ++i) keys[i] = static_cast<int>(i);
+        tree.assignPreorder(keys.data(), n);
+        return timeOperation(READ_BATCH,
+            [&](size_t) { sink = sink + tree.contains(static_cast<int>(rng() % n)); },
+            [](size_t) {});
+    }});
+
+    return operations;
+}
+
+} // namespace
+
+double ComplexityFit::predict(double n) const {
+    return scale * complexityTerm(model, n);
+}
+
+const char* complexityName(Complexity model) {
+    switch (model) {
+        case Complexity::Constant:     return "O(1)";
+        case Complexity::Logarithmic:  return "O(log n)";
+        case Complexity::Linear:       return "O(n)";
+        case Complexity::Linearithmic: return "O(n log n)";
+        case Complexity::Quadratic:    return "O(n^2)";
+    }
+    return "";
+}
+
+double complexityTerm(Complexity model, double n) {
+    switch (model) {
+        case Complexity::Constant:     return 1.0;
+        case Complexity::Logarithmic:  return std::log2(std::max(n, 2.0));
+        case Complexity::Linear:       return n;
+        case Complexity::Linearithmic: return n * std::log2(std::max(n, 2.0));
+        case Complexity::Quadratic:    return n * n;
+    }
+    return 1.0;
+}
+
+ComplexityFit fitComplexityModel(Complexity model, const std::vector<ComplexitySample>& samples) {
+    ComplexityFit fit;
+    fit.model = model;
+    if (samples.empty()) {
+        return fit;
+    }
+
+    // log t = log c + log f(n): log c is the mean residual
+    std::vector<double> residuals;
+    double logScale = 0;
+    for (const ComplexitySample& sample : samples) {
+        double t = std::max(sample.nsPerOp, 1e-3);
+        residuals.push_back(std::log(t) - std::log(complexityTerm(model, static_cast<double>(sample.n))));
+        logScale += residuals.back();
+    }
+    logScale /= residuals.size();
+    fit.scale = std::exp(logScale);
+
+    double sumSquares = 0;
+    for (double residual : residuals) {
+        sumSquares += (residual - logScale) * (residual - logScale);
+    }
+    fit.error = std::sqrt(sumSquares / residuals.size());
+    return fit;
+}
+
+double complexitySlope(const std::vector<ComplexitySample>& samples) {
+    std::vector<ComplexitySample> sorted = samples;
+    std::sort(sorted.begin(), sorted.end(),
+              [](const ComplexitySample& a, const ComplexitySample& b) { return a.n < b.n; });
+    std::vector<double> slopes;
+    for (size_t i = 1; i < sorted.size(); ++i) {
+        double dn = std::log(static_cast<double>(sorted[i].n) / static_cast<double>(sorted[i - 1].n));
+        if (dn <= 0) continue;
+        double dt = std::log(std::max(sorted[i].nsPerOp, 1e-3) / std::max(sorted[i - 1].nsPerOp, 1e-3));
+        slopes.push_back(dt / dn);
+    }
+    if (slopes.empty()) {
+        return 0.0;
+    }
+    size_t half = slopes.size() / 2;
+    std::nth_element(slopes.begin(), slopes.begin() + half, slopes.end());
+    double median = slopes[half];
+    if (slopes.size() % 2 == 0) {
+        median = (median + *std::max_element(slopes.begin(), slopes.begin() + half)) / 2;
+    }
+    return median;
+}
+
+Complexity complexityForSlope(double slope) {
+    // Each limit sits well clear of the slopes its neighbours show here: a
+    // log factor adds about 0.1, random accesses outgrowing the caches up to
+    // 0.5 (BST search), and a quadratic sweep that starts inside L1 reads
+    // as low as 1.75
+    static const double limits[] = {0.2, 0.7, 1.2, 1.6};
+    int model = 0;
+    while (model < COMPLEXITY_COUNT - 1 && slope >= limits[model]) {
+        ++model;
+    }
+    return static_cast<Complexity>(model);
+}
+
+std::vector<ComplexityFit> fitComplexity(const std::vector<ComplexitySample>& samples) {
+    // Growth shows at the large end; small inputs mostly measure fixed costs
+    std::vector<ComplexitySample> tail = samples;
+    std::sort(tail.begin(), tail.end(),
+              [](const ComplexitySample& a, const ComplexitySample& b) { return a.n < b.n; });
+    if (tail.size() >= 6) {
+        tail.erase(tail.begin(), tail.begin() + tail.size() / 2);
+    }
+
+    double slope = complexitySlope(tail);
+    std::vector<ComplexityFit> fits;
+    for (int m = 0; m < COMPLEXITY_COUNT; ++m) {
+        fits.push_back(fitComplexityModel(static_cast<Complexity>(m), tail));
+        fits.back().slope = slope;
+    }
+
+    std::stable_sort(fits.begin(), fits.end(),
+                     [](const ComplexityFit& a, const ComplexityFit& b) { return a.error < b.error; });
+    return fits;
+}
+
+const std::vector<SweepOperation>& sweepOperations() {
+    static const std::vector<SweepOperation> operations = makeOperations();
+    return operations;
+}
+
+ComplexitySweep::ComplexitySweep(const SweepOperation& sweepOperation, size_t minN, unsigned long long seed)
+    : operation(sweepOperation), rng(seed), nextN(minN) {}
+
+bool ComplexitySweep::step() {
+    if (done()) {
+        return false;
+    }
+    samples.push_back({nextN, operation.measure(nextN, rng)});
+    nextN *= 2;
+    return !done();
+}
+
+} // namespace core
@@ -0,0 +1,95 @@
+#pragma once
+
+// Empirical complexity: time one native operation over geometrically growing
+// sizes and fit the timings against the usual growth models.
+//
+// Two readings come out, and callers label them apart. The slope class is
+// read off the slope of the timings on the log-log plot: 0 for O(1), 1 for
+// O(n), 2 for O(n^2). The slope is the median of the slopes between
+// neighbouring sizes, so the step up where the data outgrows a cache level
+// moves one of them and not the result. A log factor only adds about 1/ln n
+// (0.1 here) to the slope, less than cache misses do, so the slope class
+// tells degrees apart but names O(log n) or O(n log n) only when cache
+// effects push the slope between two degrees.
+//
+// The fits model t(n) = c * f(n) by least squares on log t and are ranked by
+// their error; the best fit is the least-error one, which a cache step can
+// tilt towards the next degree. Timer overhead is subtracted when measuring.
+
+#include <cstddef>
+#include <functional>
+#include <random>
+#include <vector>
+
+namespace core {
+
+enum class Complexity { Constant, Logarithmic, Linear, Linearithmic, Quadratic };
+constexpr int COMPLEXITY_COUNT = 5;
+
+struct ComplexitySample {
+    size_t n;
+    double nsPerOp;
+};
+
+struct ComplexityFit {
+    Complexity model = Complexity::Constant;
+    double scale = 0.0;       // c, in ns per unit of f(n)
+    double error = 0.0;       // RMS of the log residuals (0.1 ~ 10% off on average)
+    double slope = 0.0;       // Measured log-log slope of the samples fitted (same in every fit)
+
+    double predict(double n) const;
+};
+
+const char* complexityName(Complexity model);   // "O(n log n)" etc.
+double complexityTerm(Complexity model, double n);
+
+ComplexityFit fitComplexityModel(Complexity model, const std::vector<ComplexitySample>& samples);
+
+// Median slope of log t against log n between neighbouring sizes
+double complexitySlope(const std::vector<ComplexitySample>& samples);
+
+// The class a log-log slope reads as: below 0.2 O(1), below 0.7 O(log n),
+// below 1.2 O(n), below 1.6 O(n log n), O(n^2) from there
+Complexity complexityForSlope(double slope);
+
+// Every model fitted to the larger half of the sizes (with 6 or more
+// samples), least error first. Each carries the slope of those sizes, for
+// complexityForSlope().
+std::vector<ComplexityFit> fitComplexity(const std::vector<ComplexitySample>& samples);
+
+// A native operation the explorer can sweep. measure(n, rng) builds a
+// structure of size n and returns the median nanoseconds of one operation on
+// it; maxN keeps slow setups interactive. `expected` is the textbook class,
+// which the slope class should be (dsbench --check-complexity verifies it).
+struct SweepOperation {
+    const char* name;
+    size_t maxN;
+    Complexity expected;
+    std::function<double(size_t n, std::mt19937_64& rng)> measure;
+};
+
+const std::vector<SweepOperation>& sweepOperations();
+
+// Walks one operation over n = minN, minN*2, ... up to its maxN, one size per
+// step() so a caller can interleave it with frames.
+class ComplexitySweep {
+public:
+    explicit ComplexitySweep(const SweepOperation& operation, size_t minN = 16, unsigned long long seed = 42);
+
+    bool done() const { return nextN > operation.maxN; }
+    size_t nextSize() const { return nextN; }
+
+    // Measures the next size; returns false once the sweep is complete
+    bool step();
+
+    const SweepOperation& getOperation() const { return operation; }
+    const std::vector<ComplexitySample>& getSamples() const { return samples; }
+
+private:
+    const SweepOperation& operation;
+    std::vector<ComplexitySample> samples;
+    std::mt19937_64 rng;
+    size_t nextN;
+};
+
+} // namespace core
@@ -0,0 +1,411 @@
+#include "import.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+namespace core {
+
+namespace {
+
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+const bool LITTLE_ENDIAN_HOST = false;
+#else
+const bool LITTLE_ENDIAN_HOST = true;
+#endif
+
+inline bool isDigit(char c) { return static_cast<unsigned char>(c - '0') < 10; }
+
+inline bool isSeparator(char c) {
+    return c == ',' || c == ';' || c == ' ' || c == '\t' || c == '\r' || c == '\n';
+}
+
+#ifdef __SSE2__
+// Bit i set if p[i] is a decimal digit, for 16 bytes
+inline unsigned digitMask16(const char* p) {
+    __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+    __m128i offset = _mm_sub_epi8(bytes, _mm_set1_epi8('0'));
+    __m128i isDigit = _mm_cmpeq_epi8(_mm_min_epu8(offset, _mm_set1_epi8(9)), offset);
+    return static_cast<unsigned>(_mm_movemask_epi8(isDigit));
+}
+#endif
+
+// Length of the digit run starting at p
+inline size_t digitRun(const char* p, const char* end) {
+#ifdef __SSE2__
+    if (end - p >= 16) {
+        unsigned mask = digitMask16(p);
+        if (mask != 0xFFFF) {
+            return static_cast<size_t>(__builtin_ctz(~mask));
+        }
+    }
+#endif
+    const char* q = p;
+    while (q < end && isDigit(*q)) ++q;
+    return static_cast<size_t>(q - p);
+}
+
+// Value of the first `digits` (1 to 8) ASCII digits at p, with 8 bytes
+// readable. SWAR: all digits are combined pairwise in one 64-bit register.
+inline uint32_t parseDigitsSwar(const char* p, size_t digits) {
+    uint64_t chunk;
+    std::memcpy(&chunk, p, 8);
+    // Bytes past the run may borrow, but only into higher bytes, which the
+    // shift then drops; the shift also fills in leading zeros
+    chunk -= 0x3030303030303030ULL;
+    chunk <<= 8 * (8 - digits);
+    chunk = chunk * 10 + (chunk >> 8);
+    chunk = (((chunk & 0x000000FF000000FFULL) * (100 + (1000000ULL << 32))) +
+             (((chunk >> 16) & 0x000000FF000000FFULL) * (1 + (10000ULL << 32)))) >> 32;
+    return static_cast<uint32_t>(chunk);
+}
+
+bool endsWith(const std::string& text, const char* suffix) {
+    size_t n = std::strlen(suffix);
+    return text.size() >= n && text.compare(text.size() - n, n, suffix) == 0;
+}
+
+std::string describeByte(char c) {
+    if (c >= 32 && c < 127) {
+        return std::string("'") + c + "'";
+    }
+    char text[16];
+    std::snprintf(text, sizeof(text), "byte 0x%02x", static_cast<unsigned char>(c));
+    return text;
+}
+
+} // namespace
+
+ImportFormat importFormatFor(const std::string& path) {
+    std::string lower = path;
+    std::transform(lower.begin(), lower.end(), lower.begin(),
+                   [](char c) { return static_cast<char>(std::tolower(static_cast<unsigned char>(c))); });
+    if (endsWith(lower, ".bin") || endsWith(lower, ".raw") || endsWith(lower, ".i32")) {
+        return ImportFormat::Binary;
+    }
+    return ImportFormat::Csv;
+}
+
+// MappedFile
+
+MappedFile::~MappedFile() {
+    close();
+}
+
+#ifdef _WIN32
+
+bool MappedFile::open(const std::string& path, std::string& error) {
+    close();
+    HANDLE handle = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                                FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (handle == INVALID_HANDLE_VALUE) {
+        error = "cannot open " + path;
+        return false;
+    }
+    fileHandle = handle;
+
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(handle, &fileSize)) {
+        error = "cannot read the size of " + path;
+        close();
+        return false;
+    }
+    length = static_cast<size_t>(fileSize.QuadPart);
+    if (length == 0) {
+        return true;  // Nothing to map
+    }
+
+    mappingHandle = CreateFileMappingA(handle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (mappingHandle == nullptr) {
+        error = "cannot map " + path;
+        close();
+        return false;
+    }
+    bytes = static_cast<const char*>(MapViewOfFile(mappingHandle, FILE_MAP_READ, 0, 0, 0));
+    if (bytes == nullptr) {
+        error = "cannot map " + path;
+        close();
+        return false;
+    }
+    return true;
+}
+
+void MappedFile::close() {
+    if (bytes != nullptr) UnmapViewOfFile(bytes);
+    if (mappingHandle != nullptr) CloseHandle(mappingHandle);
+    if (fileHandle != nullptr) CloseHandle(fileHandle);
+    bytes = nullptr;
+    mappingHandle = nullptr;
+    fileHandle = nullptr;
+    length = 0;
+    released = 0;
+}
+
+// Windows trims the working set of a read-only file view by itself
+void MappedFile::release(size_t) {}
+
+#else
+
+bool MappedFile::open(const std::string& path, std::string& error) {
+    close();
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        error = "cannot open " + path + ": " + std::strerror(errno);
+        return false;
+    }
+    struct stat info;
+    if (fstat(fd, &info) != 0) {
+        error = "cannot stat " + path + ": " + std::strerror(errno);
+        ::close(fd);
+        return false;
+    }
+    length = static_cast<size_t>(info.st_size);
+    if (length == 0) {
+        ::close(fd);
+        return true;  // mmap rejects empty mappings
+    }
+
+    void* mapped = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);  // The mapping keeps the file open
+    if (mapped == MAP_FAILED) {
+        error = "cannot map " + path + ": " + std::strerror(errno);
+        length = 0;
+        return false;
+    }
+    madvise(mapped, length, MADV_SEQUENTIAL);
+    bytes = static_cast<const char*>(mapped);
+    return true;
+}
+
+void MappedFile::close() {
+    if (bytes != nullptr) {
+        munmap(const_cast<char*>(bytes), length);
+    }
+    bytes = nullptr;
+    length = 0;
+    released = 0;
+}
+
+void MappedFile::release(size_t end) {
+    static const size_t pageSize = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    size_t alignedEnd = end / pageSize * pageSize;
+    if (bytes == nullptr || alignedEnd <= released) {
+        return;
+    }
+    madvise(const_cast<char*>(bytes) + released, alignedEnd - released, MADV_DONTNEED);
+    released = alignedEnd;
+}
+
+#endif
+
+// IntegerImport
+
+IntegerImport::IntegerImport(const std::string& path, ImportFormat importFormat) : format(importFormat) {
+    if (!file.open(path, error)) {
+        return;
+    }
+    if (format == ImportFormat::Binary) {
+        if (file.size() % 4 != 0) {
+            fail("binary file size " + std::to_string(file.size()) + " is not a multiple of 4 bytes");
+            return;
+        }
+        values.reserve(file.size() / 4);
+        phase = Phase::Parsing;
+    }
+}
+
+bool IntegerImport::fail(const std::string& message) {
+    error = message;
+    values.clear();
+    values.shrink_to_fit();
+    file.close();
+    return false;
+}
+
+bool IntegerImport::step(size_t budget) {
+    if (failed() || done()) {
+        return false;
+    }
+    bool ok;
+    if (format == ImportFormat::Binary) {
+        ok = readBinaryStep(budget);
+    } else if (phase == Phase::Counting) {
+        ok = countStep(budget);
+    } else {
+        ok = parseCsvStep(budget);
+    }
+    return ok && !done();
+}
+
+// Counts digit runs, an upper bound on the numbers (comments may hold digits)
+bool IntegerImport::countStep(size_t budget) {
+    const char* data = file.data();
+    size_t end = std::min(file.size(), offset + budget);
+    size_t i = offset;
+#ifdef __SSE2__
+    for (; i + 16 <= end; i += 16) {
+        unsigned digits = digitMask16(data + i);
+        unsigned starts = digits & ~((digits << 1) | (inNumber ? 1u : 0u));
+        expected += static_cast<size_t>(__builtin_popcount(starts));
+        inNumber = (digits >> 15) & 1u;
+    }
+#endif
+    for (; i < end; ++i) {
+        bool digit = isDigit(data[i]);
+        if (digit && !inNumber) ++expected;
+        inNumber = digit;
+    }
+    offset = end;
+    file.release(offset);
+
+    if (offset == file.size()) {
+        values.reserve(expected);
+        phase = Phase::Parsing;
+        offset = 0;
+    }
+    return true;
+}
+
+bool IntegerImport::parseCsvStep(size_t budget) {
+    const char* data = file.data();
+    const char* p = data + offset;
+    const char* end = data + file.size();
+    const char* limit = p + std::min(budget, static_cast<size_t>(end - p));
+
+    while (p < limit) {
+        char c = *p;
+        if (c == '\n') {
+            ++line;
+            ++p;
+            continue;
+        }
+        if (isSeparator(c)) {
+            ++p;
+            continue;
+        }
+        if (c == '#') {
+            const void* newline = std::memchr(p, '\n', static_cast<size_t>(end - p));
+            p = newline ? static_cast<const char*>(newline) : end;
+            continue;
+        }
+
+        bool negative = false;
+        if (c == '-' || c == '+') {
+            negative = c == '-';
+            ++p;
+        }
+        if (p == end || !isDigit(*p)) {
+            return fail("line " + std::to_string(line) + ": expected a number");
+        }
+
+        size_t digits = digitRun(p, end);
+        uint64_t magnitude = 0;
+        if (LITTLE_ENDIAN_HOST && digits <= 8 && end - p >= 8) {
+            magnitude = parseDigitsSwar(p, digits);
+        } else {
+            // Leading zeros keep the value small; anything else this long
+            // is out of range, so stop before the accumulator could wrap
+            for (size_t d = 0; d < digits && magnitude <= 0x80000000ULL; ++d) {
+                magnitude = magnitude * 10 + static_cast<uint64_t>(p[d] - '0');
+            }
+        }
+        p += digits;
+
+        if (magnitude > (negative ? 0x80000000ULL : 0x7FFFFFFFULL)) {
+            return fail("line " + std::to_string(line) + ": value out of the 32-bit range");
+        }
+        if (p < end && !isSeparator(*p) && *p != '#') {
+            return fail("line " + std::to_string(line) + ": unexpected " + describeByte(*p));
+        }
+        int64_t value = negative ? -static_cast<int64_t>(magnitude) : static_cast<int64_t>(magnitude);
+        values.push_back(static_cast<int>(value));  // Within the reserved count
+    }
+
+    offset = static_cast<size_t>(p - data);
+    file.release(offset);
+    if (offset == file.size()) {
+        phase = Phase::Done;
+        file.close();
+    }
+    return true;
+}
+
+bool IntegerImport::readBinaryStep(size_t budget) {
+    size_t bytes = std::min(budget / 4 * 4, file.size() - offset);
+    if (bytes == 0 && offset < file.size()) {
+        bytes = 4;
+    }
+    size_t first = values.size();
+    values.resize(first + bytes / 4);  // Within the reserved count
+    std::memcpy(values.data() + first, file.data() + offset, bytes);
+    if (!LITTLE_ENDIAN_HOST) {
+        for (size_t i = first; i < values.size(); ++i) {
+            uint32_t v = static_cast<uint32_t>(values[i]);
+            v = (v >> 24) | ((v >> 8) & 0xFF00u) | ((v << 8) & 0xFF0000u) | (v << 24);
+            values[i] = static_cast<int>(v);
+        }
+    }
+    offset += bytes;
+    file.release(offset);
+    if (offset == file.size()) {
+        phase = Phase::Done;
+        file.close();
+    }
+    return true;
+}
+
+double IntegerImport::progress() const {
+    if (done() || file.size() == 0) {
+        return 1.0;
+    }
+    double fraction = static_cast<double>(offset) / file.size();
+    if (format == ImportFormat::Binary) {
+        return fraction;
+    }
+    // Counting is a fraction of the cost of parsing
+    return phase == Phase::Counting ? 0.2 * fraction : 0.2 + 0.8 * fraction;
+}
+
+const char* IntegerImport::phaseName() const {
+    if (failed()) return "failed";
+    switch (phase) {
+        case Phase::Counting: return "counting";
+        case Phase::Parsing:  return format == ImportFormat::Csv ? "parsing" : "reading";
+        case Phase::Done:     return "done";
+    }
+    return "";
+}
+
+bool importIntegers(const std::string& path, ImportFormat format, std::vector<int>& values, std::string& error) {
+    IntegerImport import(path, format);
+    while (import.step(64 << 20)) {
+    }
+    if (import.failed()) {
+        error = import.getError();
+        return false;
+    }
+    values = import.take();
+    return true;
+}
+
+} // namespace core
@@ -0,0 +1,96 @@
+#pragma once
+
+// Bulk import of integer arrays from files. The file is read through a
+// read-only memory mapping and parsed straight into the result, so the values
+// are the only heap copy; pages already parsed are handed back to the OS as
+// the parser moves on.
+//
+//   csv     decimal integers separated by commas, semicolons or whitespace,
+//           each with an optional leading '-' or '+'; lines starting with '#'
+//           are comments
+//   binary  raw little-endian 32-bit integers
+//
+// CSV is read in two passes: one counts the numbers so the result is reserved
+// exactly once (no growth copies), the second parses them. Both are
+// incremental, so a caller can interleave a large import with frames.
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace core {
+
+enum class ImportFormat { Csv, Binary };
+
+// Binary for ".bin", ".raw" and ".i32", CSV otherwise
+ImportFormat importFormatFor(const std::string& path);
+
+class MappedFile {
+public:
+    MappedFile() = default;
+    ~MappedFile();
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    // Returns false and fills `error` if the file cannot be opened or mapped
+    bool open(const std::string& path, std::string& error);
+    void close();
+
+    const char* data() const { return bytes; }
+    size_t size() const { return length; }
+
+    // Drops the pages in [0, end) from memory; they are re-read on access
+    void release(size_t end);
+
+private:
+    const char* bytes = nullptr;
+    size_t length = 0;
+    size_t released = 0;
+#ifdef _WIN32
+    void* fileHandle = nullptr;
+    void* mappingHandle = nullptr;
+#endif
+};
+
+class IntegerImport {
+public:
+    IntegerImport(const std::string& path, ImportFormat format);
+
+    bool failed() const { return !error.empty(); }
+    bool done() const { return phase == Phase::Done; }
+    const std::string& getError() const { return error; }
+
+    // Reads about `budget` more bytes; returns false once done or failed
+    bool step(size_t budget = 8 << 20);
+
+    double progress() const;              // 0 to 1 over both passes
+    const char* phaseName() const;        // "counting", "parsing", ...
+    size_t fileSize() const { return file.size(); }
+    size_t count() const { return values.size(); }
+
+    // The parsed values; call once done
+    std::vector<int> take() { return std::move(values); }
+
+private:
+    enum class Phase { Counting, Parsing, Done };
+
+    bool countStep(size_t budget);
+    bool parseCsvStep(size_t budget);
+    bool readBinaryStep(size_t budget);
+    bool fail(const std::string& message);
+
+    MappedFile file;
+    ImportFormat format;
+    Phase phase = Phase::Counting;
+    size_t offset = 0;
+    size_t expected = 0;        // Numbers found by the counting pass
+    size_t line = 1;
+    bool inNumber = false;      // Counting pass state across steps
+    std::vector<int> values;
+    std::string error;
+};
+
+// Whole file in one call. Returns false and fills `error` on failure.
+bool importIntegers(const std::string& path, ImportFormat format, std::vector<int>& values, std::string& error);
+
+} // namespace core
@@ -0,0 +1,270 @@
+#include "matrix.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <random>
+
+namespace core {
+
+namespace {
+
+struct NoObserver {
+    void read(int, size_t, size_t) {}
+    void write(int, size_t, size_t) {}
+    void tile(int, size_t, size_t, size_t, size_t) {}
+};
+
+struct TracingObserver {
+    std::vector<MatrixStep>& steps;
+
+    void read(int m, size_t row, size_t col) { add(MatrixStep::Read, m, row, col, 1, 1); }
+    void write(int m, size_t row, size_t col) { add(MatrixStep::Write, m, row, col, 1, 1); }
+    void tile(int m, size_t row, size_t col, size_t rows, size_t cols) {
+        add(MatrixStep::Tile, m, row, col, rows, cols);
+    }
+
+    void add(MatrixStep::Kind kind, int m, size_t row, size_t col, size_t rows, size_t cols) {
+        steps.push_back({kind, static_cast<uint8_t>(m), static_cast<uint32_t>(row), static_cast<uint32_t>(col),
+                         static_cast<uint32_t>(rows), static_cast<uint32_t>(cols)});
+    }
+};
+
+// n x n operands; the kernels only index the ones they use
+struct Operands {
+    size_t n;
+    std::vector<float> a, b, c;
+};
+
+template <typename Observer>
+float rowMajorSum(const Operands& m, Observer& o) {
+    const size_t n = m.n;
+    float sum = 0.f;
+    for (size_t i = 0; i < n; ++i) {
+        for (size_t j = 0; j < n; ++j) {
+            o.read(0, i, j);
+            sum += m.a[i * n + j];
+        }
+    }
+    return sum;
+}
+
+template <typename Observer>
+float columnMajorSum(const Operands& m, Observer& o) {
+    const size_t n = m.n;
+    float sum = 0.f;
+    for (size_t j = 0; j < n; ++j) {
+        for (size_t i = 0; i < n; ++i) {
+            o.read(0, i, j);
+            sum += m.a[i * n + j];
+        }
+    }
+    return sum;
+}
+
+template <typename Observer>
+void transpose(Operands& m, Observer& o) {
+    const size_t n = m.n;
+    for (size_t i = 0; i < n; ++i) {
+        for (size_t j = 0; j < n; ++j) {
+            o.read(0, i, j);
+            o.write(1, j, i);
+            m.b[j * n + i] = m.a[i * n + j];
+        }
+    }
+}
+
+template <typename Observer>
+void blockedTranspose(Operands& m, size_t tile, Observer& o) {
+    const size_t n = m.n;
+    for (size_t ii = 0; ii < n; ii += tile) {
+        size_t iEnd = std::min(ii + tile, n);
+        for (size_t jj = 0; jj < n; jj += tile) {
+            size_t jEnd = std::min(jj + tile, n);
+            o.tile(0, ii, jj, iEnd - ii, jEnd - jj);
+            o.tile(1, jj, ii, jEnd - jj, iEnd - ii);
+            for (size_t i = ii; i < iEnd; ++i) {
+                for (size_t j = jj; j < jEnd; ++j) {
+                    o.read(0, i, j);
+                    o.write(1, j, i);
+                    m.b[j * n + i] = m.a[i * n + j];
+                }
+            }
+        }
+    }
+}
+
+template <typename Observer>
+void multiply(Operands& m, Observer& o) {
+    const size_t n = m.n;
+    for (size_t i = 0; i < n; ++i) {
+        for (size_t j = 0; j < n; ++j) {
+            float sum = 0.f;
+            for (size_t k = 0; k < n; ++k) {
+                o.read(0, i, k);
+                o.read(1, k, j);
+                sum += m.a[i * n + k] * m.b[k * n + j];
+            }
+            o.write(2, i, j);
+            m.c[i * n + j] = sum;
+        }
+    }
+}
+
+template <typename Observer>
+void tiledMultiply(Operands& m, size_t tile, Observer& o) {
+    const size_t n = m.n;
+    std::fill(m.c.begin(), m.c.end(), 0.f);
+    for (size_t ii = 0; ii < n; ii += tile) {
+        size_t iEnd = std::min(ii + tile, n);
+        for (size_t kk = 0; kk < n; kk += tile) {
+            size_t kEnd = std::min(kk + tile, n);
+            for (size_t jj = 0; jj < n; jj += tile) {
+                size_t jEnd = std::min(jj + tile, n);
+                o.tile(0, ii, kk, iEnd - ii, kEnd - kk);
+                o.tile(1, kk, jj, kEnd - kk, jEnd - jj);
+                o.tile(2, ii, jj, iEnd - ii, jEnd - jj);
+                for (size_t i = ii; i < iEnd; ++i) {
+                    for (size_t k = kk; k < kEnd; ++k) {
+                        o.read(0, i, k);
+                        float aik = m.a[i * n + k];
+                        // Unit stride through B and C
+                        for (size_t j = jj; j < jEnd; ++j) {
+                            o.read(1, k, j);
+                            o.write(2, i, j);
+                            m.c[i * n + j] += aik * m.b[k * n + j];
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
+
+template <typename Observer>
+float runKernel(MatrixKernel kernel, Operands& m, size_t tile, Observer& o) {
+    tile = std::max<size_t>(1, tile);
+    switch (kernel) {
+        case MatrixKernel::RowMajor:         return rowMajorSum(m, o);
+        case MatrixKernel::ColumnMajor:      return columnMajorSum(m, o);
+        case MatrixKernel::Transpose:        transpose(m, o); break;
+        case MatrixKernel::BlockedTranspose: blockedTranspose(m, tile, o); break;
+        case MatrixKernel::Multiply:         multiply(m, o); break;
+        case MatrixKernel::TiledMultiply:    tiledMultiply(m, tile, o); break;
+    }
+    return m.n > 0 ? (matrixOperands(kernel) == 3 ? m.c[0] : m.b[0]) : 0.f;
+}
+
+Operands makeOperands(MatrixKernel kernel, size_t n) {
+    Operands m;
+    m.n = n;
+    int count = matrixOperands(kernel);
+    std::mt19937 rng(static_cast<uint32_t>(n));
+    std::uniform_real_distribution<float> value(-1.f, 1.f);
+    m.a.resize(n * n);
+    for (float& x : m.a) x = value(rng);
+    if (count >= 2) {
+        m.b.resize(n * n);
+        if (count == 3) {
+            for (float& x : m.b) x = value(rng);
+        }
+    }
+    if (count == 3) m.c.resize(n * n);
+    return m;
+}
+
+// Keeps timed results from being optimized away
+volatile float sink = 0.f;
+
+} // namespace
+
+const char* matrixKernelName(MatrixKernel kernel) {
+    switch (kernel) {
+        case MatrixKernel::RowMajor:         return "row-major";
+        case MatrixKernel::ColumnMajor:      return "column-major";
+        case MatrixKernel::Transpose:        return "transpose";
+        case MatrixKernel::BlockedTranspose: return "blocked-transpose";
+        case MatrixKernel::Multiply:         return "multiply";
+        case MatrixKernel::TiledMultiply:    return "tiled-multiply";
+    }
+    return "";
+}
+
+bool parseMatrixKernel(const std::string& name, MatrixKernel& kernel) {
+    for (int k = 0; k < MATRIX_KERNEL_COUNT; ++k) {
+        if (name == matrixKernelName(static_cast<MatrixKernel>(k))) {
+            kernel = static_cast<MatrixKernel>(k);
+            return true;
+        }
+    }
+    return false;
+}
+
+MatrixKernel matrixCounterpart(MatrixKernel kernel) {
+    // Pairs sit next to each other in the enum
+    return static_cast<MatrixKernel>(static_cast<int>(kernel) ^ 1);
+}
+
+int matrixOperands(MatrixKernel kernel) {
+    switch (kernel) {
+        case MatrixKernel::RowMajor:
+        case MatrixKernel::ColumnMajor:      return 1;
+        case MatrixKernel::Transpose:
+        case MatrixKernel::BlockedTranspose: return 2;
+        case MatrixKernel::Multiply:
+        case MatrixKernel::TiledMultiply:    return 3;
+    }
+    return 1;
+}
+
+const char* matrixRateUnit(MatrixKernel kernel) {
+    return matrixOperands(kernel) == 3 ? "GFLOP/s" : "GB/s";
+}
+
+bool checkMatrixKernel(MatrixKernel kernel, size_t n, std::string& error) {
+    double cube = static_cast<double>(n) * n * n;
+    if (matrixOperands(kernel) == 3 && cube > MATRIX_MULTIPLY_BUDGET) {
+        char text[160];
+        std::snprintf(text, sizeof(text), "%s would make %.2g multiply-adds at n = %zu (limit %.2g)",
+                      matrixKernelName(kernel), cube, n, MATRIX_MULTIPLY_BUDGET);
+        error = text;
+        return false;
+    }
+    return true;
+}
+
+std::vector<MatrixStep> traceMatrixKernel(MatrixKernel kernel, size_t n, size_t tile) {
+    std::vector<MatrixStep> steps;
+    Operands m = makeOperands(kernel, n);
+    TracingObserver o{steps};
+    runKernel(kernel, m, tile, o);
+    return steps;
+}
+
+MatrixTiming timeMatrixKernel(MatrixKernel kernel, size_t n, size_t tile, int runs) {
+    MatrixTiming timing;
+    if (n == 0) return timing;
+
+    Operands m = makeOperands(kernel, n);
+    NoObserver o;
+    std::vector<double> times;
+    for (int r = 0; r < std::max(1, runs); ++r) {
+        auto start = std::chrono::steady_clock::now();
+        float result = runKernel(kernel, m, tile, o);
+        auto end = std::chrono::steady_clock::now();
+        sink = sink + result;
+        times.push_back(std::chrono::duration<double, std::nano>(end - start).count());
+    }
+    std::nth_element(times.begin(), times.begin() + times.size() / 2, times.end());
+    timing.ns = times[times.size() / 2];
+
+    double elements = static_cast<double>(n) * n;
+    if (matrixOperands(kernel) == 3) {
+        timing.rate = 2.0 * elements * n / timing.ns;   // FLOP per ns = GFLOP/s
+    } else {
+        timing.rate = matrixOperands(kernel) * elements * sizeof(float) / timing.ns;   // Bytes per ns = GB/s
+    }
+    return timing;
+}
+
+} // namespace core
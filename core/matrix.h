@@ -0,0 +1,83 @@
+#pragma once
+
+// Square row-major float matrices and the kernels the matrix view sets side
+// by side, written once against an observer that sees every element read and
+// write, so the native timing and the visualizer's replay run the same loops.
+// The kernels come in pairs doing the same work in a different order:
+//
+//   row-major           sums A row by row: consecutive addresses, every byte
+//                       of a fetched cache line used before the next
+//   column-major        the same sum column by column: a stride of n floats,
+//                       so once a column of lines outgrows the cache every
+//                       read is a miss
+//   transpose           B[j][i] = A[i][j] row by row: the reads stream, the
+//                       writes stride down B's columns
+//   blocked-transpose   the same a tile at a time: the tile of A and the tile
+//                       of B both stay in cache while it is copied
+//   multiply            C = A x B in i-j-k order: each dot product walks down
+//                       a column of B
+//   tiled-multiply      i-k-j order inside tiles of all three matrices: the
+//                       inner loop runs along rows of B and C, and each tile
+//                       is reused from cache instead of refetched
+//
+// Both members of a pair execute the same arithmetic; what differs is how
+// often the data has to come from memory.
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace core {
+
+enum class MatrixKernel { RowMajor, ColumnMajor, Transpose, BlockedTranspose, Multiply, TiledMultiply };
+constexpr int MATRIX_KERNEL_COUNT = 6;
+
+const char* matrixKernelName(MatrixKernel kernel);      // "blocked-transpose" etc.
+bool parseMatrixKernel(const std::string& name, MatrixKernel& kernel);
+
+// The other member of the kernel's pair
+MatrixKernel matrixCounterpart(MatrixKernel kernel);
+
+// Matrices the kernel touches: A for the sums, A and B = A^T for the
+// transposes, A, B and C = A x B for the multiplies
+int matrixOperands(MatrixKernel kernel);
+
+// Tile edge of the blocked kernels: three 32x32 float tiles take 12 KB,
+// inside any L1 data cache
+constexpr size_t MATRIX_TILE = 32;
+
+// Multiply-adds a multiply may cost before it is refused. n = 1024 (1.07e9)
+// still runs, taking seconds in i-j-k order; that is where tiling pays most.
+constexpr double MATRIX_MULTIPLY_BUDGET = 1.1e9;
+
+// False (and why) when the kernel at n x n is too slow to run interactively
+bool checkMatrixKernel(MatrixKernel kernel, size_t n, std::string& error);
+
+// One element access, or the tiles a blocked kernel moves to next (one step
+// per operand). `matrix` indexes the operands: 0 = A, 1 = B, 2 = C.
+struct MatrixStep {
+    enum Kind : uint8_t { Read, Write, Tile };
+    Kind kind;
+    uint8_t matrix;
+    uint32_t row;       // Tile: its top left corner
+    uint32_t col;
+    uint32_t rows;      // Tile only
+    uint32_t cols;
+};
+
+// Every step of the kernel on n x n operands (small n only)
+std::vector<MatrixStep> traceMatrixKernel(MatrixKernel kernel, size_t n, size_t tile);
+
+struct MatrixTiming {
+    double ns = 0.0;        // Median over the runs, preparing the operands excluded
+    double rate = 0.0;      // In matrixRateUnit()
+};
+
+// GB/s of operand bytes for the sums and transposes, GFLOP/s for the multiplies
+const char* matrixRateUnit(MatrixKernel kernel);
+
+// Times the kernel on n x n operands of seeded values
+MatrixTiming timeMatrixKernel(MatrixKernel kernel, size_t n, size_t tile, int runs);
+
+} // namespace core
@@ -0,0 +1,219 @@
+#include "parallel_sort.h"
+
+#include <algorithm>
+#include <chrono>
+#include <iterator>
+
+#ifdef DSV_PAR_STL
+#include <execution>
+#endif
+
+namespace core {
+
+namespace {
+
+struct Context {
+    ThreadPool& pool;
+    size_t cutoff;
+    ParallelSortTrace* trace;
+
+    void begin(size_t lo, size_t hi) {
+        if (trace) trace->begin(pool.currentThread(), lo, hi);
+    }
+    void end(size_t lo, size_t hi, const int* values) {
+        if (trace) trace->end(pool.currentThread(), lo, hi, values);
+    }
+};
+
+// Merges two sorted runs into `out`; `base` is the start of the array `out`
+// points into, for the trace
+void parallelMerge(const int* a, size_t aCount, const int* b, size_t bCount, int* out, const int* base,
+                   Context& c) {
+    if (aCount < bCount) {
+        std::swap(a, b);
+        std::swap(aCount, bCount);
+    }
+    if (aCount + bCount <= c.cutoff || aCount < 2) {
+        size_t lo = static_cast<size_t>(out - base);
+        c.begin(lo, lo + aCount + bCount);
+        std::merge(a, a + aCount, b, b + bCount, out);
+        c.end(lo, lo + aCount + bCount, out);
+        return;
+    }
+    // Everything before a[half] in either run goes left of it
+    size_t half = aCount / 2;
+    size_t split = static_cast<size_t>(std::lower_bound(b, b + bCount, a[half]) - b);
+    TaskGroup group;
+    c.pool.spawn(group, [=, &c]() { parallelMerge(a, half, b, split, out, base, c); });
+    parallelMerge(a + half, aCount - half, b + split, bCount - split, out + half + split, base, c);
+    c.pool.wait(group);
+}
+
+// Sorts [lo, hi) of `array`, leaving the result in `buffer` when intoBuffer.
+// Children sort into the other array, so each level merges straight across.
+void mergeSortRange(int* array, int* buffer, size_t lo, size_t hi, bool intoBuffer, Context& c) {
+    if (hi - lo <= c.cutoff) {
+        c.begin(lo, hi);
+        std::sort(array + lo, array + hi);
+        if (intoBuffer) std::copy(array + lo, array + hi, buffer + lo);
+        c.end(lo, hi, array + lo);
+        return;
+    }
+    size_t mid = lo + (hi - lo) / 2;
+    TaskGroup group;
+    c.pool.spawn(group, [=, &c]() { mergeSortRange(array, buffer, lo, mid, !intoBuffer, c); });
+    mergeSortRange(array, buffer, mid, hi, !intoBuffer, c);
+    c.pool.wait(group);
+
+    int* from = intoBuffer ? array : buffer;
+    int* to = intoBuffer ? buffer : array;
+    parallelMerge(from + lo, mid - lo, from + mid, hi - mid, to + lo, to, c);
+}
+
+// Partitions and hands the left side to the pool until the rest is small
+void quickSortRange(int* a, size_t lo, size_t hi, TaskGroup& group, Context& c) {
+    while (hi - lo > c.cutoff) {
+        c.begin(lo, hi);
+        int x = a[lo], y = a[lo + (hi - lo) / 2], z = a[hi - 1];
+        int pivot = std::max(std::min(x, y), std::min(std::max(x, y), z));
+        // < pivot, == pivot, > pivot: runs of equal values drop out at once
+        int* equal = std::partition(a + lo, a + hi, [pivot](int v) { return v < pivot; });
+        int* greater = std::partition(equal, a + hi, [pivot](int v) { return !(pivot < v); });
+        c.end(lo, hi, a + lo);
+
+        size_t leftEnd = static_cast<size_t>(equal - a);
+        c.pool.spawn(group, [=, &group, &c]() { quickSortRange(a, lo, leftEnd, group, c); });
+        lo = static_cast<size_t>(greater - a);
+    }
+    if (hi - lo > 1) {
+        c.begin(lo, hi);
+        std::sort(a + lo, a + hi);
+        c.end(lo, hi, a + lo);
+    }
+}
+
+template <typename Sort>
+double medianNs(const std::vector<int>& input, int runs, Sort sort) {
+    std::vector<double> times;
+    std::vector<int> scratch;
+    for (int r = 0; r < std::max(1, runs); ++r) {
+        scratch = input;
+        auto start = std::chrono::steady_clock::now();
+        sort(scratch);
+        auto end = std::chrono::steady_clock::now();
+        times.push_back(std::chrono::duration<double, std::nano>(end - start).count());
+    }
+    std::nth_element(times.begin(), times.begin() + times.size() / 2, times.end());
+    return times[times.size() / 2];
+}
+
+} // namespace
+
+const char* parallelSortName(ParallelSort algorithm) {
+    switch (algorithm) {
+        case ParallelSort::Merge: return "parallel-merge";
+        case ParallelSort::Quick: return "parallel-quick";
+    }
+    return "";
+}
+
+bool parseParallelSort(const std::string& name, ParallelSort& algorithm) {
+    for (int k = 0; k < PARALLEL_SORT_COUNT; ++k) {
+        if (name == parallelSortName(static_cast<ParallelSort>(k))) {
+            algorithm = static_cast<ParallelSort>(k);
+            return true;
+        }
+    }
+    return false;
+}
+
+ParallelSortTrace::ParallelSortTrace(size_t threads) : perThread(std::max<size_t>(1, threads)) {}
+
+void ParallelSortTrace::record(size_t thread, ParallelSortEvent event) {
+    uint64_t order = sequence.fetch_add(1, std::memory_order_relaxed);
+    perThread[thread].emplace_back(order, std::move(event));
+}
+
+void ParallelSortTrace::begin(size_t thread, size_t lo, size_t hi) {
+    record(thread, {static_cast<uint32_t>(thread), static_cast<uint32_t>(lo), static_cast<uint32_t>(hi),
+                    false, {}});
+}
+
+void ParallelSortTrace::end(size_t thread, size_t lo, size_t hi, const int* values) {
+    record(thread, {static_cast<uint32_t>(thread), static_cast<uint32_t>(lo), static_cast<uint32_t>(hi),
+                    true, std::vector<int>(values, values + (hi - lo))});
+}
+
+std::vector<ParallelSortEvent> ParallelSortTrace::take() {
+    std::vector<std::pair<uint64_t, ParallelSortEvent>> all;
+    for (auto& events : perThread) {
+        std::move(events.begin(), events.end(), std::back_inserter(all));
+        events.clear();
+    }
+    std::sort(all.begin(), all.end(),
+              [](const std::pair<uint64_t, ParallelSortEvent>& x, const std::pair<uint64_t, ParallelSortEvent>& y) {
+                  return x.first < y.first;
+              });
+    std::vector<ParallelSortEvent> ordered;
+    ordered.reserve(all.size());
+    for (auto& entry : all) {
+        ordered.push_back(std::move(entry.second));
+    }
+    return ordered;
+}
+
+void parallelSort(ParallelSort algorithm, std::vector<int>& values, ThreadPool& pool,
+                  const ParallelSortOptions& options) {
+    Context c{pool, std::max<size_t>(1, options.cutoff), options.trace};
+    size_t n = values.size();
+    if (n < 2) return;
+
+    if (algorithm == ParallelSort::Merge) {
+        std::vector<int> buffer(n);
+        mergeSortRange(values.data(), buffer.data(), 0, n, false, c);
+    } else {
+        TaskGroup group;
+        quickSortRange(values.data(), 0, n, group, c);
+        pool.wait(group);
+    }
+}
+
+std::vector<size_t> scalingThreadCounts(size_t maxThreads) {
+    std::vector<size_t> counts;
+    for (size_t threads = 1; threads <= maxThreads; ++threads) {
+        bool powerOfTwo = (threads & (threads - 1)) == 0;
+        if (threads <= 8 || powerOfTwo || threads == maxThreads) {
+            counts.push_back(threads);
+        }
+    }
+    if (counts.empty()) counts.push_back(1);
+    return counts;
+}
+
+std::vector<ScalingPoint> measureParallelScaling(ParallelSort algorithm, const std::vector<int>& input,
+                                                 const std::vector<size_t>& threadCounts, int runs) {
+    std::vector<ScalingPoint> points;
+    for (size_t threads : threadCounts) {
+        // Started outside the timing
+        ThreadPool pool(threads);
+        double ns = medianNs(input, runs, [&](std::vector<int>& values) { parallelSort(algorithm, values, pool); });
+        points.push_back({threads, ns});
+    }
+    return points;
+}
+
+bool parallelStdSortNs(const std::vector<int>& input, int runs, double& ns) {
+#ifdef DSV_PAR_STL
+    ns = medianNs(input, runs, [](std::vector<int>& values) {
+        std::sort(std::execution::par, values.begin(), values.end());
+    });
+    return true;
+#else
+    (void)input;
+    (void)runs;
+    (void)ns;
+    return false;
+#endif
+}
+
+} // namespace core
@@ -0,0 +1,89 @@
+#pragma once
+
+// Parallel sorts on a ThreadPool.
+//
+//   parallel-merge   splits in half down to `cutoff` elements, sorts the
+//                    leaves with std::sort and merges back up between the
+//                    array and one n-element buffer. Large merges split too:
+//                    the middle of the longer run is found in the shorter by
+//                    binary search and the two halves merge in parallel
+//   parallel-quick   three-way partition around a median-of-three pivot,
+//                    then both sides become tasks. The first partitions run
+//                    on one thread over the whole array, which caps scaling
+//
+// Either way every element crosses memory a few times per level, so past a
+// handful of threads the sort waits on memory bandwidth rather than cores.
+// measureParallelScaling() shows where that happens on this machine.
+//
+// `make PARSTL=1` adds std::sort(std::execution::par) as a reference; with
+// libstdc++ that needs TBB.
+
+#include "thread_pool.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace core {
+
+enum class ParallelSort { Merge, Quick };
+constexpr int PARALLEL_SORT_COUNT = 2;
+
+const char* parallelSortName(ParallelSort algorithm);   // "parallel-merge" etc.
+bool parseParallelSort(const std::string& name, ParallelSort& algorithm);
+
+// A task's range: `values` holds what the task left in [lo, hi) when it ended
+// (empty on the begin event). Merge tasks that write into the buffer report
+// the values there, as they will stand once they reach the array.
+struct ParallelSortEvent {
+    uint32_t thread;
+    uint32_t lo;
+    uint32_t hi;
+    bool end;
+    std::vector<int> values;
+};
+
+// Collects events from every thread; take() returns them in the order they
+// happened. Copies each finished range, so meant for small arrays.
+class ParallelSortTrace {
+public:
+    explicit ParallelSortTrace(size_t threads);
+
+    void begin(size_t thread, size_t lo, size_t hi);
+    void end(size_t thread, size_t lo, size_t hi, const int* values);
+    std::vector<ParallelSortEvent> take();
+
+private:
+    void record(size_t thread, ParallelSortEvent event);
+
+    // One list per thread, so recording needs no lock
+    std::vector<std::vector<std::pair<uint64_t, ParallelSortEvent>>> perThread;
+    std::atomic<uint64_t> sequence{0};
+};
+
+struct ParallelSortOptions {
+    size_t cutoff = 8192;                  // Ranges this small sort on one thread
+    ParallelSortTrace* trace = nullptr;
+};
+
+void parallelSort(ParallelSort algorithm, std::vector<int>& values, ThreadPool& pool,
+                  const ParallelSortOptions& options = ParallelSortOptions());
+
+struct ScalingPoint {
+    size_t threads;
+    double ns;          // Median over the runs, copying the input excluded
+};
+
+// Thread counts worth timing up to maxThreads: every count up to 8, then
+// powers of two and maxThreads itself
+std::vector<size_t> scalingThreadCounts(size_t maxThreads);
+
+// Times the sort with each thread count on copies of `input`
+std::vector<ScalingPoint> measureParallelScaling(ParallelSort algorithm, const std::vector<int>& input,
+                                                 const std::vector<size_t>& threadCounts, int runs);
+
+// std::sort(std::execution::par); false (and no timing) when not built in
+bool parallelStdSortNs(const std::vector<int>& input, int runs, double& ns);
+
+} // namespace core
@@ -0,0 +1,142 @@
+#include "perf_counters.h"
+
+#ifdef __linux__
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace core {
+
+const char* PerfCounters::name(Counter c) {
+    switch (c) {
+        case Counter::Cycles:       return "Cycles";
+        case Counter::Instructions: return "Instructions";
+        case Counter::L1DMisses:    return "L1D misses";
+        case Counter::LLCMisses:    return "LLC misses";
+        case Counter::BranchMisses: return "Branch misses";
+    }
+    return "";
+}
+
+#ifdef __linux__
+
+namespace {
+
+struct EventConfig {
+    uint32_t type;
+    uint64_t config;
+};
+
+// Same order as core::Counter
+const EventConfig EVENTS[COUNTER_COUNT] = {
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES},
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS},
+    {PERF_TYPE_HW_CACHE, PERF_COUNT_HW_CACHE_L1D | (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                         (PERF_COUNT_HW_CACHE_RESULT_MISS << 16)},
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES},
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES},
+};
+
+int openEvent(const EventConfig& event, int groupFd) {
+    perf_event_attr attr;
+    std::memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = event.type;
+    attr.config = event.config;
+    attr.disabled = groupFd == -1 ? 1 : 0;  // The leader starts and stops the group
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    attr.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_ID;
+    return static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, groupFd, 0));
+}
+
+} // namespace
+
+PerfCounters::PerfCounters() {
+    for (int i = 0; i < COUNTER_COUNT; ++i) {
+        fds[i] = -1;
+    }
+    // Whichever event opens first leads the group; the rest join it or are
+    // left out if this CPU does not have them
+    for (int i = 0; i < COUNTER_COUNT; ++i) {
+        fds[i] = openEvent(EVENTS[i], groupFd);
+        if (fds[i] >= 0 && groupFd < 0) {
+            groupFd = fds[i];
+        } else if (fds[i] < 0 && groupFd < 0 && reason.empty()) {
+            reason = std::string("perf_event_open: ") + std::strerror(errno);
+        }
+    }
+    if (groupFd >= 0) {
+        reason.clear();
+    }
+    for (int i = 0; i < COUNTER_COUNT; ++i) {
+        uint64_t id = 0;
+        if (fds[i] >= 0) {
+            ioctl(fds[i], PERF_EVENT_IOC_ID, &id);
+        }
+        ids[i] = id;
+    }
+}
+
+PerfCounters::~PerfCounters() {
+    for (int i = 0; i < COUNTER_COUNT; ++i) {
+        if (fds[i] >= 0) {
+            close(fds[i]);
+        }
+    }
+}
+
+void PerfCounters::start() {
+    if (groupFd < 0) return;
+    ioctl(groupFd, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+    ioctl(groupFd, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+}
+
+CounterSample PerfCounters::stop() {
+    CounterSample sample;
+    if (groupFd < 0) return sample;
+    ioctl(groupFd, PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+
+    // PERF_FORMAT_GROUP | PERF_FORMAT_ID: nr, then {value, id} per event
+    uint64_t buffer[1 + 2 * COUNTER_COUNT];
+    if (read(groupFd, buffer, sizeof(buffer)) <= 0) {
+        return sample;
+    }
+    uint64_t count = buffer[0];
+    for (uint64_t e = 0; e < count && e < COUNTER_COUNT; ++e) {
+        uint64_t value = buffer[1 + 2 * e];
+        uint64_t id = buffer[2 + 2 * e];
+        for (int i = 0; i < COUNTER_COUNT; ++i) {
+            if (fds[i] >= 0 && ids[i] == id) {
+                sample.values[i] = static_cast<long long>(value);
+                sample.valid[i] = true;
+            }
+        }
+    }
+    sample.ok = true;
+    return sample;
+}
+
+#else
+
+PerfCounters::PerfCounters() : reason("hardware counters need Linux perf_event_open") {
+    for (int i = 0; i < COUNTER_COUNT; ++i) {
+        fds[i] = -1;
+        ids[i] = 0;
+    }
+}
+
+PerfCounters::~PerfCounters() {}
+
+void PerfCounters::start() {}
+
+CounterSample PerfCounters::stop() { return CounterSample(); }
+
+#endif
+
+} // namespace core
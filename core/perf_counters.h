@@ -0,0 +1,55 @@
+#pragma once
+
+// Hardware performance counters around a block of code, via perf_event_open on
+// Linux. Everywhere else, or when the kernel refuses (perf_event_paranoid,
+// containers, VMs without a PMU), available() is false and measure() still runs
+// the code but reports nothing. Counters that the CPU lacks are reported
+// individually as missing while the rest keep working.
+
+#include <string>
+
+namespace core {
+
+enum class Counter { Cycles, Instructions, L1DMisses, LLCMisses, BranchMisses };
+constexpr int COUNTER_COUNT = 5;
+
+struct CounterSample {
+    bool ok = false;                         // Counters were running for this sample
+    long long values[COUNTER_COUNT] = {};
+    bool valid[COUNTER_COUNT] = {};          // This counter opened successfully
+
+    long long get(Counter c) const { return values[static_cast<int>(c)]; }
+    bool has(Counter c) const { return ok && valid[static_cast<int>(c)]; }
+};
+
+class PerfCounters {
+public:
+    PerfCounters();
+    ~PerfCounters();
+    PerfCounters(const PerfCounters&) = delete;
+    PerfCounters& operator=(const PerfCounters&) = delete;
+
+    bool available() const { return groupFd >= 0; }
+    const std::string& unavailableReason() const { return reason; }
+
+    // User-space counts only, for the calling thread
+    void start();
+    CounterSample stop();
+
+    template <typename F>
+    CounterSample measure(F&& body) {
+        start();
+        body();
+        return stop();
+    }
+
+    static const char* name(Counter c);
+
+private:
+    int groupFd = -1;
+    int fds[COUNTER_COUNT];
+    unsigned long long ids[COUNTER_COUNT];  // Kernel event ids, to match group reads
+    std::string reason;
+};
+
+} // namespace core
@@ -0,0 +1,312 @@
+#include "scan.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+namespace core {
+
+namespace {
+
+// Wrapping add: signed overflow is undefined, unsigned wraps
+inline int add(int a, int b) {
+    return static_cast<int>(static_cast<uint32_t>(a) + static_cast<uint32_t>(b));
+}
+
+struct NoObserver {
+    void step(ScanStep::Kind, size_t, size_t, size_t, const int*) {}
+};
+
+// Records steps on elements below `count`; the blelloch padding is skipped
+struct TracingObserver {
+    std::vector<ScanStep>& steps;
+    size_t count;
+
+    void step(ScanStep::Kind kind, size_t level, size_t left, size_t right, const int* a) {
+        bool leftReal = left != ScanStep::NO_INDEX && left < count;
+        bool rightReal = right < count;
+        // An up-sweep only changes `right`, a down-sweep both
+        if (kind == ScanStep::Up ? !rightReal : !leftReal && !rightReal) return;
+        steps.push_back({kind, static_cast<uint8_t>(level),
+                         leftReal ? static_cast<uint32_t>(left) : ScanStep::NO_INDEX,
+                         rightReal ? static_cast<uint32_t>(right) : ScanStep::NO_INDEX,
+                         leftReal ? a[left] : 0, rightReal ? a[right] : 0});
+    }
+};
+
+// Below this many loop iterations a level or chunk runs on the caller
+const size_t PARALLEL_GRAIN = size_t(1) << 14;
+
+// Runs body(lo, hi) over [0, count) in one slice per pool thread
+template <typename Body>
+void parallelFor(ThreadPool* pool, size_t count, Body body) {
+    if (!pool || pool->size() == 1 || count < PARALLEL_GRAIN) {
+        body(size_t(0), count);
+        return;
+    }
+    size_t slices = pool->size();
+    size_t slice = (count + slices - 1) / slices;
+    TaskGroup group;
+    for (size_t lo = slice; lo < count; lo += slice) {
+        size_t hi = std::min(count, lo + slice);
+        pool->spawn(group, [=]() { body(lo, hi); });
+    }
+    body(size_t(0), std::min(count, slice));
+    pool->wait(group);
+}
+
+template <typename Observer>
+void sequentialScan(ScanKind kind, const int* in, int* out, size_t n, int offset, Observer& o) {
+    int sum = offset;
+    for (size_t i = 0; i < n; ++i) {
+        int value = in[i];
+        if (kind == ScanKind::Exclusive) {
+            out[i] = sum;
+            sum = add(sum, value);
+        } else {
+            sum = add(sum, value);
+            out[i] = sum;
+        }
+        o.step(ScanStep::Carry, 0, i == 0 ? ScanStep::NO_INDEX : i - 1, i, out);
+    }
+}
+
+// The scan of a chunk, starting from `offset`
+void simdScan(ScanKind kind, const int* in, int* out, size_t n, int offset) {
+    size_t i = 0;
+#ifdef __SSE2__
+    __m128i carry = _mm_set1_epi32(offset);
+    for (; i + 4 <= n; i += 4) {
+        __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));
+        // [a, b, c, d] -> [a, a+b, b+c, c+d] -> [a, a+b, a+b+c, a+b+c+d]
+        __m128i sums = _mm_add_epi32(x, _mm_slli_si128(x, 4));
+        sums = _mm_add_epi32(sums, _mm_slli_si128(sums, 8));
+        sums = _mm_add_epi32(sums, carry);
+        carry = _mm_shuffle_epi32(sums, _MM_SHUFFLE(3, 3, 3, 3));
+        if (kind == ScanKind::Exclusive) {
+            sums = _mm_sub_epi32(sums, x);
+        }
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), sums);
+    }
+    if (i > 0) {
+        offset = _mm_cvtsi128_si32(carry);
+    }
+#endif
+    NoObserver o;
+    sequentialScan(kind, in + i, out + i, n - i, offset, o);
+}
+
+// In place over a power-of-two `size` (count real elements, zeros after);
+// leaves the exclusive scan
+template <typename Observer>
+void blellochTree(int* a, size_t size, ThreadPool* pool, Observer& o) {
+    size_t level = 0;
+    for (size_t half = 1; half < size; half *= 2, ++level) {
+        size_t stride = half * 2;
+        parallelFor(pool, size / stride, [=, &o](size_t lo, size_t hi) {
+            for (size_t k = lo; k < hi; ++k) {
+                size_t right = k * stride + stride - 1;
+                a[right] = add(a[right], a[right - half]);
+                o.step(ScanStep::Up, level, right - half, right, a);
+            }
+        });
+    }
+
+    a[size - 1] = 0;
+    o.step(ScanStep::Clear, 0, ScanStep::NO_INDEX, size - 1, a);
+
+    for (size_t half = size / 2; half >= 1; half /= 2) {
+        --level;
+        size_t stride = half * 2;
+        parallelFor(pool, size / stride, [=, &o](size_t lo, size_t hi) {
+            for (size_t k = lo; k < hi; ++k) {
+                size_t right = k * stride + stride - 1;
+                size_t left = right - half;
+                int held = a[left];
+                a[left] = a[right];
+                a[right] = add(a[right], held);
+                o.step(ScanStep::Down, level, left, right, a);
+            }
+        });
+    }
+}
+
+template <typename Observer>
+void blellochScan(ScanKind kind, const int* in, int* out, size_t n, ThreadPool* pool, Observer& o) {
+    size_t size = size_t(1) << scanTreeLevels(n);
+    // Power-of-two counts work in `out`; others in a zero-padded copy
+    std::vector<int> padded;
+    int* a = out;
+    if (size != n) {
+        padded.assign(size, 0);
+        a = padded.data();
+    }
+    if (a != in) {
+        parallelFor(pool, n, [=](size_t lo, size_t hi) { std::copy(in + lo, in + hi, a + lo); });
+    }
+
+    // Inclusive adds the input back, so keep it when scanning in place
+    std::vector<int> kept;
+    const int* source = in;
+    if (kind == ScanKind::Inclusive && a == in) {
+        kept.assign(in, in + n);
+        source = kept.data();
+    }
+
+    blellochTree(a, size, pool, o);
+
+    parallelFor(pool, n, [=, &o](size_t lo, size_t hi) {
+        for (size_t i = lo; i < hi; ++i) {
+            if (kind == ScanKind::Inclusive) {
+                a[i] = add(a[i], source[i]);
+                o.step(ScanStep::AddInput, 0, ScanStep::NO_INDEX, i, a);
+            }
+            out[i] = a[i];
+        }
+    });
+}
+
+void chunkedScan(ScanKind kind, const int* in, int* out, size_t n, ThreadPool* pool) {
+    size_t chunks = pool ? pool->size() : 1;
+    if (chunks == 1 || n < PARALLEL_GRAIN) {
+        simdScan(kind, in, out, n, 0);
+        return;
+    }
+    size_t chunk = (n + chunks - 1) / chunks;
+    std::vector<int> offsets(chunks, 0);
+
+    // Each chunk's total, then their exclusive scan is where each one starts
+    TaskGroup group;
+    for (size_t c = 0; c < chunks; ++c) {
+        pool->spawn(group, [=, &offsets]() {
+            size_t lo = std::min(n, c * chunk), hi = std::min(n, lo + chunk);
+            uint32_t total = 0;
+            for (size_t i = lo; i < hi; ++i) total += static_cast<uint32_t>(in[i]);
+            offsets[c] = static_cast<int>(total);
+        });
+    }
+    pool->wait(group);
+    NoObserver o;
+    sequentialScan(ScanKind::Exclusive, offsets.data(), offsets.data(), chunks, 0, o);
+
+    for (size_t c = 0; c < chunks; ++c) {
+        pool->spawn(group, [=, &offsets]() {
+            size_t lo = std::min(n, c * chunk), hi = std::min(n, lo + chunk);
+            simdScan(kind, in + lo, out + lo, hi - lo, offsets[c]);
+        });
+    }
+    pool->wait(group);
+}
+
+template <typename Time>
+double medianNs(int runs, Time time) {
+    std::vector<double> times;
+    for (int r = 0; r < std::max(1, runs); ++r) {
+        auto start = std::chrono::steady_clock::now();
+        time();
+        auto end = std::chrono::steady_clock::now();
+        times.push_back(std::chrono::duration<double, std::nano>(end - start).count());
+    }
+    std::nth_element(times.begin(), times.begin() + times.size() / 2, times.end());
+    return times[times.size() / 2];
+}
+
+} // namespace
+
+const char* scanKindName(ScanKind kind) {
+    switch (kind) {
+        case ScanKind::Inclusive: return "inclusive";
+        case ScanKind::Exclusive: return "exclusive";
+    }
+    return "";
+}
+
+bool parseScanKind(const std::string& name, ScanKind& kind) {
+    for (int k = 0; k < SCAN_KIND_COUNT; ++k) {
+        if (name == scanKindName(static_cast<ScanKind>(k))) {
+            kind = static_cast<ScanKind>(k);
+            return true;
+        }
+    }
+    return false;
+}
+
+const char* scanMethodName(ScanMethod method) {
+    switch (method) {
+        case ScanMethod::Sequential: return "sequential";
+        case ScanMethod::Simd:       return "simd";
+        case ScanMethod::Blelloch:   return "blelloch";
+        case ScanMethod::Chunked:    return "chunked";
+    }
+    return "";
+}
+
+bool parseScanMethod(const std::string& name, ScanMethod& method) {
+    for (int k = 0; k < SCAN_METHOD_COUNT; ++k) {
+        if (name == scanMethodName(static_cast<ScanMethod>(k))) {
+            method = static_cast<ScanMethod>(k);
+            return true;
+        }
+    }
+    return false;
+}
+
+bool simdScanAvailable() {
+#ifdef __SSE2__
+    return true;
+#else
+    return false;
+#endif
+}
+
+void scan(ScanMethod method, ScanKind kind, const int* input, int* output, size_t count, ThreadPool* pool) {
+    if (count == 0) return;
+    NoObserver o;
+    switch (method) {
+        case ScanMethod::Sequential: sequentialScan(kind, input, output, count, 0, o); break;
+        case ScanMethod::Simd:       simdScan(kind, input, output, count, 0); break;
+        case ScanMethod::Blelloch:   blellochScan(kind, input, output, count, pool, o); break;
+        case ScanMethod::Chunked:    chunkedScan(kind, input, output, count, pool); break;
+    }
+}
+
+size_t scanTreeLevels(size_t count) {
+    size_t levels = 0;
+    while ((size_t(1) << levels) < count) ++levels;
+    return levels;
+}
+
+bool scanTraced(ScanMethod method, ScanKind kind, std::vector<int>& values, std::vector<ScanStep>& steps) {
+    steps.clear();
+    if (method != ScanMethod::Sequential && method != ScanMethod::Blelloch) {
+        return false;
+    }
+    if (values.empty()) return true;
+    TracingObserver o{steps, values.size()};
+    if (method == ScanMethod::Sequential) {
+        sequentialScan(kind, values.data(), values.data(), values.size(), 0, o);
+    } else {
+        blellochScan(kind, values.data(), values.data(), values.size(), nullptr, o);
+    }
+    return true;
+}
+
+double scanNs(ScanMethod method, ScanKind kind, const std::vector<int>& input, ThreadPool* pool, int runs) {
+    std::vector<int> output(input.size());
+    return medianNs(runs, [&]() { scan(method, kind, input.data(), output.data(), input.size(), pool); });
+}
+
+double memcpyNs(const std::vector<int>& input, int runs) {
+    std::vector<int> output(input.size());
+    return medianNs(runs, [&]() { std::memcpy(output.data(), input.data(), input.size() * sizeof(int)); });
+}
+
+double scanGigabytesPerSecond(size_t elements, double ns) {
+    return ns > 0.0 ? 2.0 * elements * sizeof(int) / ns : 0.0;
+}
+
+} // namespace core
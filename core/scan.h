@@ -0,0 +1,87 @@
+#pragma once
+
+// Prefix sums (scans) of an int array. Inclusive: out[i] = in[0] + .. + in[i];
+// exclusive: out[i] = in[0] + .. + in[i - 1], out[0] = 0. Sums wrap on
+// overflow, as unsigned arithmetic does.
+//
+//   sequential   one pass carrying the running sum; each add waits on the
+//                one before, but at one add per element it still keeps up
+//                with memory once the array is past the caches
+//   simd         four lanes per step: the vector is added to itself shifted
+//                by one and then two lanes (an in-register scan), then the
+//                carry from the last vector is broadcast in. SSE2; the plain
+//                loop elsewhere
+//   blelloch     the work-efficient tree scan: an up-sweep adds pairs at
+//                doubling distances into a tree of partial sums, the root is
+//                cleared, and a down-sweep pushes the prefixes back down.
+//                2n adds, each level's pairs independent, so the levels split
+//                across threads; but every level is another pass over
+//                memory at a growing stride
+//   chunked      reduce-then-scan on a pool: each thread sums its chunk, the
+//                chunk sums are scanned, then each thread scans its chunk
+//                from its offset with the simd loop. Two reads and one write
+//                per element
+//
+// A scan does one add per element it moves, so on large arrays every method
+// is bound by memory bandwidth: memcpy of the same bytes is the ceiling.
+
+#include "thread_pool.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace core {
+
+enum class ScanKind { Inclusive, Exclusive };
+constexpr int SCAN_KIND_COUNT = 2;
+
+const char* scanKindName(ScanKind kind);            // "inclusive", "exclusive"
+bool parseScanKind(const std::string& name, ScanKind& kind);
+
+enum class ScanMethod { Sequential, Simd, Blelloch, Chunked };
+constexpr int SCAN_METHOD_COUNT = 4;
+
+const char* scanMethodName(ScanMethod method);      // "blelloch" etc.
+bool parseScanMethod(const std::string& name, ScanMethod& method);
+
+// Whether the simd method (and the chunks of chunked) use vector registers
+bool simdScanAvailable();
+
+// Scans `count` values of `input` into `output`, which may be the same
+// array. `pool` splits blelloch and chunked across its threads; without one
+// they run on the caller.
+void scan(ScanMethod method, ScanKind kind, const int* input, int* output, size_t count, ThreadPool* pool = nullptr);
+
+// One step of a traced scan, with the values it left
+struct ScanStep {
+    enum Kind : uint8_t { Carry, Up, Clear, Down, AddInput };
+    Kind kind;
+    uint8_t level;          // Up and Down: tree level, 0 = neighbouring pairs
+    uint32_t left;          // Up and Down: the pair; Carry: the previous element
+    uint32_t right;         // NO_INDEX in the padding past the end
+    int leftValue;
+    int rightValue;
+
+    static constexpr uint32_t NO_INDEX = UINT32_MAX;
+};
+
+// Levels of the blelloch tree over `count` elements: ceil(log2 count)
+size_t scanTreeLevels(size_t count);
+
+// Sequential or blelloch scan of `values` in place, recording every step
+// that changes an element (blelloch pads to a power of two with zeros; the
+// padding is not shown). False for the methods with no step-by-step form.
+bool scanTraced(ScanMethod method, ScanKind kind, std::vector<int>& values, std::vector<ScanStep>& steps);
+
+// Median wall time of `runs` scans of `input` into a preallocated output
+double scanNs(ScanMethod method, ScanKind kind, const std::vector<int>& input, ThreadPool* pool, int runs);
+// The same for memcpy of the same bytes: the bandwidth ceiling
+double memcpyNs(const std::vector<int>& input, int runs);
+
+// GB/s of a pass over `elements` ints that reads and writes each once, the
+// accounting used for the scans and memcpy alike
+double scanGigabytesPerSecond(size_t elements, double ns);
+
+} // namespace core
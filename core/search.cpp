@@ -0,0 +1,190 @@
+#include "search.h"
+
+#include <algorithm>
+#include <chrono>
+#include <random>
+
+namespace core {
+
+namespace {
+
+struct NoObserver {
+    void probe(size_t, size_t, size_t) {}
+};
+
+struct CountingObserver {
+    uint64_t probes = 0;
+
+    void probe(size_t, size_t, size_t) { ++probes; }
+};
+
+struct TracingObserver {
+    std::vector<SearchProbe>& probes;
+
+    void probe(size_t lo, size_t hi, size_t index) { probes.push_back({lo, hi, index}); }
+};
+
+// Searches [lo, hi)
+template <typename Observer>
+size_t binaryRange(const int* a, size_t lo, size_t hi, int value, Observer& o) {
+    while (lo < hi) {
+        size_t mid = lo + (hi - lo) / 2;
+        o.probe(lo, hi - 1, mid);
+        if (a[mid] == value) return mid;
+        if (a[mid] < value) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    return npos;
+}
+
+template <typename Observer>
+size_t branchlessSearch(const int* a, size_t n, int value, Observer& o) {
+    if (n == 0) return npos;
+    const int* base = a;
+    size_t length = n;
+    while (length > 1) {
+        size_t half = length / 2;
+        size_t lo = static_cast<size_t>(base - a);
+        o.probe(lo, lo + length - 1, lo + half);
+        base = base[half] < value ? base + half : base;
+        length -= half;
+    }
+    size_t index = static_cast<size_t>(base - a);
+    o.probe(index, index, index);
+    if (*base < value) {
+        // The lower bound is the next element
+        if (++index == n) return npos;
+        o.probe(index, index, index);
+    }
+    return a[index] == value ? index : npos;
+}
+
+template <typename Observer>
+size_t interpolationSearch(const int* a, size_t n, int value, Observer& o) {
+    if (n == 0) return npos;
+    size_t lo = 0, hi = n - 1;
+    while (lo <= hi && value >= a[lo] && value <= a[hi]) {
+        size_t pos = lo;
+        if (a[hi] != a[lo]) {
+            double fraction = (static_cast<double>(value) - a[lo]) / (static_cast<double>(a[hi]) - a[lo]);
+            pos = lo + static_cast<size_t>(fraction * static_cast<double>(hi - lo));
+        }
+        o.probe(lo, hi, pos);
+        if (a[pos] == value) return pos;
+        if (a[pos] < value) {
+            lo = pos + 1;
+        } else {
+            if (pos == 0) break;
+            hi = pos - 1;
+        }
+    }
+    return npos;
+}
+
+template <typename Observer>
+size_t exponentialSearch(const int* a, size_t n, int value, Observer& o) {
+    if (n == 0) return npos;
+    o.probe(0, n - 1, 0);
+    if (!(a[0] < value)) return a[0] == value ? 0 : npos;
+
+    // a[bound / 2] < value throughout
+    size_t bound = 1;
+    while (bound < n) {
+        o.probe(bound / 2 + 1, n - 1, bound);
+        if (!(a[bound] < value)) break;
+        bound *= 2;
+    }
+    return binaryRange(a, bound / 2 + 1, std::min(bound + 1, n), value, o);
+}
+
+template <typename Observer>
+size_t runSearch(SortedSearch method, const int* a, size_t n, int value, Observer& o) {
+    switch (method) {
+        case SortedSearch::Binary:        return binaryRange(a, 0, n, value, o);
+        case SortedSearch::Branchless:    return branchlessSearch(a, n, value, o);
+        case SortedSearch::Interpolation: return interpolationSearch(a, n, value, o);
+        case SortedSearch::Exponential:   return exponentialSearch(a, n, value, o);
+    }
+    return npos;
+}
+
+// Keeps timed lookups from being optimized away
+volatile size_t sink = 0;
+
+} // namespace
+
+const char* sortedSearchName(SortedSearch method) {
+    switch (method) {
+        case SortedSearch::Binary:        return "binary";
+        case SortedSearch::Branchless:    return "branchless";
+        case SortedSearch::Interpolation: return "interpolation";
+        case SortedSearch::Exponential:   return "exponential";
+    }
+    return "";
+}
+
+bool parseSortedSearch(const std::string& name, SortedSearch& method) {
+    for (int k = 0; k < SORTED_SEARCH_COUNT; ++k) {
+        if (name == sortedSearchName(static_cast<SortedSearch>(k))) {
+            method = static_cast<SortedSearch>(k);
+            return true;
+        }
+    }
+    return false;
+}
+
+size_t sortedSearch(SortedSearch method, const int* values, size_t count, int value) {
+    NoObserver o;
+    return runSearch(method, values, count, value, o);
+}
+
+size_t sortedSearchTraced(SortedSearch method, const std::vector<int>& values, int value,
+                          std::vector<SearchProbe>& probes) {
+    probes.clear();
+    TracingObserver o{probes};
+    return runSearch(method, values.data(), values.size(), value, o);
+}
+
+std::vector<int> searchQueries(const std::vector<int>& values, size_t count, uint64_t seed) {
+    std::vector<int> queries;
+    if (values.empty()) return queries;
+    std::mt19937_64 rng(seed);
+    std::uniform_int_distribution<size_t> index(0, values.size() - 1);
+    std::uniform_int_distribution<int> any(values.front(), values.back());
+    queries.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        queries.push_back(i % 2 == 0 ? values[index(rng)] : any(rng));
+    }
+    return queries;
+}
+
+SearchTiming timeSortedSearch(SortedSearch method, const std::vector<int>& values, const std::vector<int>& queries) {
+    SearchTiming timing;
+    if (queries.empty()) return timing;
+
+    CountingObserver counter;
+    for (int query : queries) {
+        runSearch(method, values.data(), values.size(), query, counter);
+    }
+    timing.probesPerLookup = static_cast<double>(counter.probes) / queries.size();
+
+    double best = 0.0;
+    for (int pass = 0; pass < 3; ++pass) {
+        size_t found = 0;
+        auto start = std::chrono::steady_clock::now();
+        for (int query : queries) {
+            found += sortedSearch(method, values.data(), values.size(), query);
+        }
+        auto end = std::chrono::steady_clock::now();
+        sink = sink + found;
+        double ns = std::chrono::duration<double, std::nano>(end - start).count();
+        best = pass == 0 ? ns : std::min(best, ns);
+    }
+    timing.nsPerLookup = best / queries.size();
+    return timing;
+}
+
+} // namespace core
@@ -0,0 +1,61 @@
+#pragma once
+
+// Searches over a sorted integer array, written once against an observer that
+// sees every probe (one read of an element the search picked), so the native
+// timing, the probe counts and the visualizer's animation run the same code.
+//
+//   binary         the textbook loop: an equality test and a branch on the
+//                  comparison per probe, the branch taken about half the
+//                  time at random, so it mispredicts often
+//   branchless     a lower bound whose window update is a conditional move:
+//                  always ceil(log2 n) + 1 probes, no branch to mispredict,
+//                  and the probe addresses don't wait on each other's branch
+//   interpolation  guesses the position from the value: about log log n
+//                  probes on evenly spread values, up to n on skewed ones
+//   exponential    doubles a bound from the front, then binary searches the
+//                  last stride: 2 log2 of the answer's index, so hits near
+//                  the start are cheap
+//
+// At large n every variant is bound by cache misses on the first probes; the
+// differences come from how many probes there are and whether the CPU can
+// start the next one before the previous comparison resolves.
+
+#include "structures.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace core {
+
+enum class SortedSearch { Binary, Branchless, Interpolation, Exponential };
+constexpr int SORTED_SEARCH_COUNT = 4;
+
+const char* sortedSearchName(SortedSearch method);          // "branchless" etc.
+bool parseSortedSearch(const std::string& name, SortedSearch& method);
+
+// The window [lo, hi] still in play when `probe` was read
+struct SearchProbe {
+    size_t lo;
+    size_t hi;
+    size_t probe;
+};
+
+// Index of an element equal to `value`, or npos. `values` must be sorted.
+size_t sortedSearch(SortedSearch method, const int* values, size_t count, int value);
+size_t sortedSearchTraced(SortedSearch method, const std::vector<int>& values, int value,
+                          std::vector<SearchProbe>& probes);
+
+// Lookups for timing: half are values present in `values`, half uniform over
+// [min, max] (mostly misses on sparse arrays)
+std::vector<int> searchQueries(const std::vector<int>& values, size_t count, uint64_t seed);
+
+struct SearchTiming {
+    double nsPerLookup = 0.0;       // Best of a few passes over the queries
+    double probesPerLookup = 0.0;
+};
+
+SearchTiming timeSortedSearch(SortedSearch method, const std::vector<int>& values, const std::vector<int>& queries);
+
+} // namespace core
@@ -0,0 +1,170 @@
+#include "snapshot.h"
+
+#include <cstdio>
+#include <cstring>
+
+namespace core {
+
+namespace {
+
+const char MAGIC[4] = {'D', 'S', 'V', 'S'};
+const size_t HEADER_SIZE = 16;
+
+// Index + 1 is the structure byte; never reorder
+const char* const STRUCTURES[] = {"array", "string", "linked-list", "stack", "queue", "binary-tree"};
+const size_t STRUCTURE_COUNT = sizeof(STRUCTURES) / sizeof(STRUCTURES[0]);
+
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+const bool LITTLE_ENDIAN_HOST = false;
+#else
+const bool LITTLE_ENDIAN_HOST = true;
+#endif
+
+uint32_t swapBytes(uint32_t v) {
+    return (v >> 24) | ((v >> 8) & 0xFF00u) | ((v << 8) & 0xFF0000u) | (v << 24);
+}
+
+int structureCode(const std::string& structure) {
+    for (size_t i = 0; i < STRUCTURE_COUNT; ++i) {
+        if (structure == STRUCTURES[i]) return static_cast<int>(i) + 1;
+    }
+    return 0;
+}
+
+void putLittleEndian(unsigned char* out, uint64_t value, size_t bytes) {
+    for (size_t i = 0; i < bytes; ++i) {
+        out[i] = static_cast<unsigned char>(value >> (8 * i));
+    }
+}
+
+uint64_t getLittleEndian(const unsigned char* in, size_t bytes) {
+    uint64_t value = 0;
+    for (size_t i = 0; i < bytes; ++i) {
+        value |= static_cast<uint64_t>(in[i]) << (8 * i);
+    }
+    return value;
+}
+
+bool write(const std::string& path, int code, size_t elementSize, const void* data, size_t count,
+           std::string& error) {
+    unsigned char header[HEADER_SIZE];
+    std::memcpy(header, MAGIC, 4);
+    putLittleEndian(header + 4, SNAPSHOT_VERSION, 2);
+    header[6] = static_cast<unsigned char>(code);
+    header[7] = static_cast<unsigned char>(elementSize);
+    putLittleEndian(header + 8, count, 8);
+
+    // Written beside the target and renamed over it once complete, so a crash
+    // or a full disk part way through leaves the previous snapshot intact
+    std::string partial = path + ".tmp";
+    FILE* out = std::fopen(partial.c_str(), "wb");
+    if (out == nullptr) {
+        error = "cannot write " + partial;
+        return false;
+    }
+    // The header goes through stdio's buffer, the elements straight from memory
+    bool ok = std::fwrite(header, 1, HEADER_SIZE, out) == HEADER_SIZE;
+    if (ok && count > 0) {
+        if (LITTLE_ENDIAN_HOST || elementSize == 1) {
+            ok = std::fwrite(data, elementSize, count, out) == count;
+        } else {
+            const int* values = static_cast<const int*>(data);
+            for (size_t i = 0; ok && i < count; ++i) {
+                uint32_t v = swapBytes(static_cast<uint32_t>(values[i]));
+                ok = std::fwrite(&v, 4, 1, out) == 1;
+            }
+        }
+    }
+    ok = std::fflush(out) == 0 && ok;
+    ok = std::fclose(out) == 0 && ok;
+    if (!ok) {
+        error = "error writing " + partial;
+        std::remove(partial.c_str());
+        return false;
+    }
+    if (std::rename(partial.c_str(), path.c_str()) != 0) {
+        // Windows will not rename over an existing file
+        std::remove(path.c_str());
+        if (std::rename(partial.c_str(), path.c_str()) != 0) {
+            error = "cannot replace " + path;
+            std::remove(partial.c_str());
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+bool saveSnapshot(const std::string& path, const std::string& structure,
+                  const std::vector<int>& values, std::string& error) {
+    int code = structureCode(structure);
+    if (code == 0 || structure == "string") {
+        error = "not an integer structure: " + structure;
+        return false;
+    }
+    return write(path, code, 4, values.data(), values.size(), error);
+}
+
+bool saveSnapshot(const std::string& path, const std::string& text, std::string& error) {
+    return write(path, structureCode("string"), 1, text.data(), text.size(), error);
+}
+
+bool SnapshotReader::open(const std::string& path, std::string& error) {
+    kind.clear();
+    elements = 0;
+    swapped.clear();
+    if (!file.open(path, error)) {
+        return false;
+    }
+
+    const unsigned char* header = reinterpret_cast<const unsigned char*>(file.data());
+    if (file.size() < HEADER_SIZE || std::memcmp(header, MAGIC, 4) != 0) {
+        error = path + " is not a snapshot";
+        file.close();
+        return false;
+    }
+    uint64_t version = getLittleEndian(header + 4, 2);
+    if (version != SNAPSHOT_VERSION) {
+        error = path + " has snapshot version " + std::to_string(version) +
+                ", expected " + std::to_string(SNAPSHOT_VERSION);
+        file.close();
+        return false;
+    }
+    size_t code = header[6];
+    size_t elementSize = header[7];
+    uint64_t count = getLittleEndian(header + 8, 8);
+    bool isString = code == static_cast<size_t>(structureCode("string"));
+    if (code == 0 || code > STRUCTURE_COUNT || elementSize != (isString ? 1u : 4u) ||
+        count > (file.size() - HEADER_SIZE) / elementSize ||
+        file.size() != HEADER_SIZE + count * elementSize) {
+        error = path + " is damaged (bad structure or length)";
+        file.close();
+        return false;
+    }
+
+    kind = STRUCTURES[code - 1];
+    elements = static_cast<size_t>(count);
+    if (!LITTLE_ENDIAN_HOST && !isString) {
+        swapped.resize(elements);
+        const uint32_t* raw = reinterpret_cast<const uint32_t*>(file.data() + HEADER_SIZE);
+        for (size_t i = 0; i < elements; ++i) {
+            swapped[i] = static_cast<int>(swapBytes(raw[i]));
+        }
+    }
+    return true;
+}
+
+const int* SnapshotReader::values() const {
+    if (!swapped.empty()) {
+        return swapped.data();
+    }
+    // The mapping is page aligned, so the elements after the 16-byte header are too
+    return reinterpret_cast<const int*>(file.data() + HEADER_SIZE);
+}
+
+const char* SnapshotReader::text() const {
+    return file.data() + HEADER_SIZE;
+}
+
+} // namespace core
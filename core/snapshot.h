@@ -0,0 +1,53 @@
+#pragma once
+
+// Versioned binary snapshots of a structure's contents, so visualizer state
+// survives between sessions and batch runs can start where another stopped.
+//
+//   offset  size  field
+//   0       4     magic "DSVS"
+//   4       2     format version
+//   6       1     structure (see snapshotStructures())
+//   7       1     element size: 4 for integers, 1 for the string's characters
+//   8       8     element count
+//   16      ...   elements, little-endian
+//
+// Integer structures are stored front to back (the stack bottom to top); the
+// BST as its preorder, which rebuilds the same shape. A snapshot is written
+// with one buffered write and read through a memory mapping: the elements are
+// used in place, without a parsing pass.
+
+#include "import.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace core {
+
+const uint16_t SNAPSHOT_VERSION = 1;
+
+// Structure names are the batch mode ones ("array", ..., "binary-tree")
+bool saveSnapshot(const std::string& path, const std::string& structure,
+                  const std::vector<int>& values, std::string& error);
+bool saveSnapshot(const std::string& path, const std::string& text, std::string& error);  // "string"
+
+class SnapshotReader {
+public:
+    // Returns false and fills `error` on a missing, truncated or foreign file
+    bool open(const std::string& path, std::string& error);
+
+    const std::string& structure() const { return kind; }
+    size_t count() const { return elements; }
+
+    // Elements in place in the mapping; valid while the reader lives
+    const int* values() const;
+    const char* text() const;
+
+private:
+    MappedFile file;
+    std::string kind;
+    size_t elements = 0;
+    std::vector<int> swapped;   // Big-endian hosts only
+};
+
+} // namespace core
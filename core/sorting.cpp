@@ -0,0 +1,472 @@
+#include "sorting.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+
+namespace core {
+
+namespace {
+
+// Second index of a comparison against a value held outside the array
+const size_t HELD = static_cast<size_t>(-1);
+
+struct NoObserver {
+    void compare(size_t, size_t) {}
+    void swap(size_t, size_t) {}
+    void write(size_t, int) {}
+    void auxiliary(size_t) {}
+};
+
+struct CountingObserver {
+    SortStats stats;
+
+    void compare(size_t, size_t) { ++stats.comparisons; }
+    void swap(size_t, size_t) { ++stats.swaps; }
+    void write(size_t, int) { ++stats.writes; }
+    void auxiliary(size_t bytes) { stats.auxiliaryBytes = std::max(stats.auxiliaryBytes, bytes); }
+};
+
+struct TracingObserver : CountingObserver {
+    std::vector<SortStep>& steps;
+    bool truncated = false;
+
+    explicit TracingObserver(std::vector<SortStep>& out) : steps(out) {}
+
+    void record(SortStep::Kind kind, size_t i, size_t j, int value) {
+        if (steps.size() == MAX_SORT_TRACE_STEPS) {
+            truncated = true;
+            return;
+        }
+        steps.push_back({kind, static_cast<uint32_t>(i),
+                         j == HELD ? SortStep::NO_INDEX : static_cast<uint32_t>(j), value});
+    }
+
+    void compare(size_t i, size_t j) {
+        CountingObserver::compare(i, j);
+        record(SortStep::Compare, i, j, 0);
+    }
+    void swap(size_t i, size_t j) {
+        CountingObserver::swap(i, j);
+        record(SortStep::Swap, i, j, 0);
+    }
+    void write(size_t i, int value) {
+        CountingObserver::write(i, value);
+        record(SortStep::Write, i, HELD, value);
+    }
+};
+
+template <typename Observer>
+void exchange(int* a, size_t i, size_t j, Observer& o) {
+    o.swap(i, j);
+    std::swap(a[i], a[j]);
+}
+
+template <typename Observer>
+void store(int* a, size_t i, int value, Observer& o) {
+    o.write(i, value);
+    a[i] = value;
+}
+
+template <typename Observer>
+void insertionSort(int* a, size_t n, Observer& o) {
+    for (size_t i = 1; i < n; ++i) {
+        int key = a[i];
+        size_t j = i;
+        // j is the hole key will drop into
+        while (j > 0) {
+            o.compare(j - 1, j);
+            if (!(key < a[j - 1])) break;
+            store(a, j, a[j - 1], o);
+            --j;
+        }
+        if (j != i) store(a, j, key, o);
+    }
+}
+
+template <typename Observer>
+void selectionSort(int* a, size_t n, Observer& o) {
+    for (size_t i = 0; i + 1 < n; ++i) {
+        size_t smallest = i;
+        for (size_t j = i + 1; j < n; ++j) {
+            o.compare(j, smallest);
+            if (a[j] < a[smallest]) smallest = j;
+        }
+        if (smallest != i) exchange(a, i, smallest, o);
+    }
+}
+
+template <typename Observer>
+void bubbleSort(int* a, size_t n, Observer& o) {
+    // Everything from the last swap on is in place
+    size_t end = n;
+    while (end > 1) {
+        size_t lastSwap = 0;
+        for (size_t j = 1; j < end; ++j) {
+            o.compare(j - 1, j);
+            if (a[j] < a[j - 1]) {
+                exchange(a, j - 1, j, o);
+                lastSwap = j;
+            }
+        }
+        end = lastSwap;
+    }
+}
+
+template <typename Observer>
+void mergeSort(int* a, size_t n, Observer& o) {
+    if (n < 2) return;
+    std::vector<int> buffer(n);
+    o.auxiliary(n * sizeof(int));
+
+    for (size_t width = 1; width < n; width *= 2) {
+        for (size_t lo = 0; lo + width < n; lo += 2 * width) {
+            size_t mid = lo + width;
+            size_t hi = std::min(lo + 2 * width, n);
+            // Runs already in order need no merge
+            o.compare(mid - 1, mid);
+            if (!(a[mid] < a[mid - 1])) continue;
+
+            // The left run moves to the buffer and merges back with the right one
+            std::copy(a + lo, a + mid, buffer.data());
+            size_t i = 0, left = mid - lo, j = mid, k = lo;
+            while (i < left && j < hi) {
+                o.compare(lo + i, j);
+                if (a[j] < buffer[i]) {
+                    store(a, k++, a[j++], o);
+                } else {
+                    store(a, k++, buffer[i++], o);
+                }
+            }
+            while (i < left) {
+                store(a, k++, buffer[i++], o);
+            }
+        }
+    }
+}
+
+// Pending subranges of the quick sorts. Each push is the larger side and the
+// loop goes on with the smaller, so the depth stays below log2(n).
+struct Range {
+    size_t lo, hi;
+};
+const size_t MAX_RANGES = 64;
+
+template <typename Observer, typename Partition>
+void quickSort(int* a, size_t n, Observer& o, Partition partition) {
+    Range pending[MAX_RANGES];
+    size_t depth = 0;
+    size_t lo = 0, hi = n;
+    for (;;) {
+        if (hi - lo < 2) {
+            if (depth == 0) return;
+            --depth;
+            lo = pending[depth].lo;
+            hi = pending[depth].hi;
+            continue;
+        }
+        // [lo, leftEnd) and [rightStart, hi) remain
+        size_t leftEnd, rightStart;
+        partition(a, lo, hi, o, leftEnd, rightStart);
+        if (leftEnd - lo < hi - rightStart) {
+            pending[depth++] = {rightStart, hi};
+            hi = leftEnd;
+        } else {
+            pending[depth++] = {lo, leftEnd};
+            lo = rightStart;
+        }
+        o.auxiliary(depth * sizeof(Range));
+    }
+}
+
+struct LomutoPartition {
+    template <typename Observer>
+    void operator()(int* a, size_t lo, size_t hi, Observer& o, size_t& leftEnd, size_t& rightStart) const {
+        size_t last = hi - 1;
+        size_t mid = lo + (hi - lo) / 2;
+        if (mid != last) exchange(a, mid, last, o);
+        size_t boundary = lo;
+        for (size_t j = lo; j < last; ++j) {
+            o.compare(j, last);
+            if (a[j] < a[last]) {
+                if (j != boundary) exchange(a, boundary, j, o);
+                ++boundary;
+            }
+        }
+        if (boundary != last) exchange(a, boundary, last, o);
+        leftEnd = boundary;
+        rightStart = boundary + 1;
+    }
+};
+
+struct HoarePartition {
+    template <typename Observer>
+    void operator()(int* a, size_t lo, size_t hi, Observer& o, size_t& leftEnd, size_t& rightStart) const {
+        // Rounding down keeps the pivot off the last slot, so both sides are non-empty
+        int pivot = a[lo + (hi - 1 - lo) / 2];
+        size_t i = lo, j = hi - 1;
+        for (;;) {
+            for (;; ++i) {
+                o.compare(i, HELD);
+                if (!(a[i] < pivot)) break;
+            }
+            for (;; --j) {
+                o.compare(j, HELD);
+                if (!(pivot < a[j])) break;
+            }
+            if (i >= j) break;
+            exchange(a, i, j, o);
+            ++i;
+            --j;
+        }
+        leftEnd = j + 1;
+        rightStart = j + 1;
+    }
+};
+
+template <typename Observer>
+void heapSort(int* a, size_t n, Observer& o) {
+    auto siftDown = [&](size_t root, size_t end) {
+        for (;;) {
+            size_t child = 2 * root + 1;
+            if (child >= end) return;
+            if (child + 1 < end) {
+                o.compare(child, child + 1);
+                if (a[child] < a[child + 1]) ++child;
+            }
+            o.compare(root, child);
+            if (!(a[root] < a[child])) return;
+            exchange(a, root, child, o);
+            root = child;
+        }
+    };
+    for (size_t i = n / 2; i-- > 0;) {
+        siftDown(i, n);
+    }
+    for (size_t end = n; end-- > 1;) {
+        exchange(a, 0, end, o);
+        siftDown(0, end);
+    }
+}
+
+template <typename Observer>
+void shellSort(int* a, size_t n, Observer& o) {
+    std::vector<size_t> gaps = {1, 4, 10, 23, 57, 132, 301, 701};
+    while (gaps.back() * 9 / 4 < n) {
+        gaps.push_back(gaps.back() * 9 / 4);
+    }
+    for (size_t g = gaps.size(); g-- > 0;) {
+        size_t gap = gaps[g];
+        if (gap >= n) continue;
+        // Insertion sort over every gap-th element
+        for (size_t i = gap; i < n; ++i) {
+            int key = a[i];
+            size_t j = i;
+            while (j >= gap) {
+                o.compare(j - gap, j);
+                if (!(key < a[j - gap])) break;
+                store(a, j, a[j - gap], o);
+                j -= gap;
+            }
+            if (j != i) store(a, j, key, o);
+        }
+    }
+}
+
+inline size_t radixDigit(int value, int shift) {
+    // Flipping the sign bit orders negative values before positive ones
+    return ((static_cast<uint32_t>(value) ^ 0x80000000u) >> shift) & 0xFF;
+}
+
+template <typename Observer>
+void radixSort(int* a, size_t n, Observer& o) {
+    if (n < 2) return;
+    std::vector<int> buffer(n);
+    size_t counts[256];
+    o.auxiliary(n * sizeof(int) + sizeof(counts));
+
+    for (int shift = 0; shift < 32; shift += 8) {
+        std::fill(counts, counts + 256, 0);
+        for (size_t i = 0; i < n; ++i) {
+            ++counts[radixDigit(a[i], shift)];
+        }
+        if (counts[radixDigit(a[0], shift)] == n) continue;   // Every key has this digit
+
+        size_t offset = 0;
+        for (size_t d = 0; d < 256; ++d) {
+            size_t count = counts[d];
+            counts[d] = offset;
+            offset += count;
+        }
+        for (size_t i = 0; i < n; ++i) {
+            buffer[counts[radixDigit(a[i], shift)]++] = a[i];
+        }
+        for (size_t i = 0; i < n; ++i) {
+            store(a, i, buffer[i], o);
+        }
+    }
+}
+
+template <typename Observer>
+void countingSort(int* a, size_t n, Observer& o) {
+    if (n < 2) return;
+    auto bounds = std::minmax_element(a, a + n);
+    int64_t low = *bounds.first;
+    size_t range = static_cast<size_t>(int64_t(*bounds.second) - low + 1);
+    std::vector<uint32_t> counts(range, 0);
+    o.auxiliary(range * sizeof(uint32_t));
+
+    for (size_t i = 0; i < n; ++i) {
+        ++counts[static_cast<size_t>(a[i] - low)];
+    }
+    size_t k = 0;
+    for (size_t d = 0; d < range; ++d) {
+        int value = static_cast<int>(low + static_cast<int64_t>(d));
+        for (uint32_t c = counts[d]; c > 0; --c) {
+            store(a, k++, value, o);
+        }
+    }
+}
+
+template <typename Observer>
+void runSort(SortAlgorithm algorithm, std::vector<int>& values, Observer& o) {
+    int* a = values.data();
+    size_t n = values.size();
+    switch (algorithm) {
+        case SortAlgorithm::Insertion:   insertionSort(a, n, o); break;
+        case SortAlgorithm::Selection:   selectionSort(a, n, o); break;
+        case SortAlgorithm::Bubble:      bubbleSort(a, n, o); break;
+        case SortAlgorithm::Merge:       mergeSort(a, n, o); break;
+        case SortAlgorithm::QuickLomuto: quickSort(a, n, o, LomutoPartition()); break;
+        case SortAlgorithm::QuickHoare:  quickSort(a, n, o, HoarePartition()); break;
+        case SortAlgorithm::Heap:        heapSort(a, n, o); break;
+        case SortAlgorithm::Shell:       shellSort(a, n, o); break;
+        case SortAlgorithm::Radix:       radixSort(a, n, o); break;
+        case SortAlgorithm::Counting:    countingSort(a, n, o); break;
+    }
+}
+
+template <typename Sort>
+double medianNs(const std::vector<int>& input, int runs, Sort sort) {
+    std::vector<double> times;
+    std::vector<int> scratch;
+    for (int r = 0; r < std::max(1, runs); ++r) {
+        scratch = input;
+        auto start = std::chrono::steady_clock::now();
+        sort(scratch);
+        auto end = std::chrono::steady_clock::now();
+        times.push_back(std::chrono::duration<double, std::nano>(end - start).count());
+    }
+    std::nth_element(times.begin(), times.begin() + times.size() / 2, times.end());
+    return times[times.size() / 2];
+}
+
+} // namespace
+
+const char* sortAlgorithmName(SortAlgorithm algorithm) {
+    switch (algorithm) {
+        case SortAlgorithm::Insertion:   return "insertion";
+        case SortAlgorithm::Selection:   return "selection";
+        case SortAlgorithm::Bubble:      return "bubble";
+        case SortAlgorithm::Merge:       return "merge";
+        case SortAlgorithm::QuickLomuto: return "quick-lomuto";
+        case SortAlgorithm::QuickHoare:  return "quick-hoare";
+        case SortAlgorithm::Heap:        return "heap";
+        case SortAlgorithm::Shell:       return "shell";
+        case SortAlgorithm::Radix:       return "radix";
+        case SortAlgorithm::Counting:    return "counting";
+    }
+    return "";
+}
+
+bool parseSortAlgorithm(const std::string& name, SortAlgorithm& algorithm) {
+    for (int k = 0; k < SORT_ALGORITHM_COUNT; ++k) {
+        if (name == sortAlgorithmName(static_cast<SortAlgorithm>(k))) {
+            algorithm = static_cast<SortAlgorithm>(k);
+            return true;
+        }
+    }
+    return false;
+}
+
+bool checkSortable(SortAlgorithm algorithm, const std::vector<int>& values, std::string& error) {
+    double n = static_cast<double>(values.size());
+    double worst = n * (n - 1) / 2;
+    double estimate = 0;
+
+    switch (algorithm) {
+        case SortAlgorithm::Insertion:
+        case SortAlgorithm::Selection:
+        case SortAlgorithm::Bubble:
+            estimate = worst;
+            break;
+        case SortAlgorithm::QuickLomuto:
+            // Values equal to the pivot all land on one side, so a run of m
+            // equal values costs about m^2 / 2 comparisons
+            if (worst > SORT_COMPARISON_BUDGET) {
+                std::vector<int> sorted(values);
+                std::sort(sorted.begin(), sorted.end());
+                estimate = n * std::log2(n);
+                for (size_t i = 0, j; i < sorted.size(); i = j) {
+                    for (j = i + 1; j < sorted.size() && sorted[j] == sorted[i]; ++j) {
+                    }
+                    double run = static_cast<double>(j - i);
+                    estimate += run * (run - 1) / 2;
+                }
+            }
+            break;
+        case SortAlgorithm::Counting:
+            if (!values.empty()) {
+                auto bounds = std::minmax_element(values.begin(), values.end());
+                uint64_t range = static_cast<uint64_t>(int64_t(*bounds.second) - *bounds.first + 1);
+                if (range > COUNTING_SORT_MAX_RANGE) {
+                    error = "counting sort needs one counter per value: range " + std::to_string(range) +
+                            " is over the limit of " + std::to_string(COUNTING_SORT_MAX_RANGE);
+                    return false;
+                }
+            }
+            break;
+        default:
+            break;
+    }
+
+    if (estimate > SORT_COMPARISON_BUDGET) {
+        char text[160];
+        std::snprintf(text, sizeof(text), "%s sort would make about %.2g comparisons on %zu values (limit %.2g)",
+                      sortAlgorithmName(algorithm), estimate, values.size(), SORT_COMPARISON_BUDGET);
+        error = text;
+        return false;
+    }
+    return true;
+}
+
+void sortNative(SortAlgorithm algorithm, std::vector<int>& values) {
+    NoObserver o;
+    runSort(algorithm, values, o);
+}
+
+SortStats sortCounted(SortAlgorithm algorithm, std::vector<int>& values) {
+    CountingObserver o;
+    runSort(algorithm, values, o);
+    return o.stats;
+}
+
+bool sortTraced(SortAlgorithm algorithm, std::vector<int>& values, SortStats& stats,
+                std::vector<SortStep>& steps) {
+    steps.clear();
+    TracingObserver o(steps);
+    runSort(algorithm, values, o);
+    stats = o.stats;
+    return !o.truncated;
+}
+
+double nativeSortNs(SortAlgorithm algorithm, const std::vector<int>& input, int runs) {
+    return medianNs(input, runs, [algorithm](std::vector<int>& values) { sortNative(algorithm, values); });
+}
+
+double stdSortNs(const std::vector<int>& input, int runs) {
+    return medianNs(input, runs, [](std::vector<int>& values) { std::sort(values.begin(), values.end()); });
+}
+
+} // namespace core
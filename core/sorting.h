@@ -0,0 +1,85 @@
+#pragma once
+
+// Sorting algorithms over an integer array, each written once against an
+// observer that sees every comparison, swap and element write. Three
+// observers instantiate them:
+//
+//   sortNative   none: the plain algorithm, for wall-clock timing
+//   sortCounted  counts comparisons, swaps, writes and peak auxiliary memory
+//   sortTraced   also records every step, for the visualizer to replay
+//
+// so the counts and the timing always come from the same code.
+//
+//   insertion       writes each element into the hole it shifts open
+//   selection       one swap per position
+//   bubble          stops after a pass without swaps
+//   merge           bottom-up; one n-element buffer
+//   quick-lomuto    middle element as pivot, swapped to the end; the
+//                   explicit stack takes the larger side, so it stays
+//                   O(log n) deep. Quadratic on many repeated values
+//   quick-hoare     middle value as pivot, scans from both ends
+//   heap            in-place max-heap
+//   shell           Ciura's gap sequence, extended by 2.25x
+//   radix           LSD, four 8-bit digits (sign bit flipped), skipping
+//                   digits every key shares; n-element buffer
+//   counting        one counter per value in [min, max]
+//
+// Only stores into the array count as writes; a swap is not also two writes.
+// Merge and radix compare or copy through their buffer, which shows up as
+// auxiliary memory.
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace core {
+
+enum class SortAlgorithm { Insertion, Selection, Bubble, Merge, QuickLomuto, QuickHoare, Heap, Shell, Radix, Counting };
+constexpr int SORT_ALGORITHM_COUNT = 10;
+
+const char* sortAlgorithmName(SortAlgorithm algorithm);          // "quick-lomuto" etc.
+bool parseSortAlgorithm(const std::string& name, SortAlgorithm& algorithm);
+
+// Largest max - min + 1 counting sort accepts
+const uint64_t COUNTING_SORT_MAX_RANGE = uint64_t(1) << 24;
+// Comparisons checkSortable() lets one run make
+const double SORT_COMPARISON_BUDGET = 4e8;
+
+// Refuses inputs that would stall the caller: a quadratic sort (or Lomuto on
+// heavily repeated values) past SORT_COMPARISON_BUDGET, or a counting sort
+// over too wide a range. Fills `error` with the reason.
+bool checkSortable(SortAlgorithm algorithm, const std::vector<int>& values, std::string& error);
+
+struct SortStats {
+    uint64_t comparisons = 0;
+    uint64_t swaps = 0;
+    uint64_t writes = 0;
+    size_t auxiliaryBytes = 0;      // Peak extra memory beyond O(1) temporaries
+};
+
+struct SortStep {
+    enum Kind : uint8_t { Compare, Swap, Write };
+    Kind kind;
+    uint32_t i;
+    uint32_t j;                     // Compare and Swap; NO_INDEX when comparing with a held value
+    int value;                      // Write
+
+    static constexpr uint32_t NO_INDEX = UINT32_MAX;
+};
+
+// Traces stop recording past this many steps (the sort still finishes)
+const size_t MAX_SORT_TRACE_STEPS = size_t(1) << 22;
+
+void sortNative(SortAlgorithm algorithm, std::vector<int>& values);
+SortStats sortCounted(SortAlgorithm algorithm, std::vector<int>& values);
+// `steps` is replaced; returns false if the trace hit MAX_SORT_TRACE_STEPS
+bool sortTraced(SortAlgorithm algorithm, std::vector<int>& values, SortStats& stats,
+                std::vector<SortStep>& steps);
+
+// Median wall time of `runs` sortNative calls on copies of `input`, copying
+// excluded. nativeSortNs with std::sort as the reference point.
+double nativeSortNs(SortAlgorithm algorithm, const std::vector<int>& input, int runs);
+double stdSortNs(const std::vector<int>& input, int runs);
+
+} // namespace core
@@ -0,0 +1,250 @@
+#include "stream.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <random>
+
+#ifndef _WIN32
+#include <cerrno>
+#include <fcntl.h>
+#include <poll.h>
+#include <unistd.h>
+#endif
+
+namespace core {
+
+namespace {
+
+// Longest single sleep, so stop() is noticed promptly even at low rates
+const uint64_t MAX_SLEEP_NS = 20000000;
+const uint64_t FULL_RETRY_NS = 200000;
+
+void sleepNs(uint64_t ns) {
+    std::this_thread::sleep_for(std::chrono::nanoseconds(std::min(ns, MAX_SLEEP_NS)));
+}
+
+// Integers split across read() chunks, in the format the header describes
+class NumberScanner {
+public:
+    explicit NumberScanner(std::atomic<uint64_t>& outOfRange) : rejected(outOfRange) {}
+
+    // Calls emit(value) for each complete number; stops early if it returns false
+    template <typename Emit>
+    bool feed(const char* data, size_t size, Emit emit) {
+        for (size_t i = 0; i < size; ++i) {
+            char c = data[i];
+            if (comment) {
+                comment = c != '\n';
+                continue;
+            }
+            if (c >= '0' && c <= '9') {
+                value = std::min<int64_t>(value * 10 + (c - '0'), INT64_C(1) << 32);
+                digits = true;
+                continue;
+            }
+            if (!finish(emit)) return false;
+            if (c == '-') {
+                negative = true;
+            } else if (c == '#') {
+                comment = true;
+            }
+        }
+        return true;
+    }
+
+    // The number the source ended on, if any
+    template <typename Emit>
+    bool flush(Emit emit) { return finish(emit); }
+
+private:
+    template <typename Emit>
+    bool finish(Emit emit) {
+        bool keep = true;
+        if (digits) {
+            int64_t v = negative ? -value : value;
+            // Skipped rather than clamped, so no value arrives that an import
+            // of the same text would have refused
+            if (v < INT32_MIN || v > INT32_MAX) {
+                rejected.fetch_add(1, std::memory_order_relaxed);
+            } else {
+                keep = emit(static_cast<int>(v));
+            }
+        }
+        value = 0;
+        digits = false;
+        negative = false;
+        return keep;
+    }
+
+    std::atomic<uint64_t>& rejected;
+    int64_t value = 0;     // Saturates past the 32-bit range
+    bool digits = false;
+    bool negative = false;
+    bool comment = false;
+};
+
+} // namespace
+
+uint64_t streamClockNs() {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+StreamBuffer::StreamBuffer(size_t capacity) {
+    size_t size = 1;
+    while (size < capacity) size <<= 1;
+    slots.resize(size);
+    mask = size - 1;
+}
+
+bool StreamBuffer::push(const StreamItem& item) {
+    size_t t = tail.load(std::memory_order_relaxed);
+    if (t - head.load(std::memory_order_acquire) == slots.size()) {
+        return false;
+    }
+    slots[t & mask] = item;
+    tail.store(t + 1, std::memory_order_release);
+    return true;
+}
+
+bool StreamBuffer::pop(StreamItem& item) {
+    size_t h = head.load(std::memory_order_relaxed);
+    if (h == tail.load(std::memory_order_acquire)) {
+        return false;
+    }
+    item = slots[h & mask];
+    head.store(h + 1, std::memory_order_release);
+    return true;
+}
+
+size_t StreamBuffer::size() const {
+    size_t h = head.load(std::memory_order_acquire);
+    return tail.load(std::memory_order_acquire) - h;
+}
+
+StreamProducer::StreamProducer(const StreamConfig& streamConfig)
+    : config(streamConfig), buffer(std::max<size_t>(1, streamConfig.capacity)) {}
+
+StreamProducer::~StreamProducer() {
+    stop();
+}
+
+void StreamProducer::start() {
+    if (thread.joinable()) return;
+    stopping.store(false);
+    done.store(false);
+    thread = std::thread([this]() { run(); });
+}
+
+void StreamProducer::stop() {
+    stopping.store(true);
+    if (thread.joinable()) {
+        thread.join();
+    }
+}
+
+StreamStats StreamProducer::stats() const {
+    StreamStats s;
+    s.arrived = arrived.load(std::memory_order_relaxed);
+    s.dropped = dropped.load(std::memory_order_relaxed);
+    s.stalls = stalls.load(std::memory_order_relaxed);
+    s.blockedNs = blockedNs.load(std::memory_order_relaxed);
+    s.rejected = rejected.load(std::memory_order_relaxed);
+    return s;
+}
+
+bool StreamProducer::deliver(int value) {
+    if (config.rate > 0) {
+        uint64_t interval = static_cast<uint64_t>(1e9 / config.rate);
+        uint64_t now = streamClockNs();
+        if (nextDueNs == 0) nextDueNs = now;
+        while (now < nextDueNs) {
+            if (stopping.load(std::memory_order_relaxed)) return false;
+            sleepNs(nextDueNs - now);
+            now = streamClockNs();
+        }
+        nextDueNs += interval;
+    }
+
+    StreamItem item{value, streamClockNs()};
+    arrived.fetch_add(1, std::memory_order_relaxed);
+    if (buffer.push(item)) return true;
+
+    if (config.overflow == StreamOverflow::Drop) {
+        dropped.fetch_add(1, std::memory_order_relaxed);
+        return true;
+    }
+
+    stalls.fetch_add(1, std::memory_order_relaxed);
+    uint64_t blockedFrom = item.arrivalNs;
+    while (!buffer.push(item)) {
+        if (stopping.load(std::memory_order_relaxed)) return false;
+        sleepNs(FULL_RETRY_NS);
+    }
+    uint64_t now = streamClockNs();
+    blockedNs.fetch_add(now - blockedFrom, std::memory_order_relaxed);
+    // The source was held back; don't catch up with a burst
+    nextDueNs = std::max(nextDueNs, now);
+    return true;
+}
+
+void StreamProducer::run() {
+    auto emit = [this](int value) { return deliver(value); };
+
+    if (config.path.empty()) {
+        std::mt19937_64 rng(config.seed);
+        std::uniform_int_distribution<int> value(0, config.maxValue);
+        while (!stopping.load(std::memory_order_relaxed) && emit(value(rng))) {
+        }
+        done.store(true, std::memory_order_release);
+        return;
+    }
+
+    NumberScanner scanner(rejected);
+    char chunk[4096];
+#ifdef _WIN32
+    // Blocking reads; a pipe with no writer holds stop() until one appears
+    std::FILE* file = std::fopen(config.path.c_str(), "rb");
+    if (file == nullptr) {
+        error = "cannot open " + config.path;
+        done.store(true, std::memory_order_release);
+        return;
+    }
+    size_t got;
+    bool more = true;
+    while (more && !stopping.load(std::memory_order_relaxed) &&
+           (got = std::fread(chunk, 1, sizeof(chunk), file)) > 0) {
+        more = scanner.feed(chunk, got, emit);
+    }
+    if (more) scanner.flush(emit);
+    std::fclose(file);
+#else
+    // Non-blocking, so a pipe nobody writes to yet doesn't hold up stop()
+    int fd = ::open(config.path.c_str(), O_RDONLY | O_NONBLOCK);
+    if (fd < 0) {
+        error = "cannot open " + config.path;
+        done.store(true, std::memory_order_release);
+        return;
+    }
+    bool more = true;
+    while (more && !stopping.load(std::memory_order_relaxed)) {
+        pollfd waitFor{fd, POLLIN, 0};
+        if (::poll(&waitFor, 1, 50) <= 0) continue;
+        ssize_t got = ::read(fd, chunk, sizeof(chunk));
+        if (got > 0) {
+            more = scanner.feed(chunk, static_cast<size_t>(got), emit);
+        } else if (got == 0) {
+            if (more) scanner.flush(emit);
+            break;
+        } else if (errno != EAGAIN && errno != EINTR) {
+            error = "error reading " + config.path;
+            break;
+        }
+    }
+    ::close(fd);
+#endif
+    done.store(true, std::memory_order_release);
+}
+
+} // namespace core
@@ -0,0 +1,113 @@
+#pragma once
+
+// Streaming ingestion: a producer thread reads values from a file, a named
+// pipe or a seeded generator at a set rate and pushes them into a bounded
+// single-producer/single-consumer ring. The consumer (a visualizer's frame
+// loop) pops them at frame boundaries. Neither side takes a lock.
+//
+// When the ring is full the producer either waits for room (backpressure: a
+// pipe's writer then blocks too) or drops the value. Each value carries the
+// time it arrived, so the consumer can measure arrival-to-render latency.
+//
+// File and pipe sources hold integers separated by anything that is not part
+// of a number; '#' starts a comment that runs to the end of the line.
+// Numbers outside the 32-bit range are skipped and counted, where an import
+// of the same file would fail.
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace core {
+
+struct StreamItem {
+    int value;
+    uint64_t arrivalNs;   // streamClockNs() when the producer got the value
+};
+
+// Nanoseconds on the steady clock StreamItem::arrivalNs uses
+uint64_t streamClockNs();
+
+// Lock-free ring for exactly one producer and one consumer thread
+class StreamBuffer {
+public:
+    explicit StreamBuffer(size_t capacity);   // Rounded up to a power of two
+
+    bool push(const StreamItem& item);   // Producer; false if full
+    bool pop(StreamItem& item);          // Consumer; false if empty
+
+    size_t size() const;
+    size_t capacity() const { return slots.size(); }
+
+private:
+    std::vector<StreamItem> slots;
+    size_t mask;
+    // Each index is written by one side only; keep them on separate cache lines
+    alignas(64) std::atomic<size_t> head{0};   // Next slot to pop
+    alignas(64) std::atomic<size_t> tail{0};   // Next slot to push
+};
+
+enum class StreamOverflow { Block, Drop };
+
+struct StreamConfig {
+    std::string path;               // File or named pipe; empty for the generator
+    double rate = 20.0;             // Values per second; 0 for as fast as possible
+    size_t capacity = 64;
+    StreamOverflow overflow = StreamOverflow::Block;
+    uint64_t seed = 1;              // Generator only
+    int maxValue = 99;              // Generator only
+};
+
+struct StreamStats {
+    uint64_t arrived = 0;           // Values read from the source
+    uint64_t dropped = 0;           // Values lost to a full ring (Drop)
+    uint64_t stalls = 0;            // Times the producer found the ring full (Block)
+    uint64_t blockedNs = 0;         // Time the producer spent waiting for room
+    uint64_t rejected = 0;          // Numbers outside the 32-bit range, skipped
+};
+
+class StreamProducer {
+public:
+    explicit StreamProducer(const StreamConfig& config);
+    ~StreamProducer();   // Stops the thread
+    StreamProducer(const StreamProducer&) = delete;
+    StreamProducer& operator=(const StreamProducer&) = delete;
+
+    void start();
+    void stop();
+
+    // Consumer side
+    bool pop(StreamItem& item) { return buffer.pop(item); }
+    size_t buffered() const { return buffer.size(); }
+    size_t capacity() const { return buffer.capacity(); }
+
+    StreamStats stats() const;
+
+    // The source is exhausted (or failed); buffered values may remain
+    bool finished() const { return done.load(std::memory_order_acquire); }
+    // Why the source failed; read once finished() is true
+    const std::string& getError() const { return error; }
+
+private:
+    void run();
+    bool deliver(int value);   // Paces, stamps and pushes one value; false to stop
+
+    StreamConfig config;
+    StreamBuffer buffer;
+    std::thread thread;
+    std::atomic<bool> stopping{false};
+    std::atomic<bool> done{false};
+    std::string error;
+    uint64_t nextDueNs = 0;
+
+    std::atomic<uint64_t> arrived{0};
+    std::atomic<uint64_t> dropped{0};
+    std::atomic<uint64_t> stalls{0};
+    std::atomic<uint64_t> blockedNs{0};
+    std::atomic<uint64_t> rejected{0};
+};
+
+} // namespace core
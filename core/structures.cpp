@@ -0,0 +1,526 @@
+#include "structures.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <numeric>
+#include <stdexcept>
+#include <utility>
+
+namespace core {
+
+// Array
+
+size_t grownCapacity(const GrowthPolicy& policy, size_t capacity) {
+    if (policy.kind == GrowthPolicy::Kind::Increment) {
+        return capacity + std::max<size_t>(1, policy.increment);
+    }
+    size_t grown = static_cast<size_t>(static_cast<double>(capacity) * policy.factor);
+    return std::max(grown, capacity + 1);
+}
+
+std::string growthPolicyName(const GrowthPolicy& policy) {
+    if (policy.kind == GrowthPolicy::Kind::Increment) {
+        return "+" + std::to_string(policy.increment);
+    }
+    char buffer[32];
+    std::snprintf(buffer, sizeof(buffer), "%gx", policy.factor);
+    return buffer;
+}
+
+bool parseGrowthPolicy(const std::string& name, GrowthPolicy& policy) {
+    if (name.size() < 2) {
+        return false;
+    }
+    try {
+        size_t used = 0;
+        if (name[0] == '+') {
+            unsigned long increment = std::stoul(name.substr(1), &used);
+            if (used != name.size() - 1 || increment == 0) return false;
+            policy.kind = GrowthPolicy::Kind::Increment;
+            policy.increment = increment;
+            return true;
+        }
+        if (name.back() != 'x') {
+            return false;
+        }
+        double factor = std::stod(name.substr(0, name.size() - 1), &used);
+        if (used != name.size() - 1 || !(factor > 1.0)) return false;
+        policy.kind = GrowthPolicy::Kind::Factor;
+        policy.factor = factor;
+        return true;
+    } catch (const std::exception&) {
+        return false;
+    }
+}
+
+bool Array::growForInsert() {
+    if (data.size() < data.capacity()) {
+        return false;
+    }
+    // std::vector would grow by its own factor; reserving first makes it ours
+    data.reserve(grownCapacity(policy, data.capacity()));
+    return true;
+}
+
+bool Array::insert(size_t index, int value) {
+    if (index > data.size()) {
+        return false;
+    }
+    growForInsert();
+    data.insert(data.begin() + index, value);
+    return true;
+}
+
+bool Array::append(int value) {
+    bool reallocated = growForInsert();
+    data.push_back(value);
+    return reallocated;
+}
+
+bool Array::overwrite(const std::vector<int>& values) {
+    if (values.size() != data.size()) {
+        return false;
+    }
+    std::copy(values.begin(), values.end(), data.begin());
+    return true;
+}
+
+bool Array::reserve(size_t capacity) {
+    if (capacity <= data.capacity()) {
+        return false;
+    }
+    data.reserve(capacity);
+    return true;
+}
+
+bool Array::remove(size_t index) {
+    if (index >= data.size()) {
+        return false;
+    }
+    data.erase(data.begin() + index);
+    return true;
+}
+
+bool Array::update(size_t index, int value) {
+    if (index >= data.size()) {
+        return false;
+    }
+    data[index] = value;
+    return true;
+}
+
+size_t Array::find(int value) const {
+    auto it = std::find(data.begin(), data.end(), value);
+    return it == data.end() ? npos : static_cast<size_t>(it - data.begin());
+}
+
+// String
+
+bool String::insert(size_t index, const std::string& value) {
+    if (index > data.size()) {
+        return false;
+    }
+    data.insert(index, value);
+    return true;
+}
+
+bool String::remove(size_t index) {
+    if (index >= data.size()) {
+        return false;
+    }
+    data.erase(index, 1);
+    return true;
+}
+
+bool String::update(size_t index, char value) {
+    if (index >= data.size()) {
+        return false;
+    }
+    data[index] = value;
+    return true;
+}
+
+size_t String::find(char value) const {
+    size_t index = data.find(value);
+    return index == std::string::npos ? npos : index;
+}
+
+size_t String::find(const std::string& pattern, size_t from) const {
+    size_t index = data.find(pattern, from);
+    return index == std::string::npos ? npos : index;
+}
+
+// Stack
+
+bool Stack::pop() {
+    if (data.empty()) {
+        return false;
+    }
+    data.pop_back();
+    return true;
+}
+
+// Queue
+
+bool Queue::dequeue() {
+    if (data.empty()) {
+        return false;
+    }
+    data.pop_front();
+    return true;
+}
+
+// LinkedList
+
+LinkedList::LinkedList(std::initializer_list<int> values) {
+    for (int value : values) {
+        pushBack(value);
+    }
+}
+
+const LinkedList::Node* LinkedList::nodeAt(size_t position) const {
+    if (position >= count) {
+        return nullptr;
+    }
+    const Node* current = head;
+    for (size_t i = 0; i < position; ++i) {
+        current = current->next;
+    }
+    return current;
+}
+
+void LinkedList::pushFront(int value) {
+    Node* node = new Node(value);
+    node->next = head;
+    head = node;
+    if (tail == nullptr) {
+        tail = node;
+    }
+    count++;
+}
+
+void LinkedList::pushBack(int value) {
+    Node* node = new Node(value);
+    if (tail != nullptr) {
+        tail->next = node;
+    } else {
+        head = node;
+    }
+    tail = node;
+    count++;
+}
+
+bool LinkedList::insert(size_t position, int value) {
+    if (position > count) {
+        return false;
+    }
+    if (position == 0) {
+        pushFront(value);
+        return true;
+    }
+    if (position == count) {
+        pushBack(value);
+        return true;
+    }
+    Node* previous = const_cast<Node*>(nodeAt(position - 1));
+    Node* node = new Node(value);
+    node->next = previous->next;
+    previous->next = node;
+    count++;
+    return true;
+}
+
+bool LinkedList::remove(size_t position) {
+    if (position >= count) {
+        return false;
+    }
+    Node* toDelete;
+    if (position == 0) {
+        toDelete = head;
+        head = head->next;
+        if (head == nullptr) {
+            tail = nullptr;
+        }
+    } else {
+        Node* previous = const_cast<Node*>(nodeAt(position - 1));
+        toDelete = previous->next;
+        previous->next = toDelete->next;
+        if (toDelete == tail) {
+            tail = previous;
+        }
+    }
+    delete toDelete;
+    count--;
+    return true;
+}
+
+bool LinkedList::update(size_t position, int value) {
+    Node* node = const_cast<Node*>(nodeAt(position));
+    if (node == nullptr) {
+        return false;
+    }
+    node->data = value;
+    return true;
+}
+
+size_t LinkedList::find(int value) const {
+    size_t index = 0;
+    for (const Node* current = head; current != nullptr; current = current->next, ++index) {
+        if (current->data == value) {
+            return index;
+        }
+    }
+    return npos;
+}
+
+std::vector<int> LinkedList::values() const {
+    std::vector<int> result;
+    result.reserve(count);
+    for (const Node* current = head; current != nullptr; current = current->next) {
+        result.push_back(current->data);
+    }
+    return result;
+}
+
+void LinkedList::clear() {
+    while (head != nullptr) {
+        Node* temp = head;
+        head = head->next;
+        delete temp;
+    }
+    tail = nullptr;
+    count = 0;
+}
+
+// BinarySearchTree
+
+// Walks use an explicit stack: a tree built from sorted keys is a chain as
+// deep as it is large, which would overflow the call stack.
+
+namespace {
+
+using BstNode = BinarySearchTree::Node;
+
+size_t subtreeHeight(const BstNode* node) {
+    size_t height = 0;
+    std::vector<std::pair<const BstNode*, size_t>> pending;
+    if (node != nullptr) pending.emplace_back(node, 1);
+    while (!pending.empty()) {
+        const BstNode* current = pending.back().first;
+        size_t depth = pending.back().second;
+        pending.pop_back();
+        height = std::max(height, depth);
+        if (current->left) pending.emplace_back(current->left, depth + 1);
+        if (current->right) pending.emplace_back(current->right, depth + 1);
+    }
+    return height;
+}
+
+enum class Order { In, Pre, Post };
+
+void collect(const BstNode* node, Order order, std::vector<int>& out) {
+    // A node is visited twice: once on the way down (expanded == false) and
+    // once after its children are queued, in the order the traversal wants
+    std::vector<std::pair<const BstNode*, bool>> pending;
+    if (node != nullptr) pending.emplace_back(node, false);
+    while (!pending.empty()) {
+        const BstNode* current = pending.back().first;
+        bool expanded = pending.back().second;
+        pending.pop_back();
+        if (expanded) {
+            out.push_back(current->data);
+            continue;
+        }
+        // Pushed in reverse of the visiting order
+        if (order == Order::Post) pending.emplace_back(current, true);
+        if (current->right) pending.emplace_back(current->right, false);
+        if (order == Order::In) pending.emplace_back(current, true);
+        if (current->left) pending.emplace_back(current->left, false);
+        if (order == Order::Pre) pending.emplace_back(current, true);
+    }
+}
+
+void destroy(BstNode* node) {
+    std::vector<BstNode*> pending;
+    if (node != nullptr) pending.push_back(node);
+    while (!pending.empty()) {
+        BstNode* current = pending.back();
+        pending.pop_back();
+        if (current->left) pending.push_back(current->left);
+        if (current->right) pending.push_back(current->right);
+        delete current;
+    }
+}
+
+// The middle of values[first, last) becomes the root, moved left onto the
+// first of its duplicates so equal keys stay in the right subtree as insert()
+// puts them. Left ranges at least halve, so only the right spine (long when
+// there are many duplicates) needs the loop instead of recursion.
+BstNode* buildBalanced(const int* values, size_t first, size_t last) {
+    BstNode* top = nullptr;
+    BstNode** link = &top;
+    while (first < last) {
+        const int* half = values + first + (last - first) / 2;
+        size_t middle = static_cast<size_t>(std::lower_bound(values + first, half, *half) - values);
+        BstNode* node = new BstNode(values[middle]);
+        node->left = buildBalanced(values, first, middle);
+        *link = node;
+        link = &node->right;
+        first = middle + 1;
+    }
+    return top;
+}
+
+} // namespace
+
+size_t BinarySearchTree::height() const {
+    return subtreeHeight(root);
+}
+
+void BinarySearchTree::insert(int value) {
+    Node** link = &root;
+    while (*link != nullptr) {
+        link = value < (*link)->data ? &(*link)->left : &(*link)->right;
+    }
+    *link = new Node(value);
+    count++;
+}
+
+bool BinarySearchTree::remove(int value) {
+    Node** link = &root;
+    while (*link != nullptr && (*link)->data != value) {
+        link = value < (*link)->data ? &(*link)->left : &(*link)->right;
+    }
+    Node* target = *link;
+    if (target == nullptr) {
+        return false;
+    }
+
+    if (target->left && target->right) {
+        // Take the in-order successor's value and unlink the successor instead
+        Node** successorLink = &target->right;
+        while ((*successorLink)->left != nullptr) {
+            successorLink = &(*successorLink)->left;
+        }
+        Node* successor = *successorLink;
+        target->data = successor->data;
+        *successorLink = successor->right;
+        delete successor;
+    } else {
+        *link = target->left ? target->left : target->right;
+        delete target;
+    }
+    count--;
+    return true;
+}
+
+bool BinarySearchTree::contains(int value) const {
+    const Node* current = root;
+    while (current != nullptr) {
+        if (value == current->data) {
+            return true;
+        }
+        current = value < current->data ? current->left : current->right;
+    }
+    return false;
+}
+
+std::vector<int> BinarySearchTree::inorder() const {
+    std::vector<int> result;
+    result.reserve(count);
+    collect(root, Order::In, result);
+    return result;
+}
+
+std::vector<int> BinarySearchTree::preorder() const {
+    std::vector<int> result;
+    result.reserve(count);
+    collect(root, Order::Pre, result);
+    return result;
+}
+
+std::vector<int> BinarySearchTree::postorder() const {
+    std::vector<int> result;
+    result.reserve(count);
+    collect(root, Order::Post, result);
+    return result;
+}
+
+bool BinarySearchTree::assignPreorder(const int* values, size_t n) {
+    clear();
+    // `open` is the path of nodes whose right subtree may still grow. A value
+    // goes left of the deepest one if smaller, else right of the highest one
+    // it is not smaller than; after that nothing may drop below that node.
+    std::vector<Node*> open;
+    bool bounded = false;
+    int lowest = 0;
+    for (size_t i = 0; i < n; ++i) {
+        int value = values[i];
+        if (bounded && value < lowest) {
+            clear();
+            return false;
+        }
+        Node* node = new Node(value);
+        count++;
+        if (i == 0) {
+            root = node;
+        } else if (value < open.back()->data) {
+            open.back()->left = node;
+        } else {
+            Node* parent = nullptr;
+            while (!open.empty() && open.back()->data <= value) {
+                parent = open.back();
+                open.pop_back();
+            }
+            parent->right = node;
+            bounded = true;
+            lowest = parent->data;
+        }
+        open.push_back(node);
+    }
+    return true;
+}
+
+void BinarySearchTree::assignInsertOrder(const int* values, size_t n) {
+    clear();
+    // insert() puts every key after the ones already in the tree, and ties
+    // to the right of earlier equal keys. So the result is the one tree whose
+    // inorder is the keys sorted stably and in which each node arrived before
+    // its descendants: a Cartesian tree on arrival, built from the sorted
+    // keys with a stack holding its right spine.
+    std::vector<size_t> order(n);
+    std::iota(order.begin(), order.end(), size_t(0));
+    std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) { return values[a] < values[b]; });
+    std::vector<std::pair<Node*, size_t>> spine;
+    for (size_t arrival : order) {
+        Node* node = new Node(values[arrival]);
+        Node* later = nullptr;
+        while (!spine.empty() && spine.back().second > arrival) {
+            later = spine.back().first;
+            spine.pop_back();
+        }
+        node->left = later;
+        if (!spine.empty()) spine.back().first->right = node;
+        spine.emplace_back(node, arrival);
+    }
+    root = spine.empty() ? nullptr : spine.front().first;
+    count = n;
+}
+
+bool BinarySearchTree::assignSorted(const int* values, size_t n) {
+    clear();
+    if (!std::is_sorted(values, values + n)) {
+        return false;
+    }
+    root = buildBalanced(values, 0, n);
+    count = n;
+    return true;
+}
+
+void BinarySearchTree::clear() {
+    destroy(root);
+    root = nullptr;
+    count = 0;
+}
+
+} // namespace core
@@ -0,0 +1,223 @@
+#pragma once
+
+// Headless data structure core. Holds the containers and their operations with
+// no SFML dependency, so they can run, be benchmarked and be fuzzed without a
+// window. The visualizers in main.cpp keep one of these as their model and
+// only add animation and layout on top.
+
+#include <cstddef>
+#include <initializer_list>
+#include <deque>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace core {
+
+// Returned by find() when the value is not present
+constexpr size_t npos = static_cast<size_t>(-1);
+
+// How Array picks a new capacity when an insert finds it full. Growing by a
+// factor keeps appends amortized O(1): each element is copied a bounded number
+// of times on average. A fixed increment copies the whole array every
+// `increment` appends, so n appends cost O(n^2).
+struct GrowthPolicy {
+    enum class Kind { Factor, Increment };
+    Kind kind = Kind::Factor;
+    double factor = 2.0;            // Kind::Factor; at least one slot is added
+    size_t increment = 16;          // Kind::Increment
+};
+
+// The capacity an insert into a full array of `capacity` slots grows to
+size_t grownCapacity(const GrowthPolicy& policy, size_t capacity);
+
+std::string growthPolicyName(const GrowthPolicy& policy);   // "2x", "1.5x", "+16"
+bool parseGrowthPolicy(const std::string& name, GrowthPolicy& policy);
+
+class Array {
+public:
+    Array() = default;
+    Array(std::initializer_list<int> values) : data(values) {}
+    explicit Array(std::vector<int> values) : data(std::move(values)) {}
+
+    size_t size() const { return data.size(); }
+    size_t capacity() const { return data.capacity(); }
+    bool empty() const { return data.empty(); }
+    int operator[](size_t index) const { return data[index]; }
+    const std::vector<int>& values() const { return data; }
+
+    // Mutators return false (and leave the array untouched) on a bad index
+    bool insert(size_t index, int value);
+    bool remove(size_t index);
+    bool update(size_t index, int value);
+    size_t find(int value) const;
+    void clear() { data.clear(); }
+
+    // Inserts at the end; true when that had to reallocate
+    bool append(int value);
+    // Grows the capacity to at least `capacity` slots (never shrinks); true
+    // when that reallocated
+    bool reserve(size_t capacity);
+    // Replaces the contents, keeping the growth policy; the capacity becomes
+    // that of `values`
+    void assign(std::vector<int> values) { data = std::move(values); }
+    // Overwrites every element with `values` in place, keeping the capacity.
+    // False (and untouched) unless the sizes match.
+    bool overwrite(const std::vector<int>& values);
+
+    const GrowthPolicy& growth() const { return policy; }
+    void setGrowth(const GrowthPolicy& growth) { policy = growth; }
+
+private:
+    // Makes room for one more element by the growth policy
+    bool growForInsert();
+
+    std::vector<int> data;
+    GrowthPolicy policy;
+};
+
+class String {
+public:
+    String() = default;
+    String(std::string value) : data(std::move(value)) {}
+
+    size_t size() const { return data.size(); }
+    bool empty() const { return data.empty(); }
+    char operator[](size_t index) const { return data[index]; }
+    const std::string& str() const { return data; }
+
+    bool insert(size_t index, const std::string& value);
+    bool remove(size_t index);
+    bool update(size_t index, char value);
+    size_t find(char value) const;
+    size_t find(const std::string& pattern, size_t from = 0) const;
+    void clear() { data.clear(); }
+
+private:
+    std::string data;
+};
+
+class Stack {
+public:
+    Stack() = default;
+    Stack(std::initializer_list<int> values) : data(values) {}
+    explicit Stack(std::vector<int> values) : data(std::move(values)) {}
+
+    size_t size() const { return data.size(); }
+    bool empty() const { return data.empty(); }
+    int operator[](size_t index) const { return data[index]; }  // 0 is the bottom
+    int top() const { return data.back(); }
+
+    void push(int value) { data.push_back(value); }
+    bool pop();
+    void clear() { data.clear(); }
+
+private:
+    std::vector<int> data;
+};
+
+class Queue {
+public:
+    Queue() = default;
+    Queue(std::initializer_list<int> values) : data(values) {}
+    explicit Queue(const std::vector<int>& values) : data(values.begin(), values.end()) {}
+
+    size_t size() const { return data.size(); }
+    bool empty() const { return data.empty(); }
+    int operator[](size_t index) const { return data[index]; }  // 0 is the front
+    int front() const { return data.front(); }
+
+    void enqueue(int value) { data.push_back(value); }
+    bool dequeue();
+    void clear() { data.clear(); }
+
+private:
+    std::deque<int> data;
+};
+
+// Singly linked list with a tail pointer. Positions are 0-based.
+class LinkedList {
+public:
+    struct Node {
+        int data;
+        Node* next;
+        explicit Node(int d) : data(d), next(nullptr) {}
+    };
+
+    LinkedList() = default;
+    LinkedList(std::initializer_list<int> values);
+    ~LinkedList() { clear(); }
+    LinkedList(const LinkedList&) = delete;
+    LinkedList& operator=(const LinkedList&) = delete;
+
+    size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+    const Node* front() const { return head; }
+    const Node* nodeAt(size_t position) const;
+
+    void pushFront(int value);
+    void pushBack(int value);
+    bool insert(size_t position, int value);   // position == size() appends
+    bool remove(size_t position);
+    bool update(size_t position, int value);
+    size_t find(int value) const;
+    std::vector<int> values() const;
+    void clear();
+
+private:
+    Node* head = nullptr;
+    Node* tail = nullptr;
+    size_t count = 0;
+};
+
+// Unbalanced binary search tree. Duplicates go to the right subtree and
+// removal of a node with two children takes its in-order successor.
+class BinarySearchTree {
+public:
+    struct Node {
+        int data;
+        Node* left;
+        Node* right;
+        explicit Node(int d) : data(d), left(nullptr), right(nullptr) {}
+    };
+
+    BinarySearchTree() = default;
+    ~BinarySearchTree() { clear(); }
+    BinarySearchTree(const BinarySearchTree&) = delete;
+    BinarySearchTree& operator=(const BinarySearchTree&) = delete;
+
+    size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+    const Node* getRoot() const { return root; }
+    size_t height() const;
+
+    void insert(int value);
+    bool remove(int value);
+    bool contains(int value) const;
+    std::vector<int> inorder() const;
+    std::vector<int> preorder() const;
+    std::vector<int> postorder() const;
+    void clear();
+
+    // Replaces the contents with the tree `values` is the preorder of, in
+    // O(n) (inserting them one by one rebuilds the same shape, in
+    // O(n * height)). Returns false, leaving the tree empty, if `values`
+    // cannot be the preorder of a tree built by insert().
+    bool assignPreorder(const int* values, size_t n);
+
+    // Replaces the contents with the tree inserting `values` in order builds,
+    // in O(n log n) instead of O(n * height), which is O(n^2) for sorted keys
+    void assignInsertOrder(const int* values, size_t n);
+
+    // Replaces the contents with a balanced tree of `values`, which must be
+    // sorted, in O(n); only runs of duplicates (kept in right subtrees, as
+    // insert() does) can make it deeper. Returns false, leaving the tree
+    // empty, if `values` is not sorted.
+    bool assignSorted(const int* values, size_t n);
+
+private:
+    Node* root = nullptr;
+    size_t count = 0;
+};
+
+} // namespace core
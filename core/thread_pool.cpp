@@ -0,0 +1,115 @@
+#include "thread_pool.h"
+
+#include <algorithm>
+
+namespace core {
+
+namespace {
+
+// Which pool (if any) the running thread works for, and its deque there
+thread_local const ThreadPool* currentPool = nullptr;
+thread_local size_t currentIndex = 0;
+
+} // namespace
+
+ThreadPool::ThreadPool(size_t threads) {
+    threads = std::max<size_t>(1, threads);
+    for (size_t i = 0; i < threads; ++i) {
+        queues.emplace_back(new Queue());
+    }
+    for (size_t i = 1; i < threads; ++i) {
+        workers.emplace_back([this, i]() { workerLoop(i); });
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> guard(sleepLock);
+        stopping.store(true);
+    }
+    wake.notify_all();
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+}
+
+size_t ThreadPool::currentThread() const {
+    return currentPool == this ? currentIndex : 0;
+}
+
+void ThreadPool::spawn(TaskGroup& group, std::function<void()> task) {
+    group.pending.fetch_add(1, std::memory_order_relaxed);
+    Queue& own = *queues[currentThread()];
+    {
+        std::lock_guard<std::mutex> guard(own.lock);
+        own.tasks.push_back([&group, task = std::move(task)]() {
+            task();
+            group.pending.fetch_sub(1, std::memory_order_acq_rel);
+        });
+    }
+    queued.fetch_add(1, std::memory_order_release);
+    if (!workers.empty()) {
+        // Taking the lock orders this with a worker about to sleep
+        std::lock_guard<std::mutex> guard(sleepLock);
+        wake.notify_one();
+    }
+}
+
+void ThreadPool::wait(TaskGroup& group) {
+    size_t self = currentThread();
+    const ThreadPool* outerPool = currentPool;
+    size_t outerIndex = currentIndex;
+    currentPool = this;
+    currentIndex = self;
+
+    while (!group.done()) {
+        if (!runOne(self)) {
+            std::this_thread::yield();
+        }
+    }
+
+    currentPool = outerPool;
+    currentIndex = outerIndex;
+}
+
+bool ThreadPool::runOne(size_t self) {
+    std::function<void()> task;
+    {
+        Queue& own = *queues[self];
+        std::lock_guard<std::mutex> guard(own.lock);
+        if (!own.tasks.empty()) {
+            task = std::move(own.tasks.back());
+            own.tasks.pop_back();
+        }
+    }
+    for (size_t k = 1; !task && k < queues.size(); ++k) {
+        Queue& victim = *queues[(self + k) % queues.size()];
+        std::lock_guard<std::mutex> guard(victim.lock);
+        if (!victim.tasks.empty()) {
+            task = std::move(victim.tasks.front());
+            victim.tasks.pop_front();
+            stolen.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+    if (!task) {
+        return false;
+    }
+    queued.fetch_sub(1, std::memory_order_relaxed);
+    task();
+    return true;
+}
+
+void ThreadPool::workerLoop(size_t self) {
+    currentPool = this;
+    currentIndex = self;
+    for (;;) {
+        if (runOne(self)) continue;
+        std::unique_lock<std::mutex> guard(sleepLock);
+        wake.wait(guard, [this]() {
+            return stopping.load() || queued.load(std::memory_order_acquire) > 0;
+        });
+        if (stopping.load()) return;
+    }
+}
+
+} // namespace core
@@ -0,0 +1,72 @@
+#pragma once
+
+// Fork-join thread pool with work stealing. Every thread owns a deque: it
+// pushes and pops its own tasks at the back (newest first, still warm in its
+// cache) and, when that runs dry, steals the oldest task from the front of
+// another thread's deque, which is usually the largest piece of work left.
+//
+// A pool of N threads starts N - 1 workers; the thread that calls wait() is
+// the Nth and runs tasks while it waits, so ThreadPool(1) runs everything
+// inline on the caller. Tasks may spawn and wait on their own groups. Only
+// one outside thread may use a pool at a time.
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace core {
+
+// Tasks spawned together; wait() returns once all of them have run
+class TaskGroup {
+public:
+    bool done() const { return pending.load(std::memory_order_acquire) == 0; }
+
+private:
+    friend class ThreadPool;
+    std::atomic<size_t> pending{0};
+};
+
+class ThreadPool {
+public:
+    explicit ThreadPool(size_t threads);   // At least 1
+    ~ThreadPool();
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    size_t size() const { return queues.size(); }
+
+    void spawn(TaskGroup& group, std::function<void()> task);
+    // Runs this pool's tasks until the group is done
+    void wait(TaskGroup& group);
+
+    // The calling thread's index: 0 for the outside thread, 1.. for workers
+    size_t currentThread() const;
+
+    // Tasks taken from another thread's deque since construction
+    size_t steals() const { return stolen.load(std::memory_order_relaxed); }
+
+private:
+    struct Queue {
+        std::mutex lock;
+        std::deque<std::function<void()>> tasks;
+    };
+
+    void workerLoop(size_t self);
+    bool runOne(size_t self);   // Own back first, then steal; false if every deque was empty
+
+    std::vector<std::unique_ptr<Queue>> queues;   // Index 0 belongs to the outside thread
+    std::vector<std::thread> workers;
+    std::atomic<size_t> queued{0};
+    std::atomic<size_t> stolen{0};
+    std::atomic<bool> stopping{false};
+    std::mutex sleepLock;
+    std::condition_variable wake;
+};
+
+} // namespace core
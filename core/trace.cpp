@@ -0,0 +1,106 @@
+#include "trace.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace {
+
+struct Zone {
+    const char* name;
+    uint64_t start;
+    uint64_t duration;
+};
+
+const size_t BUFFER_ZONES = 1 << 16;  // Per thread, about 1.5 MB
+
+// Written only by its own thread; `written` is published after each zone
+struct ThreadBuffer {
+    Zone zones[BUFFER_ZONES];
+    std::atomic<uint64_t> written{0};
+    int tid = 0;
+    std::atomic<const char*> name{nullptr};
+};
+
+// Buffers outlive their threads so a session can be exported at any time
+std::mutex registryMutex;
+std::vector<std::unique_ptr<ThreadBuffer>> registry;
+
+thread_local ThreadBuffer* localBuffer = nullptr;
+
+ThreadBuffer& buffer() {
+    if (localBuffer == nullptr) {
+        std::unique_ptr<ThreadBuffer> created(new ThreadBuffer());
+        std::lock_guard<std::mutex> lock(registryMutex);
+        created->tid = static_cast<int>(registry.size()) + 1;
+        localBuffer = created.get();
+        registry.push_back(std::move(created));
+    }
+    return *localBuffer;
+}
+
+} // namespace
+
+namespace core {
+
+uint64_t Trace::now() {
+    static const auto epoch = std::chrono::steady_clock::now();
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - epoch).count());
+}
+
+void Trace::record(const char* name, uint64_t startNs, uint64_t endNs) {
+    ThreadBuffer& b = buffer();
+    uint64_t index = b.written.load(std::memory_order_relaxed);
+    b.zones[index % BUFFER_ZONES] = Zone{name, startNs, endNs - startNs};
+    b.written.store(index + 1, std::memory_order_release);
+}
+
+void Trace::setThreadName(const char* name) {
+    buffer().name.store(name, std::memory_order_release);
+}
+
+size_t Trace::recordedZones() {
+    std::lock_guard<std::mutex> lock(registryMutex);
+    size_t total = 0;
+    for (const auto& b : registry) {
+        total += static_cast<size_t>(std::min<uint64_t>(b->written.load(std::memory_order_acquire), BUFFER_ZONES));
+    }
+    return total;
+}
+
+bool Trace::writeChromeJson(const std::string& path) {
+    FILE* out = std::fopen(path.c_str(), "w");
+    if (out == nullptr) {
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(registryMutex);
+    std::fprintf(out, "{\"displayTimeUnit\": \"ms\", \"traceEvents\": [\n");
+    bool first = true;
+    for (const auto& b : registry) {
+        if (const char* name = b->name.load(std::memory_order_acquire)) {
+            std::fprintf(out, "%s{\"name\": \"thread_name\", \"ph\": \"M\", \"pid\": 1, \"tid\": %d, "
+                         "\"args\": {\"name\": \"%s\"}}", first ? "" : ",\n", b->tid, name);
+            first = false;
+        }
+        uint64_t written = b->written.load(std::memory_order_acquire);
+        uint64_t begin = written > BUFFER_ZONES ? written - BUFFER_ZONES : 0;
+        for (uint64_t i = begin; i < written; ++i) {
+            const Zone& zone = b->zones[i % BUFFER_ZONES];
+            // Chrome wants microseconds; keep the nanoseconds as decimals
+            std::fprintf(out, "%s{\"name\": \"%s\", \"ph\": \"X\", \"pid\": 1, \"tid\": %d, "
+                         "\"ts\": %.3f, \"dur\": %.3f}", first ? "" : ",\n", zone.name, b->tid,
+                         zone.start / 1000.0, zone.duration / 1000.0);
+            first = false;
+        }
+    }
+    std::fprintf(out, "\n]}\n");
+    return std::fclose(out) == 0;
+}
+
+} // namespace core
@@ -0,0 +1,67 @@
+#pragma once
+
+// Scoped timing zones exported as Chrome trace-event JSON, for Perfetto or
+// chrome://tracing. Each thread records into its own fixed-size ring buffer
+// without locking (only its first zone registers the buffer); once a buffer is
+// full the oldest zones are overwritten.
+//
+// The DSV_TRACE_* macros are how code is instrumented. They compile to nothing
+// unless DSV_TRACE is defined (make TRACE=1), so zones can stay in hot paths.
+//
+//   void step() {
+//       DSV_TRACE_ZONE("step");            // Whole scope
+//       DSV_TRACE_MARK(drawStart);
+//       draw();
+//       DSV_TRACE_RECORD("draw", drawStart);  // From the mark to here
+//   }
+
+#include <cstdint>
+#include <string>
+
+namespace core {
+
+class Trace {
+public:
+    // Nanoseconds on a steady clock, since the first call in the process
+    static uint64_t now();
+
+    // Adds the zone [startNs, endNs) to the calling thread's buffer. `name`
+    // must outlive the trace (string literals).
+    static void record(const char* name, uint64_t startNs, uint64_t endNs);
+
+    // Label for the calling thread in the viewer
+    static void setThreadName(const char* name);
+
+    // Writes every buffered zone of every thread. Zones a thread records while
+    // this runs may be missed.
+    static bool writeChromeJson(const std::string& path);
+
+    static size_t recordedZones();   // Currently held, over all threads
+};
+
+// Records the enclosing scope
+class TraceZone {
+private:
+    const char* name;
+    uint64_t start;
+
+public:
+    explicit TraceZone(const char* zoneName) : name(zoneName), start(Trace::now()) {}
+    ~TraceZone() { Trace::record(name, start, Trace::now()); }
+    TraceZone(const TraceZone&) = delete;
+    TraceZone& operator=(const TraceZone&) = delete;
+};
+
+} // namespace core
+
+#ifdef DSV_TRACE
+#define DSV_TRACE_CONCAT_(a, b) a##b
+#define DSV_TRACE_CONCAT(a, b) DSV_TRACE_CONCAT_(a, b)
+#define DSV_TRACE_ZONE(name) core::TraceZone DSV_TRACE_CONCAT(traceZone_, __LINE__)(name)
+#define DSV_TRACE_MARK(var) uint64_t var = core::Trace::now()
+#define DSV_TRACE_RECORD(name, var) core::Trace::record((name), (var), core::Trace::now())
+#else
+#define DSV_TRACE_ZONE(name) ((void)0)
+#define DSV_TRACE_MARK(var) ((void)0)
+#define DSV_TRACE_RECORD(name, var) ((void)0)
+#endif
@@ -0,0 +1,160 @@
+#include "workload.h"
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+
+namespace core {
+
+namespace {
+
+// Zipf ranks beyond this are not tabulated: they keep their share of the
+// probability mass, drawn from the continuous approximation of the tail, so
+// the CDF table stays small for huge value ranges
+const size_t ZIPF_MAX_RANKS = 1 << 20;
+
+std::vector<int> uniformValues(size_t count, int maxValue, std::mt19937_64& rng) {
+    std::uniform_int_distribution<int> value(0, maxValue);
+    std::vector<int> values(count);
+    for (int& v : values) {
+        v = value(rng);
+    }
+    return values;
+}
+
+std::vector<int> zipfValues(size_t count, int maxValue, double skew, std::mt19937_64& rng) {
+    size_t ranks = std::min(static_cast<size_t>(maxValue) + 1, ZIPF_MAX_RANKS);
+    std::vector<double> cdf(ranks);
+    double total = 0;
+    for (size_t k = 0; k < ranks; ++k) {
+        total += 1.0 / std::pow(static_cast<double>(k + 1), skew);
+        cdf[k] = total;
+    }
+    // Ranks ranks+1..allRanks, as the integral of x^-skew over
+    // [ranks + 0.5, allRanks + 0.5], inverted to draw from
+    size_t allRanks = static_cast<size_t>(maxValue) + 1;
+    double from = ranks + 0.5, to = allRanks + 0.5;
+    bool harmonic = std::abs(skew - 1.0) < 1e-9;
+    double tail = 0;
+    if (allRanks > ranks) {
+        tail = harmonic ? std::log(to / from)
+                        : (std::pow(to, 1.0 - skew) - std::pow(from, 1.0 - skew)) / (1.0 - skew);
+    }
+
+    std::uniform_real_distribution<double> u(0.0, total + tail);
+    std::vector<int> values(count);
+    for (int& v : values) {
+        double p = u(rng);
+        if (p < total) {
+            v = static_cast<int>(std::lower_bound(cdf.begin(), cdf.end(), p) - cdf.begin());
+            v = std::min(v, static_cast<int>(ranks) - 1);
+            continue;
+        }
+        double into = p - total;
+        double x = harmonic ? from * std::exp(into)
+                            : std::pow(std::pow(from, 1.0 - skew) + into * (1.0 - skew), 1.0 / (1.0 - skew));
+        double rank = std::min(std::max(std::floor(x + 0.5), static_cast<double>(ranks + 1)),
+                               static_cast<double>(allRanks));
+        v = static_cast<int>(rank - 1);
+    }
+    return values;
+}
+
+} // namespace
+
+std::vector<int> generateWorkload(const WorkloadSpec& spec) {
+    std::mt19937_64 rng(spec.seed);
+    size_t count = spec.count;
+    int maxValue = spec.maxValue > 0 ? spec.maxValue
+                                     : static_cast<int>(std::min<size_t>(4 * count, 0x7fffffff));
+
+    switch (spec.kind) {
+        case Workload::Uniform:
+            return uniformValues(count, maxValue, rng);
+
+        case Workload::Sorted: {
+            std::vector<int> values = uniformValues(count, maxValue, rng);
+            std::sort(values.begin(), values.end());
+            return values;
+        }
+
+        case Workload::Reverse: {
+            std::vector<int> values = uniformValues(count, maxValue, rng);
+            std::sort(values.rbegin(), values.rend());
+            return values;
+        }
+
+        case Workload::NearlySorted: {
+            std::vector<int> values = uniformValues(count, maxValue, rng);
+            std::sort(values.begin(), values.end());
+            if (count < 2) return values;
+            size_t moves = static_cast<size_t>(std::ceil(spec.disorder * count));
+            for (size_t m = 0; m < moves; ++m) {
+                size_t i = static_cast<size_t>(rng() % count);
+                size_t j = std::min(count - 1, i + 1 + static_cast<size_t>(rng() % 8));
+                std::swap(values[i], values[j]);
+            }
+            return values;
+        }
+
+        case Workload::Zipf:
+            return zipfValues(count, maxValue, spec.skew, rng);
+
+        case Workload::Duplicates: {
+            size_t distinct = std::max<size_t>(2, static_cast<size_t>(std::sqrt(static_cast<double>(count))));
+            std::vector<int> pool = uniformValues(distinct, maxValue, rng);
+            std::vector<int> values(count);
+            for (int& v : values) {
+                v = pool[rng() % distinct];
+            }
+            return values;
+        }
+
+        case Workload::Zigzag: {
+            std::vector<int> sorted = uniformValues(count, maxValue, rng);
+            std::sort(sorted.begin(), sorted.end());
+            std::vector<int> values;
+            values.reserve(count);
+            size_t low = 0, high = count;
+            while (low < high) {
+                values.push_back(sorted[low++]);
+                if (low < high) values.push_back(sorted[--high]);
+            }
+            return values;
+        }
+
+        case Workload::OrganPipe: {
+            std::vector<int> values = uniformValues(count, maxValue, rng);
+            std::sort(values.begin(), values.begin() + count / 2);
+            std::sort(values.begin() + count / 2, values.end(), [](int a, int b) { return a > b; });
+            return values;
+        }
+    }
+    return {};
+}
+
+const char* workloadName(Workload kind) {
+    switch (kind) {
+        case Workload::Uniform:      return "uniform";
+        case Workload::Sorted:       return "sorted";
+        case Workload::Reverse:      return "reverse";
+        case Workload::NearlySorted: return "nearly-sorted";
+        case Workload::Zipf:         return "zipf";
+        case Workload::Duplicates:   return "duplicates";
+        case Workload::Zigzag:       return "zigzag";
+        case Workload::OrganPipe:    return "organ-pipe";
+    }
+    return "";
+}
+
+bool parseWorkload(const std::string& name, Workload& kind) {
+    for (int k = 0; k < WORKLOAD_COUNT; ++k) {
+        if (name == workloadName(static_cast<Workload>(k))) {
+            kind = static_cast<Workload>(k);
+            return true;
+        }
+    }
+    return false;
+}
+
+} // namespace core
@@ -0,0 +1,45 @@
+#pragma once
+
+// Input generators for the visualizers, batch mode and the benchmarks. Every
+// sequence is a pure function of its spec, so a seed reproduces it exactly.
+//
+//   uniform         independent draws from [0, maxValue]
+//   sorted          a uniform sample in ascending order (a BST degenerates
+//                   into a right-leaning chain)
+//   reverse         the same, descending (a left-leaning chain)
+//   nearly-sorted   sorted, then a `disorder` fraction of elements swapped
+//                   with a neighbour at most 8 places away
+//   zipf            value k-1 drawn with probability proportional to 1/k^skew,
+//                   so a few small values dominate
+//   duplicates      draws from only about sqrt(count) distinct values
+//   zigzag          alternately the smallest and largest remaining sorted
+//                   value: every BST insert goes one level deeper, turning
+//                   left and right in turn
+//   organ-pipe      ascending to the middle, then descending (a classic bad
+//                   case for naive pivots and insertion sort)
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace core {
+
+enum class Workload { Uniform, Sorted, Reverse, NearlySorted, Zipf, Duplicates, Zigzag, OrganPipe };
+constexpr int WORKLOAD_COUNT = 8;
+
+struct WorkloadSpec {
+    Workload kind = Workload::Uniform;
+    size_t count = 16;
+    uint64_t seed = 42;
+    int maxValue = 0;          // Values lie in [0, maxValue]; 0 means 4 * count
+    double skew = 1.1;         // Zipf exponent
+    double disorder = 0.05;    // Fraction of nearly-sorted elements moved
+};
+
+std::vector<int> generateWorkload(const WorkloadSpec& spec);
+
+const char* workloadName(Workload kind);          // "nearly-sorted" etc.
+bool parseWorkload(const std::string& name, Workload& kind);
+
+} // namespace core
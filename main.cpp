@@ -7,10 +7,154 @@
 #include <iostream>
 #include <cmath>
 #include <queue>
+#include <cstdio>
+#include <deque>
+#include <map>
+#include <limits>
+#include <random>
+#include <chrono>
+#include <future>
+
+#include "core/structures.h"
+#include "core/batch.h"
+#include "core/perf_counters.h"
+#include "core/alloc_tracker.h"
+#include "core/trace.h"
+#include "core/complexity.h"
+#include "core/workload.h"
+#include "core/import.h"
+#include "core/snapshot.h"
+#include "core/stream.h"
+#include "core/sorting.h"
+#include "core/parallel_sort.h"
+#include "core/search.h"
+#include "core/matrix.h"
+#include "core/scan.h"
 
 
 enum class Operation { None, Insert, Remove, Search, Update, InsertAtHead, InsertAtTail, InsertAtAnyPosition,
-                        Push, Pop, Peek, Enqueue, Dequeue, Front, Inorder, Preorder, Postorder};
+                        Push, Pop, Peek, Enqueue, Dequeue, Front, Inorder, Preorder, Postorder, Sort};
+
+// What one frame submitted to the GPU
+struct RenderStats {
+    static constexpr int PRIMITIVE_TYPES = sf::Quads + 1;
+
+    size_t drawCalls = 0;
+    size_t vertices = 0;
+    size_t primitives[PRIMITIVE_TYPES] = {};  // Draw calls per sf::PrimitiveType
+    size_t textDraws = 0;
+    size_t textureBinds = 0;    // Draws that switched to a different texture
+    size_t stateChanges = 0;    // Draws that switched texture, blend mode or shader
+
+    static const char* primitiveName(int type) {
+        switch (type) {
+            case sf::Points:        return "points";
+            case sf::Lines:         return "lines";
+            case sf::LineStrip:     return "line strips";
+            case sf::Triangles:     return "triangles";
+            case sf::TriangleStrip: return "triangle strips";
+            case sf::TriangleFan:   return "triangle fans";
+            case sf::Quads:         return "quads";
+        }
+        return "";
+    }
+};
+
+inline RenderStats operator-(const RenderStats& a, const RenderStats& b) {
+    RenderStats d;
+    d.drawCalls = a.drawCalls - b.drawCalls;
+    d.vertices = a.vertices - b.vertices;
+    for (int i = 0; i < RenderStats::PRIMITIVE_TYPES; ++i) {
+        d.primitives[i] = a.primitives[i] - b.primitives[i];
+    }
+    d.textDraws = a.textDraws - b.textDraws;
+    d.textureBinds = a.textureBinds - b.textureBinds;
+    d.stateChanges = a.stateChanges - b.stateChanges;
+    return d;
+}
+
+// Thin layer the visualizers draw through instead of the window directly. It
+// forwards to any render target (the window, or an offscreen texture for the
+// render benchmark) and counts the draw calls, vertices and primitive types each
+// draw produces. Texture binds and state changes follow SFML's own state cache:
+// a draw only costs one when its texture, blend mode or shader differs from the
+// previous draw's.
+class RenderContext {
+private:
+    sf::RenderTarget& target;
+    RenderStats stats;
+    bool haveLastStates = false;
+    sf::RenderStates lastStates;
+
+    void count(sf::PrimitiveType type, size_t vertexCount, const sf::RenderStates& states) {
+        stats.drawCalls++;
+        stats.vertices += vertexCount;
+        stats.primitives[type]++;
+        bool textureChanged = !haveLastStates || states.texture != lastStates.texture;
+        if (textureChanged && states.texture != nullptr) {
+            stats.textureBinds++;
+        }
+        if (textureChanged || states.blendMode != lastStates.blendMode ||
+            states.shader != lastStates.shader) {
+            stats.stateChanges++;
+        }
+        lastStates = states;
+        haveLastStates = true;
+    }
+
+public:
+    explicit RenderContext(sf::RenderTarget& renderTarget) : target(renderTarget) {}
+
+    // A shape is a triangle fan for the fill plus a strip for the outline
+    void draw(const sf::Shape& shape, const sf::RenderStates& states = sf::RenderStates::Default) {
+        size_t points = shape.getPointCount();
+        sf::RenderStates shapeStates = states;
+        shapeStates.texture = shape.getTexture();
+        count(sf::TriangleFan, points + 2, shapeStates);
+        if (shape.getOutlineThickness() != 0.f) {
+            shapeStates.texture = nullptr;
+            count(sf::TriangleStrip, (points + 1) * 2, shapeStates);
+        }
+        target.draw(shape, states);
+    }
+
+    // Six vertices per glyph quad, drawn from the font's page for this size
+    void draw(const sf::Text& text, const sf::RenderStates& states = sf::RenderStates::Default) {
+        size_t glyphs = text.getString().getSize();
+        if (glyphs > 0 && text.getFont() != nullptr) {
+            sf::RenderStates textStates = states;
+            textStates.texture = &text.getFont()->getTexture(text.getCharacterSize());
+            stats.textDraws++;
+            if (text.getOutlineThickness() != 0.f) {
+                count(sf::Triangles, glyphs * 6, textStates);
+            }
+            count(sf::Triangles, glyphs * 6, textStates);
+        }
+        target.draw(text, states);
+    }
+
+    void draw(const sf::VertexArray& vertices, const sf::RenderStates& states = sf::RenderStates::Default) {
+        if (vertices.getVertexCount() == 0) return;  // SFML skips these too
+        count(vertices.getPrimitiveType(), vertices.getVertexCount(), states);
+        target.draw(vertices, states);
+    }
+
+    void draw(const sf::Vertex* vertices, size_t vertexCount, sf::PrimitiveType type,
+              const sf::RenderStates& states = sf::RenderStates::Default) {
+        if (vertexCount == 0) return;
+        count(type, vertexCount, states);
+        target.draw(vertices, vertexCount, type, states);
+    }
+
+    const sf::View& getView() const { return target.getView(); }
+    sf::Vector2u getSize() const { return target.getSize(); }
+
+    const RenderStats& getStats() const { return stats; }
+    void resetStats() {
+        stats = RenderStats();
+        haveLastStates = false;  // clear() / display() may reset the target's cache
+    }
+};
 
 class Button {
 private:
@@ -60,7 +204,7 @@ public:
         pressedColor.a = alpha + 100 > 255 ? 255 : alpha + 100;
     }
 
-    void draw(sf::RenderWindow& window) {
+    void draw(RenderContext& window) {
         // Update button state colors
         if (isPressed) {
             shape.setFillColor(pressedColor);
@@ -102,6 +246,13 @@ public:
     void setAction(std::function<void()> newAction) {
         action = newAction;
     }
+
+    void setLabel(const std::string& label) {
+        text.setString(label);
+        sf::FloatRect textRect = text.getLocalBounds();
+        text.setOrigin(textRect.left + textRect.width/2.0f,
+                        textRect.top + textRect.height/2.0f);
+    }
 };
     
 class StartScreen {
@@ -247,6 +398,12 @@ private:
     sf::Text queueButtonText;
     sf::RectangleShape binarytreeButton;
     sf::Text binarytreeButtonText;
+    sf::RectangleShape complexityButton;
+    sf::Text complexityButtonText;
+    sf::RectangleShape compareButton;
+    sf::Text compareButtonText;
+    sf::RectangleShape matrixButton;
+    sf::Text matrixButtonText;
     sf::RectangleShape backButton;
     sf::Text backButtonText;
     sf::Texture backgroundTexture;
@@ -379,6 +536,54 @@ public:
         queueButtonText.setOrigin(stringTextBounds.width/2, stringTextBounds.height/2);
         queueButtonText.setPosition(window.getSize().x/2 + 325, 485);
 
+        // Set up complexity explorer button (left of the back button)
+        complexityButton.setSize(sf::Vector2f(290, 80));
+        complexityButton.setFillColor(sf::Color(100, 100, 0, 200));
+        complexityButton.setOutlineThickness(2);
+        complexityButton.setOutlineColor(sf::Color::White);
+        complexityButton.setPosition(window.getSize().x/2 - 450, 550);
+
+        complexityButtonText.setFont(font);
+        complexityButtonText.setString("Complexity Explorer");
+        complexityButtonText.setCharacterSize(26);
+        complexityButtonText.setFillColor(sf::Color::White);
+        sf::FloatRect complexityTextBounds = complexityButtonText.getLocalBounds();
+        complexityButtonText.setOrigin(complexityTextBounds.left + complexityTextBounds.width/2,
+                                       complexityTextBounds.top + complexityTextBounds.height/2);
+        complexityButtonText.setPosition(window.getSize().x/2 - 305, 590);
+
+        // Set up comparison button (right of the back button)
+        compareButton.setSize(sf::Vector2f(290, 80));
+        compareButton.setFillColor(sf::Color(100, 100, 0, 200));
+        compareButton.setOutlineThickness(2);
+        compareButton.setOutlineColor(sf::Color::White);
+        compareButton.setPosition(window.getSize().x/2 + 210, 550);
+
+        compareButtonText.setFont(font);
+        compareButtonText.setString("Array vs Linked List");
+        compareButtonText.setCharacterSize(26);
+        compareButtonText.setFillColor(sf::Color::White);
+        sf::FloatRect compareTextBounds = compareButtonText.getLocalBounds();
+        compareButtonText.setOrigin(compareTextBounds.left + compareTextBounds.width/2,
+                                    compareTextBounds.top + compareTextBounds.height/2);
+        compareButtonText.setPosition(window.getSize().x/2 + 355, 590);
+
+        // Set up matrix button (right of the string button)
+        matrixButton.setSize(sf::Vector2f(290, 80));
+        matrixButton.setFillColor(sf::Color(0, 100, 0, 200));
+        matrixButton.setOutlineThickness(2);
+        matrixButton.setOutlineColor(sf::Color::White);
+        matrixButton.setPosition(window.getSize().x/2 + 210, 250);
+
+        matrixButtonText.setFont(font);
+        matrixButtonText.setString("2D Matrix");
+        matrixButtonText.setCharacterSize(26);
+        matrixButtonText.setFillColor(sf::Color::White);
+        sf::FloatRect matrixTextBounds = matrixButtonText.getLocalBounds();
+        matrixButtonText.setOrigin(matrixTextBounds.left + matrixTextBounds.width/2,
+                                   matrixTextBounds.top + matrixTextBounds.height/2);
+        matrixButtonText.setPosition(window.getSize().x/2 + 355, 290);
+
         // Set up back button
         backButton.setSize(sf::Vector2f(350, 80));
         backButton.setFillColor(sf::Color(150, 0, 0, 200));
@@ -424,6 +629,9 @@ public:
                     sf::FloatRect binarytreeButtonBounds = binarytreeButton.getGlobalBounds();
                     sf::FloatRect stackButtonBounds = stackButton.getGlobalBounds();
                     sf::FloatRect queueButtonBounds = queueButton.getGlobalBounds();
+                    sf::FloatRect complexityButtonBounds = complexityButton.getGlobalBounds();
+                    sf::FloatRect compareButtonBounds = compareButton.getGlobalBounds();
+                    sf::FloatRect matrixButtonBounds = matrixButton.getGlobalBounds();
                     sf::FloatRect backButtonBounds = backButton.getGlobalBounds();
                     
                     if (arrayButtonBounds.contains(static_cast<sf::Vector2f>(mousePos))) {
@@ -444,6 +652,15 @@ public:
                     else if (binarytreeButtonBounds.contains(static_cast<sf::Vector2f>(mousePos))) {
                         selectedStructure = "binary-tree";
                     }
+                    else if (complexityButtonBounds.contains(static_cast<sf::Vector2f>(mousePos))) {
+                        selectedStructure = "complexity";
+                    }
+                    else if (compareButtonBounds.contains(static_cast<sf::Vector2f>(mousePos))) {
+                        selectedStructure = "compare";
+                    }
+                    else if (matrixButtonBounds.contains(static_cast<sf::Vector2f>(mousePos))) {
+                        selectedStructure = "matrix";
+                    }
                     else if (backButtonBounds.contains(static_cast<sf::Vector2f>(mousePos))) {
                         selectedStructure = "back";
                     }
@@ -469,6 +686,12 @@ public:
         window.draw(stackButtonText);
         window.draw(queueButton);
         window.draw(queueButtonText);
+        window.draw(complexityButton);
+        window.draw(complexityButtonText);
+        window.draw(compareButton);
+        window.draw(compareButtonText);
+        window.draw(matrixButton);
+        window.draw(matrixButtonText);
         window.draw(backButton);
         window.draw(backButtonText);
         window.display();
@@ -484,6 +707,16 @@ private:
     std::string inputString;
     bool isActive;
     int maxLength;
+    bool acceptsPaths = false;
+
+    // Long entries (file paths) show their end
+    void updateText() {
+        text.setString(inputString);
+        for (size_t skip = 1; skip < inputString.size() &&
+             text.getLocalBounds().width > shape.getSize().x - 20.f; ++skip) {
+            text.setString(inputString.substr(skip));
+        }
+    }
 
 public:
     TextInput(sf::Font& fontRef, sf::Vector2f position, sf::Vector2f size, 
@@ -530,18 +763,20 @@ public:
                 }
             }
             else if (event.text.unicode < 128 && inputString.size() < maxLength) {
-                // Allow letters, digits, and spaces
+                // Allow letters, digits, and spaces (and path punctuation if enabled)
                 if (isalpha(static_cast<char>(event.text.unicode)) || 
                 isdigit(static_cast<char>(event.text.unicode)) ||
-                event.text.unicode == ' ') {
+                event.text.unicode == ' ' ||
+                (acceptsPaths && event.text.unicode != 0 &&
+                 std::string("./\\_-:~").find(static_cast<char>(event.text.unicode)) != std::string::npos)) {
                     inputString += static_cast<char>(event.text.unicode);
                 }
             }
-            text.setString(inputString);
+            updateText();
         }
     }
 
-    void draw(sf::RenderWindow& window) {
+    void draw(RenderContext& window) {
         window.draw(label);
         window.draw(shape);
         window.draw(text);
@@ -549,456 +784,2577 @@ public:
 
     std::string getText() const { return inputString; }
     void clear() { inputString.clear(); text.setString(inputString); }
+    void allowPathCharacters() { acceptsPaths = true; }
     bool isEmpty() const { return inputString.empty(); }
 };
-    
-class ArrayVisualizer {
+
+// Render detail levels, from everything on down to one batched draw per structure.
+// Each tier also drops everything the tiers above it dropped.
+enum class QualityTier { Full, NoIndexLabels, NoOutlines, NoCellText, Aggregate };
+
+// Watches how long each frame's work takes against a budget and steps the
+// quality tier down under load and back up once there is headroom again.
+class QualityGovernor {
 private:
-    std::vector<int> array;
-    sf::Vector2f position;
-    float cellWidth;
-    float cellHeight;
-    sf::Font& font;
-    sf::Color defaultColor;
-    sf::Color highlightColor;
+    sf::Text hudText;
+    QualityTier tier = QualityTier::Full;
+    float budgetMs;
+    float smoothedMs = 0.f;
+    int framesSinceChange = 0;
 
-    std::vector<sf::Vector2f> currentPositions; // Actual drawn positions
-    std::vector<sf::Vector2f> cellPositions;    //  Target position
+    const float SMOOTHING = 0.1f;          // Weight of the newest frame
+    const float RESTORE_RATIO = 0.5f;      // Step up once under half the budget
+    const int DEGRADE_HOLD_FRAMES = 30;    // Let a change settle before the next one
+    const int RESTORE_HOLD_FRAMES = 120;
 
-    std::vector<size_t> highlightedIndices;
+public:
+    QualityGovernor(sf::Font& font, float frameBudgetMs = 16.6f)
+        : hudText("", font, 16), budgetMs(frameBudgetMs) {
+        hudText.setFillColor(sf::Color(200, 200, 200));
+    }
 
-    sf::Color insertingColor;    // Color for insertion
-    sf::Color removingColor;     // Color for removal
-    sf::Color searchingColor;    // Color for cells being searched
-    sf::Color foundColor;       // Color for found element
-    std::vector<float> foundBounce;  // For the found element bounce effect
+    // frameTime is the time spent on events, animation and drawing, i.e. without
+    // the framerate-limit sleep inside display().
+    void update(sf::Time frameTime) {
+        float ms = frameTime.asSeconds() * 1000.f;
+        smoothedMs += (ms - smoothedMs) * SMOOTHING;
+        framesSinceChange++;
+
+        if (smoothedMs > budgetMs && tier != QualityTier::Aggregate &&
+            framesSinceChange >= DEGRADE_HOLD_FRAMES) {
+            tier = static_cast<QualityTier>(static_cast<int>(tier) + 1);
+            framesSinceChange = 0;
+        } else if (smoothedMs < budgetMs * RESTORE_RATIO && tier != QualityTier::Full &&
+                   framesSinceChange >= RESTORE_HOLD_FRAMES) {
+            tier = static_cast<QualityTier>(static_cast<int>(tier) - 1);
+            framesSinceChange = 0;
+        }
+    }
 
-    Operation currentOperation = Operation::None;
+    QualityTier getTier() const { return tier; }
 
-    // Variables for update animation
-    bool updateAnimating = false;
-    size_t updateIndex = 0;
-    int oldValue = 0;
-    int newValue = 0;
-    float updateAnimationProgress = 0.f;
-    sf::Vector2f oldCellPosition;
-    sf::Vector2f newCellPosition;
+    static const char* tierName(QualityTier t) {
+        switch (t) {
+            case QualityTier::Full:          return "Full";
+            case QualityTier::NoIndexLabels: return "No index labels";
+            case QualityTier::NoOutlines:    return "No outlines";
+            case QualityTier::NoCellText:    return "No cell text";
+            case QualityTier::Aggregate:     return "Aggregate";
+        }
+        return "";
+    }
+
+    void drawHud(RenderContext& window) {
+        char buffer[96];
+        std::snprintf(buffer, sizeof(buffer), "Quality: %s  (%.1f / %.1f ms)",
+                      tierName(tier), smoothedMs, budgetMs);
+        hudText.setString(buffer);
+        hudText.setPosition(10.f, window.getSize().y - 26.f);
+        window.draw(hudText);
+    }
+};
+
+// Where a frame's animation step sits in the operation it belongs to: the
+// first step of an operation is its begin phase, the step that finishes it its
+// complete phase, everything in between its step phase.
+enum class OperationPhase { Idle, Begin, Step, Complete };
+
+class OperationPhaseTracker {
+private:
+    bool running = false;
 
 public:
-    float animationSpeed = 0.03f;
+    OperationPhase advance(bool wasAnimating, bool stillAnimating) {
+        if (!wasAnimating) {
+            return OperationPhase::Idle;
+        }
+        OperationPhase phase = !running ? OperationPhase::Begin
+                             : !stillAnimating ? OperationPhase::Complete
+                             : OperationPhase::Step;
+        running = stillAnimating;
+        return phase;
+    }
+
+    // Trace zone names
+    static const char* zoneName(OperationPhase phase) {
+        switch (phase) {
+            case OperationPhase::Idle:     return "animate";
+            case OperationPhase::Begin:    return "operation begin";
+            case OperationPhase::Step:     return "operation step";
+            case OperationPhase::Complete: return "operation complete";
+        }
+        return "";
+    }
+};
+
+// Heap allocations of one window: the last frame in total, split into the
+// animation step and the visualizer's draw, plus the begin / step / complete
+// phases of the current (or last) operation. Only drawn while tracking is on
+// (main --track-allocs).
+class AllocationHud {
+private:
+    sf::Text text;
+    core::AllocCounts frameStart, sectionStart;
+    core::AllocCounts frame, animate, drawn;
+    core::AllocCounts phases[3];    // Begin, step (summed over frames), complete
+
+    static std::string describe(const core::AllocCounts& counts) {
+        char buffer[48];
+        std::snprintf(buffer, sizeof(buffer), "%zu (%.1f KB)", counts.allocations, counts.bytes / 1024.0);
+        return buffer;
+    }
 
 public:
-    ArrayVisualizer(sf::Font& fontRef, sf::Vector2f pos, 
-                    float width , float height)
-        : font(fontRef), position(pos), cellWidth(width), cellHeight(height),
-        defaultColor(sf::Color(70, 130, 180)), // Steel blue
-        highlightColor(sf::Color(255, 165, 0)),  // Orange
-        searchingColor(sf::Color(100, 100, 255)), // Light blue (searching)
-        foundColor(sf::Color(0, 255, 0)),         // Bright green (found)
-        insertingColor(sf::Color(255, 255, 0, 175)),   // Yellow for insertion
-        removingColor(sf::Color(255, 215, 0, 175))     // Gold for removal
-    {
-        // Initialize with some sample data
-        array = {10, 20, 30, 40, 50};
-        updateCellPositions();
-        // Initialize current positions to match cell positions
-        currentPositions = cellPositions;
+    AllocationHud(sf::Font& font) : text("", font, 16) {
+        text.setFillColor(sf::Color(200, 200, 200));
     }
-    
-    const std::vector<int>& getArray() const { return array; }
 
-    void draw(sf::RenderWindow& window) {
-        for (size_t i = 0; i < array.size(); ++i) {
-            // Skip drawing the original cell if it's the one being updated and we're animating
-            if (updateAnimating && i == updateIndex) {
-                continue;
-            }
-            
-            float x = currentPositions[i].x;
-            float y = currentPositions[i].y;
-            
-            // Apply bounce effect if this is the found element
-            float bounceOffset = 0.0f;
-            if (i < foundBounce.size() && foundBounce[i] > 0) {
-                bounceOffset = -30.0f * foundBounce[i] * foundBounce[i];
-            }
-            
-            sf::RectangleShape cell(sf::Vector2f(cellWidth, cellHeight));
-            cell.setPosition(x, y + bounceOffset);
-            
-            // Determine cell color
-            if (std::find(highlightedIndices.begin(), highlightedIndices.end(), i) != highlightedIndices.end()) {
-                if (i < foundBounce.size() && foundBounce[i] > 0) {
-                    cell.setFillColor(foundColor);
-                } else if (currentOperation == Operation::Insert) {
-                    cell.setFillColor(insertingColor);
-                } else if (currentOperation == Operation::Remove) {
-                    cell.setFillColor(removingColor);
-                } else {
-                    cell.setFillColor(searchingColor);
-                }
-            } else {
-                cell.setFillColor(defaultColor);
+    void beginFrame() { frameStart = core::AllocTracker::snapshot(); }
+    void beginSection() { sectionStart = core::AllocTracker::snapshot(); }
+
+    // Closes the animation section and files it under the operation's phase
+    void endAnimate(OperationPhase phase) {
+        animate = core::AllocTracker::snapshot() - sectionStart;
+        switch (phase) {
+            case OperationPhase::Idle:
+                break;
+            case OperationPhase::Begin:
+                phases[1] = phases[2] = core::AllocCounts();
+                phases[0] = animate;
+                break;
+            case OperationPhase::Step:
+                phases[1] += animate;
+                break;
+            case OperationPhase::Complete:
+                phases[2] = animate;
+                break;
+        }
+    }
+
+    void endDraw() { drawn = core::AllocTracker::snapshot() - sectionStart; }
+    void endFrame() { frame = core::AllocTracker::snapshot() - frameStart; }
+
+    void draw(RenderContext& window) {
+        if (!core::AllocTracker::enabled()) return;
+        text.setString("Allocs/frame: " + describe(frame) + "  draw " + describe(drawn) +
+                       "  animate " + describe(animate) +
+                       "\nLast operation: begin " + describe(phases[0]) + "  step " + describe(phases[1]) +
+                       "  complete " + describe(phases[2]));
+        text.setPosition(10.f, window.getSize().y - 70.f);
+        window.draw(text);
+    }
+};
+
+// Draw-call accounting of one window: the last frame and the visualizer's
+// share of it. Draw it last and call endFrame() after it, so the frame it
+// shows counts every draw, the HUDs and panels (and its own text) included.
+// Only drawn with main --render-stats.
+class RenderStatsHud {
+private:
+    sf::Text text;
+    RenderStats visualizerStart, visualizerNow;
+    RenderStats frame, visualizer;      // Of the last complete frame
+
+public:
+    static inline bool enabled = false;
+
+    RenderStatsHud(sf::Font& font) : text("", font, 16) {
+        text.setFillColor(sf::Color(200, 200, 200));
+    }
+
+    void beginVisualizer(const RenderContext& context) { visualizerStart = context.getStats(); }
+    void endVisualizer(const RenderContext& context) { visualizerNow = context.getStats() - visualizerStart; }
+    void endFrame(const RenderContext& context) {
+        frame = context.getStats();
+        visualizer = visualizerNow;
+    }
+
+    void draw(RenderContext& window) {
+        if (!enabled) return;
+        char buffer[192];
+        std::snprintf(buffer, sizeof(buffer),
+                      "Draw calls: %zu (visualizer %zu)  vertices %zu  text %zu  "
+                      "texture binds %zu  state changes %zu\nPrimitives:",
+                      frame.drawCalls, visualizer.drawCalls, frame.vertices, frame.textDraws,
+                      frame.textureBinds, frame.stateChanges);
+        std::string lines = buffer;
+        for (int type = 0; type < RenderStats::PRIMITIVE_TYPES; ++type) {
+            if (frame.primitives[type] > 0) {
+                lines += "  " + std::string(RenderStats::primitiveName(type)) + " " +
+                         std::to_string(frame.primitives[type]);
             }
-            
-            cell.setOutlineThickness(2.f);
-            cell.setOutlineColor(sf::Color::Black);
-            window.draw(cell);
-            
-            // Draw text (position adjusted for bounce)
-            sf::Text indexText(std::to_string(i), font, 16);
-            indexText.setPosition(x + cellWidth/2 - indexText.getLocalBounds().width/2, 
-                                y + cellHeight + 5 + bounceOffset);
-            indexText.setFillColor(sf::Color::White);
-            window.draw(indexText);
-            
-            sf::Text valueText(std::to_string(array[i]), font, 20);
-            valueText.setPosition(x + cellWidth/2 - valueText.getLocalBounds().width/2, 
-                                y + cellHeight/2 - valueText.getLocalBounds().height/2 + bounceOffset);
-            valueText.setFillColor(sf::Color::White);
-            window.draw(valueText);
         }
-        
-        // Draw the updating cells if we're in an update animation
-        if (updateAnimating) {
-            // Draw the old cell sliding down (with old value)
-            sf::RectangleShape oldCell(sf::Vector2f(cellWidth, cellHeight));
-            oldCell.setPosition(oldCellPosition);
-            oldCell.setFillColor(removingColor);
-            oldCell.setOutlineThickness(2.f);
-            oldCell.setOutlineColor(sf::Color::Black);
-            window.draw(oldCell);
-            
-            sf::Text oldValueText(std::to_string(oldValue), font, 20);
-            oldValueText.setPosition(oldCellPosition.x + cellWidth/2 - oldValueText.getLocalBounds().width/2, 
-                                   oldCellPosition.y + cellHeight/2 - oldValueText.getLocalBounds().height/2);
-            oldValueText.setFillColor(sf::Color::White);
-            window.draw(oldValueText);
-            
-            // Draw the new cell coming down (with new value)
-            sf::RectangleShape newCell(sf::Vector2f(cellWidth, cellHeight));
-            newCell.setPosition(newCellPosition);
-            newCell.setFillColor(insertingColor);
-            newCell.setOutlineThickness(2.f);
-            newCell.setOutlineColor(sf::Color::Black);
-            window.draw(newCell);
-            
-            sf::Text newValueText(std::to_string(newValue), font, 20);
-            newValueText.setPosition(newCellPosition.x + cellWidth/2 - newValueText.getLocalBounds().width/2, 
-                                   newCellPosition.y + cellHeight/2 - newValueText.getLocalBounds().height/2);
-            newValueText.setFillColor(sf::Color::White);
-            window.draw(newValueText);
-            
-            // Draw index for both cells
-            sf::Text indexText(std::to_string(updateIndex), font, 16);
-            indexText.setPosition(oldCellPosition.x + cellWidth/2 - indexText.getLocalBounds().width/2, 
-                                oldCellPosition.y + cellHeight + 5);
-            indexText.setFillColor(sf::Color::White);
-            window.draw(indexText);
+        text.setString(lines);
+        text.setPosition(10.f, window.getSize().y - 114.f);
+        window.draw(text);
+    }
+};
+
+// Hardware counter deltas of the last native operation a visualizer ran, e.g.
+// the real linear scan behind a search animation. Falls back to a one-line
+// notice when counters cannot be opened.
+class CounterPanel {
+private:
+    core::PerfCounters counters;
+    sf::RectangleShape background;
+    sf::Text text;
+
+    static std::string withSeparators(long long value) {
+        std::string digits = std::to_string(value);
+        for (int i = static_cast<int>(digits.size()) - 3; i > 0; i -= 3) {
+            digits.insert(static_cast<size_t>(i), ",");
         }
+        return digits;
     }
 
-    void updateCellPositions() {
-        cellPositions.clear();
-        for (size_t i = 0; i < array.size(); ++i) {
-            cellPositions.emplace_back(
-                position.x + i * (cellWidth + 5.f),
-                position.y
-            );
+public:
+    CounterPanel(sf::Font& font, sf::Vector2f pos)
+        : background(sf::Vector2f(280.f, 150.f)), text("", font, 16) {
+        background.setPosition(pos);
+        background.setFillColor(sf::Color(50, 50, 50, 200));
+        background.setOutlineThickness(1.f);
+        background.setOutlineColor(sf::Color(120, 120, 120));
+        text.setPosition(pos.x + 10.f, pos.y + 8.f);
+        text.setFillColor(sf::Color(200, 200, 200));
+
+        if (counters.available()) {
+            text.setString("Hardware counters\n(run an operation)");
+        } else {
+            text.setString("Hardware counters unavailable\n" + counters.unavailableReason());
         }
-        currentPositions.resize(array.size());
     }
 
+    // Runs `body` under the counters and shows the result as `operation`
+    template <typename F>
+    void measure(const std::string& operation, size_t elements, F&& body) {
+        show(operation, elements, counters.measure(body));
+    }
 
-    void insert(int index, int value, bool& animationComplete) {
-        currentOperation = Operation::Insert;
-        static bool animating = false;
-        static size_t insertIndex = 0;
-        static std::vector<sf::Vector2f> startPositions;
-        
-        if (!animating) {
-            // Start insertion
-            if (index >= 0 && index <= array.size()) {
-                array.insert(array.begin() + index, value);
-                updateCellPositions();
-                
-                // Set start positions for animation
-                startPositions = cellPositions;
-                for (size_t i = 0; i < array.size(); i++) {
-                    if (i == index) {
-                        startPositions[i] = sf::Vector2f(cellPositions[i].x, cellPositions[i].y - 100);
-                    } else if (i > index) {
-                        startPositions[i] = sf::Vector2f(cellPositions[i].x - (cellWidth + 5), cellPositions[i].y);
-                    }
-                }
-                currentPositions = startPositions;
-                insertIndex = index;
-                animating = true;
-                animationComplete = false;
-                
-                // Highlight cells that will move (the inserted cell and all to its right)
-                highlightedIndices.clear();
-                for (size_t i = index; i < array.size(); ++i) {
-                    highlightedIndices.push_back(i);
-                }
-            }
+    // Shows a sample taken elsewhere, e.g. by a worker thread's own counters
+    void show(const std::string& operation, size_t elements, const core::CounterSample& sample) {
+        if (!sample.ok) return;
+
+        std::string lines = operation + " (" + std::to_string(elements) + " elements)";
+        for (int i = 0; i < core::COUNTER_COUNT; ++i) {
+            core::Counter c = static_cast<core::Counter>(i);
+            char label[32];
+            std::snprintf(label, sizeof(label), "\n%-14s ", core::PerfCounters::name(c));
+            lines += label;
+            lines += sample.has(c) ? withSeparators(sample.get(c)) : "n/a";
+        }
+        if (sample.has(core::Counter::Cycles) && sample.has(core::Counter::Instructions) &&
+            sample.get(core::Counter::Cycles) > 0) {
+            char ipc[32];
+            std::snprintf(ipc, sizeof(ipc), "\nIPC %.2f",
+                          double(sample.get(core::Counter::Instructions)) / sample.get(core::Counter::Cycles));
+            lines += ipc;
+        }
+        text.setString(lines);
+    }
+
+    void draw(RenderContext& window) {
+        window.draw(background);
+        window.draw(text);
+    }
+};
+
+// Wall time of the native operations behind a visualizer's animations, shown
+// per pane on the comparison screen. Single operations are short, so every
+// figure includes one clock read (tens of nanoseconds).
+class NativeCostMeter {
+private:
+    std::string lastOperation;
+    size_t lastElements = 0;
+    double lastNs = 0.0;
+    double totalNs = 0.0;
+    size_t operations = 0;
+
+public:
+    static std::string formatNs(double ns) {
+        char text[32];
+        if (ns < 1e3) {
+            std::snprintf(text, sizeof(text), "%.0f ns", ns);
+        } else if (ns < 1e6) {
+            std::snprintf(text, sizeof(text), "%.1f us", ns / 1e3);
+        } else if (ns < 1e9) {
+            std::snprintf(text, sizeof(text), "%.2f ms", ns / 1e6);
         } else {
-            // Animate insertion
-            bool allComplete = true;
-            for (size_t i = 0; i < array.size(); ++i) {
-                if (i >= insertIndex) {
-                    currentPositions[i] = currentPositions[i] + (cellPositions[i] - currentPositions[i]) * animationSpeed;
-                    
-                    float dx = cellPositions[i].x - currentPositions[i].x;
-                    float dy = cellPositions[i].y - currentPositions[i].y;
-                    float distanceSquared = dx*dx + dy*dy;
-                    
-                    if (distanceSquared >= 1.0f) {
-                        allComplete = false;
-                    } else {
-                        currentPositions[i] = cellPositions[i];
-                    }
-                }
-            }
-            
-            if (allComplete) {
-                animating = false;
-                animationComplete = true;
-                highlightedIndices.clear(); // Clear highlights when done
-            }
+            std::snprintf(text, sizeof(text), "%.2f s", ns / 1e9);
         }
+        return text;
     }
 
+    template <typename F>
+    void time(const std::string& operation, size_t elements, F&& body) {
+        auto start = std::chrono::steady_clock::now();
+        body();
+        auto end = std::chrono::steady_clock::now();
+        record(operation, elements, std::chrono::duration<double, std::nano>(end - start).count());
+    }
 
-    void remove(int index, bool& animationComplete) {
-        currentOperation = Operation::Remove;
-        static bool animating = false;
-        static size_t removeIndex = 0;
-        static std::vector<sf::Vector2f> startPositions;
-        static std::vector<sf::Vector2f> targetPositions;
-        static float animationProgress = 0.f;
-        static int removedValue = 0;
-        
-        const float shiftingSpeed = 0.03f;  
-    
-        if (!animating) {
-            // Start removal
-            if (index >= 0 && index < array.size()) {
+    // Adds a time measured elsewhere, e.g. on a worker thread
+    void record(const std::string& operation, size_t elements, double ns) {
+        lastNs = ns;
+        totalNs += lastNs;
+        ++operations;
+        lastOperation = operation;
+        lastElements = elements;
+    }
+
+    void reset() { *this = NativeCostMeter(); }
+    double total() const { return totalNs; }
+
+    std::string summary() const {
+        if (operations == 0) {
+            return "no operations yet";
+        }
+        return "last: " + lastOperation + " at n = " + std::to_string(lastElements) + " took " +
+               formatNs(lastNs) + "    total: " + formatNs(totalNs) + " over " +
+               std::to_string(operations) + " operations";
+    }
+};
+
+// Runs a native core operation, under the panel's counters and the meter's
+// clock when they are attached
+template <typename F>
+void countNative(CounterPanel* panel, NativeCostMeter* meter, const std::string& operation, size_t elements, F&& body) {
+    DSV_TRACE_ZONE("native operation");
+    auto run = [&] {
+        if (panel) {
+            panel->measure(operation, elements, body);
+        } else {
+            body();
+        }
+    };
+    if (meter) {
+        meter->time(operation, elements, run);
+    } else {
+        run();
+    }
+}
+
+// Generates a workload into a visualizer: a button cycling the workload kind,
+// count and seed inputs, and Generate. An empty seed draws a fresh one, which
+// is shown so the sequence can be reproduced.
+class WorkloadPanel {
+private:
+    Button kindButton;
+    TextInput countInput;
+    TextInput seedInput;
+    Button generateButton;
+    sf::Text info;
+    core::Workload kind = core::Workload::Uniform;
+    int maxValue;
+    std::function<bool(const std::vector<int>&)> onGenerate;
+
+    const size_t DEFAULT_COUNT = 16;
+
+    void generate() {
+        core::WorkloadSpec spec;
+        spec.kind = kind;
+        spec.count = countInput.isEmpty() ? DEFAULT_COUNT : std::strtoul(countInput.getText().c_str(), nullptr, 10);
+        spec.seed = seedInput.isEmpty() ? std::random_device()() : std::strtoull(seedInput.getText().c_str(), nullptr, 10);
+        // Two-digit values while every cell still shows its number
+        spec.maxValue = maxValue > 0 ? maxValue : static_cast<int>(std::max<size_t>(99, 4 * spec.count));
+        // The visualizer may refuse while it is busy
+        if (!onGenerate || !onGenerate(core::generateWorkload(spec))) {
+            return;
+        }
+        info.setString("Generated " + std::to_string(spec.count) + " " + core::workloadName(kind) +
+                       " values, seed " + std::to_string(spec.seed));
+    }
+
+public:
+    // maxValue 0 scales the value range with the count
+    WorkloadPanel(sf::Font& font, sf::Vector2f pos, int maxValueLimit = 0)
+        : kindButton("Workload: uniform", font, pos, {290.f, 36.f}, sf::Color(0, 0, 100, 200)),
+          countInput(font, {pos.x, pos.y + 80.f}, {80.f, 36.f}, "Count:", 6),
+          seedInput(font, {pos.x + 95.f, pos.y + 80.f}, {90.f, 36.f}, "Seed:", 9),
+          generateButton("Generate", font, {pos.x + 200.f, pos.y + 80.f}, {90.f, 36.f}, sf::Color(0, 100, 0, 200)),
+          info("", font, 14),
+          maxValue(maxValueLimit) {
+        info.setPosition(pos.x, pos.y + 122.f);
+        info.setFillColor(sf::Color(200, 200, 200));
+        kindButton.setAction([this]() {
+            kind = static_cast<core::Workload>((static_cast<int>(kind) + 1) % core::WORKLOAD_COUNT);
+            kindButton.setLabel(std::string("Workload: ") + core::workloadName(kind));
+        });
+        generateButton.setAction([this]() { generate(); });
+    }
+
+    // The action returns whether it loaded the values
+    void setAction(std::function<bool(const std::vector<int>&)> action) { onGenerate = std::move(action); }
+
+    void handleEvent(const sf::Event& event, const sf::RenderWindow& window) {
+        kindButton.handleEvent(event, window);
+        countInput.handleEvent(event, window);
+        seedInput.handleEvent(event, window);
+        generateButton.handleEvent(event, window);
+    }
+
+    void draw(RenderContext& window) {
+        kindButton.draw(window);
+        countInput.draw(window);
+        seedInput.draw(window);
+        generateButton.draw(window);
+        window.draw(info);
+    }
+};
+
+// Feeds a visualizer from a core::StreamProducer: a file, a named pipe or (with
+// no path) a seeded generator pushing into a bounded ring at a set rate. The
+// frame loop takes values with next(); the panel shows how full the ring is,
+// drops, producer stalls and the latency from arrival to the displayed frame.
+class StreamPanel {
+private:
+    TextInput sourceInput;
+    TextInput rateInput;
+    TextInput capacityInput;
+    Button overflowButton;
+    Button startButton;
+    sf::Text info;
+    std::unique_ptr<core::StreamProducer> producer;
+    core::StreamOverflow overflow = core::StreamOverflow::Block;
+
+    std::vector<uint64_t> shownThisFrame;   // Arrival times of values first drawn this frame
+    uint64_t rendered = 0;
+    double lastLatencyMs = 0;
+    double maxLatencyMs = 0;
+    double totalLatencyMs = 0;
+
+    const double DEFAULT_RATE = 20.0;
+    const size_t DEFAULT_CAPACITY = 64;
+
+    void start() {
+        core::StreamConfig config;
+        config.path = sourceInput.getText();
+        config.rate = rateInput.isEmpty() ? DEFAULT_RATE : std::strtod(rateInput.getText().c_str(), nullptr);
+        config.capacity = capacityInput.isEmpty() ? DEFAULT_CAPACITY
+                                                  : std::strtoul(capacityInput.getText().c_str(), nullptr, 10);
+        config.overflow = overflow;
+        config.seed = std::random_device()();
+        producer.reset(new core::StreamProducer(config));
+        producer->start();
+        rendered = 0;
+        lastLatencyMs = maxLatencyMs = totalLatencyMs = 0;
+        startButton.setLabel("Stop stream");
+    }
+
+    void stop() {
+        producer.reset();
+        startButton.setLabel("Start stream");
+    }
+
+    static std::string formatMs(double ms) {
+        char buffer[32];
+        std::snprintf(buffer, sizeof(buffer), "%.1f ms", ms);
+        return buffer;
+    }
+
+public:
+    StreamPanel(sf::Font& font, sf::Vector2f pos)
+        : sourceInput(font, pos, {290.f, 36.f}, "Stream from (empty: generator):", 260),
+          rateInput(font, {pos.x, pos.y + 70.f}, {80.f, 36.f}, "Rate/s:", 6),
+          capacityInput(font, {pos.x + 95.f, pos.y + 70.f}, {90.f, 36.f}, "Buffer:", 6),
+          overflowButton("Full: block", font, {pos.x + 200.f, pos.y + 70.f}, {90.f, 36.f}, sf::Color(0, 0, 100, 200)),
+          startButton("Start stream", font, {pos.x, pos.y + 120.f}, {290.f, 36.f}, sf::Color(0, 100, 0, 200)),
+          info("", font, 14) {
+        sourceInput.allowPathCharacters();
+        info.setPosition(pos.x, pos.y + 162.f);
+        info.setFillColor(sf::Color(200, 200, 200));
+        overflowButton.setAction([this]() {
+            overflow = overflow == core::StreamOverflow::Block ? core::StreamOverflow::Drop
+                                                                : core::StreamOverflow::Block;
+            overflowButton.setLabel(overflow == core::StreamOverflow::Block ? "Full: block" : "Full: drop");
+        });
+        startButton.setAction([this]() {
+            if (running()) {
+                stop();
+            } else {
+                start();
+            }
+        });
+    }
+
+    // Until stopped, or the source has ended and every value was taken
+    bool running() const {
+        return producer && !(producer->finished() && producer->buffered() == 0);
+    }
+
+    bool next(core::StreamItem& item) { return producer && producer->pop(item); }
+
+    // The value that arrived at `arrivalNs` is drawn for the first time this frame
+    void markShown(uint64_t arrivalNs) { shownThisFrame.push_back(arrivalNs); }
+
+    // Call right after window.display()
+    void frameDisplayed() {
+        if (shownThisFrame.empty()) return;
+        uint64_t now = core::streamClockNs();
+        for (uint64_t arrival : shownThisFrame) {
+            lastLatencyMs = (now - arrival) / 1e6;
+            maxLatencyMs = std::max(maxLatencyMs, lastLatencyMs);
+            totalLatencyMs += lastLatencyMs;
+            ++rendered;
+        }
+        shownThisFrame.clear();
+    }
+
+    void handleEvent(const sf::Event& event, const sf::RenderWindow& window) {
+        sourceInput.handleEvent(event, window);
+        rateInput.handleEvent(event, window);
+        capacityInput.handleEvent(event, window);
+        overflowButton.handleEvent(event, window);
+        startButton.handleEvent(event, window);
+    }
+
+    void draw(RenderContext& window) {
+        if (producer) {
+            core::StreamStats stats = producer->stats();
+            std::string status;
+            if (!running()) {
+                status = producer->getError().empty() ? "Source ended" : producer->getError();
+                startButton.setLabel("Start stream");
+            } else {
+                status = "Buffer " + std::to_string(producer->buffered()) + "/" +
+                         std::to_string(producer->capacity());
+            }
+            status += "\nArrived " + std::to_string(stats.arrived) + ", rendered " + std::to_string(rendered) +
+                      ", dropped " + std::to_string(stats.dropped) +
+                      "\nProducer blocked " + std::to_string(stats.stalls) + "x, " + formatMs(stats.blockedNs / 1e6);
+            if (stats.rejected > 0) {
+                status += "\nSkipped " + std::to_string(stats.rejected) + " out of the 32-bit range";
+            }
+            if (rendered > 0) {
+                status += "\nLatency " + formatMs(lastLatencyMs) + ", mean " +
+                          formatMs(totalLatencyMs / rendered) + ", max " + formatMs(maxLatencyMs);
+            }
+            info.setString(status);
+        }
+
+        sourceInput.draw(window);
+        rateInput.draw(window);
+        capacityInput.draw(window);
+        overflowButton.draw(window);
+        startButton.draw(window);
+        if (producer) window.draw(info);
+    }
+};
+
+// F9 writes the zones recorded so far to trace.json, for Perfetto or
+// chrome://tracing. Only builds with DSV_TRACE (make TRACE=1) record zones.
+inline void handleTraceKey(const sf::Event& event) {
+#ifdef DSV_TRACE
+    if (event.type == sf::Event::KeyPressed && event.key.code == sf::Keyboard::F9) {
+        if (core::Trace::writeChromeJson("trace.json")) {
+            std::cout << "Wrote " << core::Trace::recordedZones() << " trace zones to trace.json\n";
+        } else {
+            std::cerr << "Cannot write trace.json\n";
+        }
+    }
+#else
+    (void)event;
+#endif
+}
+
+// Keeps a visualizer's contents in <structure>.dsvsnap between sessions: the
+// snapshot is restored when the visualizer opens and written when it closes.
+// F5 saves and F6 reloads, both only while no operation is running.
+class SnapshotSlot {
+public:
+    using Save = std::function<bool(const std::string& path, std::string& error)>;
+    using Restore = std::function<void(const core::SnapshotReader& snapshot)>;
+
+    SnapshotSlot(const std::string& structure, Save save, Restore restore)
+        : structure(structure), path(structure + ".dsvsnap"), saveTo(save), restoreFrom(restore) {}
+
+    // A missing snapshot is not an error; the visualizer keeps its sample data
+    void restore() {
+        if (std::FILE* file = std::fopen(path.c_str(), "rb")) {
+            std::fclose(file);
+            reload();
+        }
+    }
+
+    bool save() {
+        std::string error;
+        if (!saveTo(path, error)) {
+            std::cerr << error << "\n";
+            return false;
+        }
+        return true;
+    }
+
+    void reload() {
+        core::SnapshotReader snapshot;
+        std::string error;
+        if (!snapshot.open(path, error)) {
+            std::cerr << error << "\n";
+        } else if (snapshot.structure() != structure) {
+            std::cerr << path << " holds " << snapshot.structure() << " data\n";
+        } else {
+            restoreFrom(snapshot);
+        }
+    }
+
+    void handleEvent(const sf::Event& event, bool idle) {
+        if (event.type != sf::Event::KeyPressed || !idle) return;
+        if (event.key.code == sf::Keyboard::F5) {
+            if (save()) std::cout << "Saved " << path << "\n";
+        } else if (event.key.code == sf::Keyboard::F6) {
+            reload();
+        }
+    }
+
+private:
+    std::string structure;
+    std::string path;
+    Save saveTo;
+    Restore restoreFrom;
+};
+
+// Cells an operation touches, as the index range [first, last), and whether it
+// changes them. Two operations conflict when their ranges overlap and at least
+// one of them writes.
+struct AnimationRegion {
+    size_t first;
+    size_t last;
+    bool writes;
+
+    static constexpr size_t END = std::numeric_limits<size_t>::max();
+
+    bool conflictsWith(const AnimationRegion& other) const {
+        return first < other.last && other.first < last && (writes || other.writes);
+    }
+};
+
+// Runs every submitted operation on its own animation track. Operations whose
+// regions don't conflict animate side by side; one that conflicts waits until
+// every earlier operation it overlaps has finished.
+class AnimationTracks {
+public:
+    // Called once per frame with the track id until it sets animationComplete
+    using Step = std::function<void(int track, bool& animationComplete)>;
+
+private:
+    struct Track {
+        int id;
+        AnimationRegion region;
+        Step step;
+        bool complete;
+    };
+    std::vector<Track> active;
+    std::deque<Track> pending;
+    int nextId = 0;
+
+    bool canStart(size_t pendingIndex) const {
+        const AnimationRegion& region = pending[pendingIndex].region;
+        for (const Track& track : active) {
+            if (track.region.conflictsWith(region)) return false;
+        }
+        // Keep overlapping operations in submission order
+        for (size_t i = 0; i < pendingIndex; ++i) {
+            if (pending[i].region.conflictsWith(region)) return false;
+        }
+        return true;
+    }
+
+    void promote() {
+        for (size_t i = 0; i < pending.size();) {
+            if (canStart(i)) {
+                active.push_back(std::move(pending[i]));
+                pending.erase(pending.begin() + i);
+            } else {
+                ++i;
+            }
+        }
+    }
+
+public:
+    void submit(AnimationRegion region, Step step) {
+        pending.push_back(Track{nextId++, region, std::move(step), false});
+        promote();
+    }
+
+    void update() {
+        for (Track& track : active) {
+            track.step(track.id, track.complete);
+        }
+        active.erase(std::remove_if(active.begin(), active.end(),
+                                    [](const Track& track) { return track.complete; }),
+                     active.end());
+        promote();
+    }
+
+    bool busy() const { return !active.empty() || !pending.empty(); }
+    size_t runningCount() const { return active.size(); }
+    size_t waitingCount() const { return pending.size(); }
+};
+
+inline void appendQuad(sf::VertexArray& vertices, sf::Vector2f pos, sf::Vector2f size, sf::Color color) {
+    vertices.append(sf::Vertex(pos, color));
+    vertices.append(sf::Vertex(sf::Vector2f(pos.x + size.x, pos.y), color));
+    vertices.append(sf::Vertex(pos + size, color));
+    vertices.append(sf::Vertex(sf::Vector2f(pos.x, pos.y + size.y), color));
+}
+
+// A contiguous run of cells that slides as one unit (e.g. the suffix shifted by
+// an insert or remove). The cell quads are baked once when the move starts and
+// every frame only the translation changes, so the whole run is a single draw.
+class CellBlock {
+private:
+    sf::VertexArray vertices;
+    size_t first = 0;   // First cell index in the block
+    size_t last = 0;    // One past the last cell index in the block
+    sf::Vector2f offset;
+    bool active = false;
+
+public:
+    CellBlock() : vertices(sf::Quads) {}
+
+private:
+    template <typename PositionOf>
+    void bake(PositionOf positionOf, size_t blockFirst, size_t blockLast,
+              size_t bakeFirst, size_t bakeLast, sf::Vector2f cellSize,
+              sf::Color fillColor, sf::Vector2f startOffset) {
+        vertices.clear();
+        first = blockFirst;
+        last = blockLast;
+        offset = startOffset;
+        active = first < last;
+
+        const float outline = 2.f;
+        for (size_t i = std::max(bakeFirst, first); i < std::min(bakeLast, last); ++i) {
+            sf::Vector2f cell = positionOf(i);
+            appendQuad(vertices, cell - sf::Vector2f(outline, outline),
+                       cellSize + sf::Vector2f(2 * outline, 2 * outline), sf::Color::Black);
+            appendQuad(vertices, cell, cellSize, fillColor);
+        }
+    }
+
+public:
+    // Bake cells [bakeFirst, bakeLast) of the block [blockFirst, blockLast).
+    // Only the baked cells are drawn, so callers pass the visible part.
+    void build(const std::vector<sf::Vector2f>& positions, size_t blockFirst, size_t blockLast,
+               size_t bakeFirst, size_t bakeLast, sf::Vector2f cellSize,
+               sf::Color fillColor, sf::Vector2f startOffset) {
+        bake([&positions](size_t i) { return positions[i]; }, blockFirst, blockLast,
+             bakeFirst, bakeLast, cellSize, fillColor, startOffset);
+    }
+
+    // Same for a row with no position table: cell i sits at positionOf(i)
+    void build(std::function<sf::Vector2f(size_t)> positionOf, size_t blockFirst, size_t blockLast,
+               size_t bakeFirst, size_t bakeLast, sf::Vector2f cellSize,
+               sf::Color fillColor, sf::Vector2f startOffset) {
+        bake(positionOf, blockFirst, blockLast, bakeFirst, bakeLast, cellSize, fillColor, startOffset);
+    }
+
+    void clear() {
+        vertices.clear();
+        first = last = 0;
+        offset = sf::Vector2f(0.f, 0.f);
+        active = false;
+    }
+
+    bool isActive() const { return active; }
+    bool contains(size_t i) const { return active && i >= first && i < last; }
+    sf::Vector2f getOffset() const { return offset; }
+    void setOffset(sf::Vector2f newOffset) { offset = newOffset; }
+
+    void draw(RenderContext& window) const {
+        if (!active) return;
+        sf::RenderStates states;
+        states.transform.translate(offset);
+        window.draw(vertices, states);
+    }
+};
+
+// Index range [first, last) of a row of cells that can fall inside [left, right].
+// Cells never stray more than one stride from their slot while animating, so
+// one stride of slack on either side is enough.
+inline void visibleCellRange(float left, float right, float originX, float stride,
+                             size_t count, size_t& first, size_t& last) {
+    float lo = std::floor((left - originX) / stride) - 1.f;
+    float hi = std::ceil((right - originX) / stride) + 2.f;
+
+    first = lo <= 0.f ? 0 : std::min(count, static_cast<size_t>(lo));
+    last = hi <= 0.f ? 0 : std::min(count, static_cast<size_t>(hi));
+}
+
+// Latency of each operation in a stream (e.g. every append to an array): a
+// bar per operation on a log scale, the slow path (a reallocation) in its own
+// colour, and the running mean over the whole stream as a line, so the spikes
+// and the amortized cost show together. Keeps the latest MAX_SAMPLES bars.
+class LatencyPlot {
+private:
+    struct Sample {
+        double ns;
+        double meanNs;      // Over every operation up to this one
+        bool slow;
+    };
+
+    sf::Font& font;
+    sf::FloatRect area;
+    std::string operation;      // What one sample is, e.g. "append"
+    std::string slowName;       // What its slow path is, e.g. "reallocating"
+    std::deque<Sample> samples;
+    size_t count = 0;
+    size_t slowCount = 0;
+    double totalNs = 0.0;
+    double worstNs = 0.0;
+
+    static constexpr size_t MAX_SAMPLES = 256;
+    const sf::Color FAST_COLOR = sf::Color(70, 130, 180);
+    const sf::Color SLOW_COLOR = sf::Color(255, 165, 0);
+    const sf::Color MEAN_COLOR = sf::Color(120, 220, 80);
+
+    void drawText(RenderContext& window, const std::string& string, sf::Vector2f pos, sf::Color color) {
+        sf::Text text(string, font, 12);
+        text.setFillColor(color);
+        text.setPosition(pos);
+        window.draw(text);
+    }
+
+public:
+    LatencyPlot(sf::Font& fontRef, sf::FloatRect plotArea, std::string operationName, std::string slowPathName)
+        : font(fontRef), area(plotArea), operation(std::move(operationName)), slowName(std::move(slowPathName)) {}
+
+    void record(double ns, bool slow) {
+        ++count;
+        slowCount += slow ? 1 : 0;
+        totalNs += ns;
+        worstNs = std::max(worstNs, ns);
+        samples.push_back({ns, totalNs / count, slow});
+        if (samples.size() > MAX_SAMPLES) {
+            samples.pop_front();
+        }
+    }
+
+    void clear() {
+        samples.clear();
+        count = slowCount = 0;
+        totalNs = worstNs = 0.0;
+    }
+
+    bool empty() const { return count == 0; }
+
+    void draw(RenderContext& window) {
+        sf::RectangleShape frame(sf::Vector2f(area.width, area.height));
+        frame.setPosition(area.left, area.top);
+        frame.setFillColor(sf::Color(40, 40, 40));
+        frame.setOutlineThickness(1.f);
+        frame.setOutlineColor(sf::Color(120, 120, 120));
+        window.draw(frame);
+        if (samples.empty()) return;
+
+        // Whole decades around the samples in view
+        double low = samples.front().ns, high = low;
+        for (const Sample& sample : samples) {
+            low = std::min(low, std::max(sample.ns, 1.0));
+            high = std::max(high, sample.ns);
+        }
+        double yMin = std::floor(std::log10(std::max(low, 1.0)));
+        double yMax = std::max(yMin + 1.0, std::ceil(std::log10(std::max(high, 1.0))));
+        auto toY = [&](double ns) {
+            double y = (std::log10(std::max(ns, 1.0)) - yMin) / (yMax - yMin);
+            return area.top + area.height - static_cast<float>(std::max(0.0, std::min(1.0, y))) * area.height;
+        };
+
+        float barWidth = area.width / MAX_SAMPLES;
+        sf::VertexArray bars(sf::Quads);
+        sf::VertexArray mean(sf::LineStrip);
+        for (size_t i = 0; i < samples.size(); ++i) {
+            float x = area.left + i * barWidth;
+            float top = toY(samples[i].ns);
+            appendQuad(bars, sf::Vector2f(x, top), sf::Vector2f(std::max(1.f, barWidth - 0.5f), area.top + area.height - top),
+                       samples[i].slow ? SLOW_COLOR : FAST_COLOR);
+            mean.append(sf::Vertex(sf::Vector2f(x + barWidth / 2.f, toY(samples[i].meanNs)), MEAN_COLOR));
+        }
+        window.draw(bars);
+        window.draw(mean);
+
+        sf::Color labelColor(180, 180, 180);
+        drawText(window, NativeCostMeter::formatNs(std::pow(10.0, yMax)), {area.left - 52.f, area.top - 2.f}, labelColor);
+        drawText(window, NativeCostMeter::formatNs(std::pow(10.0, yMin)), {area.left - 52.f, area.top + area.height - 14.f},
+                 labelColor);
+        drawText(window, std::to_string(count) + " " + operation + "s: amortized " + NativeCostMeter::formatNs(totalNs / count) +
+                     ", " + std::to_string(slowCount) + " " + slowName + ", worst " + NativeCostMeter::formatNs(worstNs),
+                 {area.left, area.top + area.height + 2.f}, MEAN_COLOR);
+    }
+};
+
+class ArrayVisualizer {
+private:
+    core::Array array;
+    sf::Vector2f position;
+    float cellWidth;
+    float cellHeight;
+    sf::Font& font;
+    sf::Color defaultColor;
+    sf::Color highlightColor;
+
+    // Layout is worked out from the index for the cells drawn: cell i sits at
+    // position.x + i * (cellWidth + 5), so an imported array of 100M values
+    // costs no per-element positions. The few cells an animation moves off
+    // their slot carry an offset here; a reallocation's moving cells follow
+    // growOffset() instead.
+    std::vector<std::pair<size_t, sf::Vector2f>> displaced;
+
+    std::vector<size_t> highlightedIndices;
+
+    sf::Color insertingColor;    // Color for insertion
+    sf::Color removingColor;     // Color for removal
+    sf::Color searchingColor;    // Color for cells being searched
+    sf::Color foundColor;       // Color for found element
+    sf::Color excludedColor;    // Cells a sorted search has ruled out
+
+    Operation currentOperation = Operation::None;
+
+    // State of one in-flight search. Searches only read, so several can run
+    // at once, each keyed by its animation track.
+    struct SearchTrack {
+        bool animating = false;
+        size_t currentIndex = 0;
+        int foundIndex = -1;
+        float progress = 0.f;
+        float foundHoldTime = 0.f;
+        float bounce = 0.f;         // For the found element bounce effect
+
+        // Searches of a sorted array step through their recorded probes instead
+        bool sorted = false;
+        std::vector<core::SearchProbe> probes;
+        size_t probeIndex = 0;
+        size_t result = core::npos;
+    };
+    std::map<int, SearchTrack> searchTracks;
+
+    // State of one in-flight value update, keyed by its animation track
+    struct UpdateTrack {
+        size_t index = 0;
+        int oldValue = 0;
+        int newValue = 0;
+        float progress = 0.f;
+        sf::Vector2f oldCellPosition;
+        sf::Vector2f newCellPosition;
+    };
+    std::map<int, UpdateTrack> updateTracks;
+
+    // Replay of a traced sort: the steps apply to the shown array in order,
+    // with the indices of the latest one lit in its kind's color
+    bool sorting = false;
+    std::vector<core::SortStep> sortSteps;
+    size_t sortNext = 0;
+    float sortProgress = 0.f;
+    float sortStepsPerFrame = 1.f;
+    core::SortStep::Kind sortKind = core::SortStep::Compare;
+    std::vector<int> sortResult;
+    core::SortStats sortShown;      // Counted up as the replay goes
+    std::string sortHeading;        // Algorithm and size of the last sort
+    std::string sortTiming;         // Its native times, or why it was refused
+
+    // A serial sort's native runs, measured on a worker
+    struct SortMeasurement {
+        std::string timing;             // Native times, or why the sort was refused
+        size_t elements = 0;
+        core::CounterSample counters;   // Of one native run
+        double ns = 0;                  // Its wall time
+        std::vector<int> result;        // Large arrays: sorted under the counting observer
+        core::SortStats total;
+    };
+    std::future<SortMeasurement> sortMeasuring;
+    bool sortWaiting = false;       // A large sort is waiting on sortMeasuring for its values
+
+    // Replay of a parallel sort: each thread's current range is a lane above
+    // the cells, and a range shows its values when its task finishes
+    bool sortParallel = false;      // The last sort was a parallel one
+    std::vector<core::ParallelSortEvent> parallelEvents;
+    std::vector<std::pair<size_t, size_t>> lanes;   // [lo, hi) per thread; empty while idle
+    std::string scalingText;        // Speedup per thread count and native times
+    std::future<std::string> scalingTiming;     // The same, still being measured
+
+    // Replay of a traced scan, like a sort's. While a blelloch scan sweeps
+    // its tree, the level in progress is drawn as brackets joining the pairs
+    // it adds.
+    bool scanning = false;
+    core::ScanMethod scanMethod = core::ScanMethod::Sequential;
+    std::vector<core::ScanStep> scanSteps;
+    size_t scanNext = 0;
+    float scanProgress = 0.f;
+    float scanStepsPerFrame = 1.f;
+    core::ScanStep scanCurrent{};   // The step applied last
+    std::vector<int> scanResult;
+    std::string scanHeading;        // Method, kind and size of the last scan
+    std::string scanTiming;         // Native throughput of every method against memcpy
+    std::future<std::string> scanTimingInFlight;
+
+    // Which report the last operation left: a sort's, a scan's, a sorted
+    // search's or the capacity view's
+    enum class Report { Sort, Scan, Search, Capacity };
+    Report lastReport = Report::Sort;
+    std::string searchReport;
+
+    // Capacity view: the slots past size() are outlined, and a growth that
+    // reallocates plays out: the elements are copied one by one into the new
+    // buffer below, the old buffer is freed and the new one moves up into
+    // its place, then an appended value drops into its slot
+    enum class GrowPhase { Idle, Copy, Free, Settle, Drop };
+    GrowPhase growPhase = GrowPhase::Idle;
+    size_t oldCapacity = 0;         // Of the buffer being copied out of
+    size_t copyCount = 0;           // Elements moving to the new buffer
+    float copied = 0.f;             // How many have arrived; the fraction is in flight
+    float growProgress = 0.f;       // Through Free, then Settle
+    bool growAppends = false;       // An appended value drops in after the move
+    std::string capacityReport;     // What the last append or reserve did
+
+    static sf::Color laneColor(size_t thread) {
+        static const sf::Color palette[] = {
+            sf::Color(230, 25, 75), sf::Color(60, 180, 75), sf::Color(255, 225, 25), sf::Color(0, 130, 200),
+            sf::Color(245, 130, 48), sf::Color(145, 30, 180), sf::Color(70, 240, 240), sf::Color(240, 50, 230)};
+        return palette[thread % 8];
+    }
+
+    // Cells shifted together by insert/remove
+    CellBlock shiftBlock;
+    float viewLeft = 0.f;       // Horizontal extent of the view at the last draw
+    float viewRight = 1200.f;
+
+    sf::VertexArray aggregateBatch{sf::Quads};  // Cells batched at QualityTier::Aggregate
+
+    float bounceAt(size_t i) const {
+        float bounce = 0.f;
+        for (const auto& entry : searchTracks) {
+            if (entry.second.foundIndex == static_cast<int>(i)) {
+                bounce = std::max(bounce, entry.second.bounce);
+            }
+        }
+        return bounce;
+    }
+
+    bool isUpdating(size_t i) const {
+        for (const auto& entry : updateTracks) {
+            if (entry.second.index == i) return true;
+        }
+        return false;
+    }
+
+    sf::Color cellColor(size_t i) const {
+        for (const auto& entry : searchTracks) {
+            const SearchTrack& search = entry.second;
+            if (search.foundIndex == static_cast<int>(i) && search.bounce > 0) {
+                return foundColor;
+            }
+            if (search.sorted && search.animating && search.foundIndex == -1 &&
+                search.probeIndex < search.probes.size()) {
+                const core::SearchProbe& probe = search.probes[search.probeIndex];
+                if (probe.probe == i) return searchingColor;
+                if (i < probe.lo || i > probe.hi) return excludedColor;
+            } else if (search.animating && search.foundIndex == -1 && search.currentIndex == i) {
+                return searchingColor;
+            }
+        }
+        if (std::find(highlightedIndices.begin(), highlightedIndices.end(), i) == highlightedIndices.end()) {
+            return defaultColor;
+        }
+        if (currentOperation == Operation::Sort) {
+            if (sortKind == core::SortStep::Swap) return highlightColor;
+            if (sortKind == core::SortStep::Write) return insertingColor;
+            return searchingColor;
+        }
+        if (currentOperation == Operation::Insert) {
+            return insertingColor;
+        } else if (currentOperation == Operation::Remove) {
+            return removingColor;
+        }
+        return searchingColor;
+    }
+
+public:
+    float animationSpeed = 0.03f;
+    QualityTier quality = QualityTier::Full;
+    CounterPanel* counterPanel = nullptr;  // Optional hardware counter readout
+    NativeCostMeter* costMeter = nullptr;  // Optional native timing (comparison screen)
+    LatencyPlot* appendPlot = nullptr;     // Optional latency of every append
+    bool showCapacity = false;             // Outline spare capacity, animate reallocations
+
+    // Arrays up to this size replay their sort step by step; larger ones
+    // are sorted at once and only report the counts
+    static constexpr size_t SORT_ANIMATE_LIMIT = 256;
+    // Longest replay in frames; long traces apply several steps a frame
+    static constexpr float SORT_MAX_FRAMES = 60.f * 20.f;
+    // Threads, and so lanes, in an animated parallel sort
+    static constexpr size_t MAX_SORT_LANES = 8;
+    // Lookups each sorted search mode is timed on
+    static constexpr size_t SEARCH_TIMING_LOOKUPS = 1 << 16;
+    // Scans are timed on at least this many elements (64 MB), past the caches
+    static constexpr size_t SCAN_TIMING_ELEMENTS = size_t(1) << 24;
+    // How far below the array a reallocation draws the new buffer
+    static constexpr float NEW_BUFFER_OFFSET = 95.f;
+    // Longest copy into a new buffer in frames; big arrays move several cells a frame
+    static constexpr float GROW_COPY_FRAMES = 90.f;
+
+public:
+    ArrayVisualizer(sf::Font& fontRef, sf::Vector2f pos, 
+                    float width , float height)
+        : font(fontRef), position(pos), cellWidth(width), cellHeight(height),
+        defaultColor(sf::Color(70, 130, 180)), // Steel blue
+        highlightColor(sf::Color(255, 165, 0)),  // Orange
+        searchingColor(sf::Color(100, 100, 255)), // Light blue (searching)
+        foundColor(sf::Color(0, 255, 0)),         // Bright green (found)
+        insertingColor(sf::Color(255, 255, 0, 175)),   // Yellow for insertion
+        removingColor(sf::Color(255, 215, 0, 175)),    // Gold for removal
+        excludedColor(sf::Color(45, 60, 75))           // Dim slate (ruled out)
+    {
+        // Initialize with some sample data
+        array = {10, 20, 30, 40, 50};
+    }
+    
+    const std::vector<int>& getArray() const { return array.values(); }
+
+    // Replace the contents without animating (bulk loads, benchmarks).
+    // Only call while no operation is running.
+    void load(const std::vector<int>& values) {
+        load(std::vector<int>(values));
+    }
+
+    // Takes the values over without copying them (file imports)
+    void load(std::vector<int>&& values) {
+        array.assign(std::move(values));
+        growPhase = GrowPhase::Idle;
+        highlightedIndices.clear();
+        searchTracks.clear();
+        updateTracks.clear();
+        shiftBlock.clear();
+        displaced.clear();
+    }
+
+    void draw(RenderContext& window) {
+        const sf::View& view = window.getView();
+        viewLeft = view.getCenter().x - view.getSize().x / 2.f;
+        viewRight = view.getCenter().x + view.getSize().x / 2.f;
+
+        collectSortMeasurement();
+        if (scalingTiming.valid() && scalingTiming.wait_for(std::chrono::seconds(0)) == std::future_status::ready) {
+            scalingText = scalingTiming.get();
+        }
+        if (scanTimingInFlight.valid() &&
+            scanTimingInFlight.wait_for(std::chrono::seconds(0)) == std::future_status::ready) {
+            scanTiming = scanTimingInFlight.get();
+        }
+
+        size_t firstVisible, lastVisible;
+        visibleCellRange(viewLeft, viewRight, position.x, cellWidth + 5.f, array.size(),
+                         firstVisible, lastVisible);
+
+        if (showCapacity) {
+            drawSlots(window);
+        }
+
+        // Shifting cells go out in one draw; only their labels are per cell
+        shiftBlock.draw(window);
+
+        for (size_t i = firstVisible; i < lastVisible; ++i) {
+            // Skip drawing the original cell if it's one being updated and we're animating
+            if (!updateTracks.empty() && isUpdating(i)) {
+                continue;
+            }
+            
+            bool inBlock = shiftBlock.contains(i);
+            sf::Vector2f drawn = drawnPosition(i);
+            float x = drawn.x;
+            float y = drawn.y;
+            if (inBlock) {
+                x += shiftBlock.getOffset().x;
+                y += shiftBlock.getOffset().y;
+            }
+            
+            // Apply bounce effect if this is the found element
+            float bounceOffset = 0.0f;
+            float bounce = searchTracks.empty() ? 0.f : bounceAt(i);
+            if (bounce > 0 && quality < QualityTier::NoCellText) {
+                bounceOffset = -30.0f * bounce * bounce;
+            }
+            
+            if (!inBlock && quality == QualityTier::Aggregate) {
+                appendQuad(aggregateBatch, sf::Vector2f(x, y), sf::Vector2f(cellWidth, cellHeight), cellColor(i));
+            } else if (!inBlock) {
+                sf::RectangleShape cell(sf::Vector2f(cellWidth, cellHeight));
+                cell.setPosition(x, y + bounceOffset);
+                
+                cell.setFillColor(cellColor(i));
+                cell.setOutlineThickness(quality < QualityTier::NoOutlines ? 2.f : 0.f);
+                cell.setOutlineColor(sf::Color::Black);
+                window.draw(cell);
+            }
+            
+            // Draw text (position adjusted for bounce)
+            if (quality == QualityTier::Full) {
+                sf::Text indexText(std::to_string(i), font, 16);
+                indexText.setPosition(x + cellWidth/2 - indexText.getLocalBounds().width/2, 
+                                    y + cellHeight + 5 + bounceOffset);
+                indexText.setFillColor(sf::Color::White);
+                window.draw(indexText);
+            }
+            
+            if (quality < QualityTier::NoCellText) {
+                sf::Text valueText(std::to_string(array[i]), font, 20);
+                valueText.setPosition(x + cellWidth/2 - valueText.getLocalBounds().width/2, 
+                                    y + cellHeight/2 - valueText.getLocalBounds().height/2 + bounceOffset);
+                valueText.setFillColor(sf::Color::White);
+                window.draw(valueText);
+            }
+        }
+
+        if (quality == QualityTier::Aggregate) {
+            window.draw(aggregateBatch);
+            aggregateBatch.clear();
+        }
+
+        // The window each sorted search still has in play, under the indices
+        for (const auto& entry : searchTracks) {
+            const SearchTrack& search = entry.second;
+            if (!search.sorted || search.probeIndex >= search.probes.size()) continue;
+            const core::SearchProbe& probe = search.probes[search.probeIndex];
+            float left = slotPosition(probe.lo).x;
+            float right = slotPosition(probe.hi).x + cellWidth;
+            float barY = position.y + cellHeight + 30.f;
+            sf::RectangleShape bar(sf::Vector2f(right - left, 4.f));
+            bar.setPosition(left, barY);
+            bar.setFillColor(searchingColor);
+            window.draw(bar);
+            if (quality == QualityTier::Full) {
+                sf::Text lo("lo", font, 14);
+                lo.setPosition(left, barY + 6.f);
+                lo.setFillColor(searchingColor);
+                window.draw(lo);
+                sf::Text hi("hi", font, 14);
+                hi.setPosition(right - hi.getLocalBounds().width, barY + 6.f);
+                hi.setFillColor(searchingColor);
+                window.draw(hi);
+            }
+        }
+
+        // One lane per sorting thread, stacked above the cells
+        for (size_t t = 0; t < lanes.size(); ++t) {
+            float laneY = position.y - 6.f * (t + 1) - 4.f;
+            if (quality == QualityTier::Full) {
+                sf::Text label("T" + std::to_string(t), font, 10);
+                label.setPosition(position.x - 22.f, laneY - 4.f);
+                label.setFillColor(laneColor(t));
+                window.draw(label);
+            }
+            if (lanes[t].first == lanes[t].second) continue;
+            float left = slotPosition(lanes[t].first).x;
+            float right = slotPosition(lanes[t].second - 1).x + cellWidth;
+            sf::RectangleShape lane(sf::Vector2f(right - left, 4.f));
+            lane.setPosition(left, laneY);
+            lane.setFillColor(laneColor(t));
+            window.draw(lane);
+        }
+        
+        if (scanning && (scanCurrent.kind == core::ScanStep::Up || scanCurrent.kind == core::ScanStep::Down)) {
+            drawScanLevel(window);
+        }
+        
+        // Draw the updating cells for every update animation in flight
+        for (const auto& entry : updateTracks) {
+            const sf::Vector2f& oldCellPosition = entry.second.oldCellPosition;
+            const sf::Vector2f& newCellPosition = entry.second.newCellPosition;
+            int oldValue = entry.second.oldValue;
+            int newValue = entry.second.newValue;
+            size_t updateIndex = entry.second.index;
+
+            // Draw the old cell sliding down (with old value)
+            sf::RectangleShape oldCell(sf::Vector2f(cellWidth, cellHeight));
+            oldCell.setPosition(oldCellPosition);
+            oldCell.setFillColor(removingColor);
+            oldCell.setOutlineThickness(2.f);
+            oldCell.setOutlineColor(sf::Color::Black);
+            window.draw(oldCell);
+            
+            sf::Text oldValueText(std::to_string(oldValue), font, 20);
+            oldValueText.setPosition(oldCellPosition.x + cellWidth/2 - oldValueText.getLocalBounds().width/2, 
+                                   oldCellPosition.y + cellHeight/2 - oldValueText.getLocalBounds().height/2);
+            oldValueText.setFillColor(sf::Color::White);
+            window.draw(oldValueText);
+            
+            // Draw the new cell coming down (with new value)
+            sf::RectangleShape newCell(sf::Vector2f(cellWidth, cellHeight));
+            newCell.setPosition(newCellPosition);
+            newCell.setFillColor(insertingColor);
+            newCell.setOutlineThickness(2.f);
+            newCell.setOutlineColor(sf::Color::Black);
+            window.draw(newCell);
+            
+            sf::Text newValueText(std::to_string(newValue), font, 20);
+            newValueText.setPosition(newCellPosition.x + cellWidth/2 - newValueText.getLocalBounds().width/2, 
+                                   newCellPosition.y + cellHeight/2 - newValueText.getLocalBounds().height/2);
+            newValueText.setFillColor(sf::Color::White);
+            window.draw(newValueText);
+            
+            // Draw index for both cells
+            sf::Text indexText(std::to_string(updateIndex), font, 16);
+            indexText.setPosition(oldCellPosition.x + cellWidth/2 - indexText.getLocalBounds().width/2, 
+                                oldCellPosition.y + cellHeight + 5);
+            indexText.setFillColor(sf::Color::White);
+            window.draw(indexText);
+        }
+    }
+
+    sf::Vector2f slotPosition(size_t i) const {
+        return sf::Vector2f(position.x + static_cast<float>(i * static_cast<double>(cellWidth + 5.f)), position.y);
+    }
+
+    sf::Vector2f drawnPosition(size_t i) const {
+        if (i < copyCount && (growPhase == GrowPhase::Copy || growPhase == GrowPhase::Free ||
+                              growPhase == GrowPhase::Settle)) {
+            return sf::Vector2f(slotPosition(i).x, position.y + growOffset(i));
+        }
+        for (const auto& cell : displaced) {
+            if (cell.first == i) return slotPosition(i) + cell.second;
+        }
+        return slotPosition(i);
+    }
+
+    sf::Vector2f& displacement(size_t i) {
+        for (auto& cell : displaced) {
+            if (cell.first == i) return cell.second;
+        }
+        displaced.emplace_back(i, sf::Vector2f(0.f, 0.f));
+        return displaced.back().second;
+    }
+
+    // Puts cell i back in its slot, leaving the others' animations be
+    void settle(size_t i) {
+        displaced.erase(std::remove_if(displaced.begin(), displaced.end(),
+                                       [i](const std::pair<size_t, sf::Vector2f>& cell) { return cell.first == i; }),
+                        displaced.end());
+    }
+
+    // Bake cells [blockFirst, array.size()) into the shift block, keeping only
+    // the ones that can be on screen.
+    void startShiftBlock(size_t blockFirst, sf::Color fillColor, sf::Vector2f startOffset) {
+        size_t bakeFirst, bakeLast;
+        visibleCellRange(viewLeft, viewRight, position.x, cellWidth + 5.f, array.size(),
+                         bakeFirst, bakeLast);
+        shiftBlock.build([this](size_t i) { return slotPosition(i); }, blockFirst, array.size(), bakeFirst, bakeLast,
+                         sf::Vector2f(cellWidth, cellHeight), fillColor, startOffset);
+    }
+
+
+    void insert(int index, int value, bool& animationComplete) {
+        currentOperation = Operation::Insert;
+        static bool animating = false;
+        static size_t insertIndex = 0;
+        
+        if (!animating) {
+            // Start insertion (the array may have changed since it was queued)
+            if (index < 0 || index > array.size()) {
+                animationComplete = true;
+            } else {
+                countNative(counterPanel, costMeter, "insert", array.size(), [&] { array.insert(index, value); });
+                displaced.clear();
+                
+                // The new cell drops in from above, everything right of it
+                // slides in from one slot to the left as a single block
+                displacement(index).y = -100.f;
+                startShiftBlock(index + 1, insertingColor, sf::Vector2f(-(cellWidth + 5), 0.f));
+                
+                insertIndex = index;
+                animating = true;
+                animationComplete = false;
+                
+                highlightedIndices.clear();
+                highlightedIndices.push_back(index);
+            }
+        } else {
+            // Animate insertion
+            sf::Vector2f& offset = displacement(insertIndex);
+            offset = offset * (1.f - animationSpeed);
+            shiftBlock.setOffset(shiftBlock.getOffset() * (1.f - animationSpeed));
+            
+            float dy = offset.y;
+            float dx = shiftBlock.getOffset().x;
+            bool allComplete = dy*dy < 1.0f && dx*dx < 1.0f;
+            
+            if (allComplete) {
+                settle(insertIndex);
+                shiftBlock.clear();
+                animating = false;
+                animationComplete = true;
+                highlightedIndices.clear(); // Clear highlights when done
+            }
+        }
+    }
+
+
+    void remove(int index, bool& animationComplete) {
+        currentOperation = Operation::Remove;
+        static bool animating = false;
+        static size_t removeIndex = 0;
+        static float startY = 0.f;
+        static float animationProgress = 0.f;
+        static int removedValue = 0;
+        
+        const float shiftingSpeed = 0.03f;  
+    
+        if (!animating) {
+            // Start removal (the array may have changed since it was queued)
+            if (index < 0 || index >= array.size()) {
+                animationComplete = true;
+            } else {
                 removedValue = array[index];
                 removeIndex = index;
+                startY = drawnPosition(index).y;
+                animationProgress = 0.f;
                 
-                // Store current positions
-                startPositions = currentPositions;
+                // Right neighbors shift left together as one block
+                startShiftBlock(index + 1, removingColor, sf::Vector2f(0.f, 0.f));
                 
-                // Calculate target positions (shift left for right neighbors)
-                targetPositions = startPositions;
-                targetPositions.erase(targetPositions.begin() + index);
+                animating = true;
+                animationComplete = false;
                 
-                for (size_t i = index; i < targetPositions.size(); ++i) {
-                    targetPositions[i].x = startPositions[i+1].x - (cellWidth + 5);
+                highlightedIndices.clear();
+                highlightedIndices.push_back(index); // The cell being removed
+            }
+        } else {
+            // Animate removal
+            animationProgress += shiftingSpeed;
+            float progress = std::min(animationProgress, 1.0f);
+            
+            // 1. Animate the removed cell sliding down
+            displacement(removeIndex).y = startY - slotPosition(removeIndex).y + 80.f * progress;
+            
+            // 2. Animate neighboring cells shifting left
+            shiftBlock.setOffset(sf::Vector2f(-(cellWidth + 5) * progress, 0.f));
+            
+            // Check if animation is complete
+            if (animationProgress >= 1.0f) {
+                // Actually remove the element
+                countNative(counterPanel, costMeter, "remove", array.size(), [&] { array.remove(removeIndex); });
+                displaced.clear();
+                shiftBlock.clear();
+                
+                animating = false;
+                animationComplete = true;
+                highlightedIndices.clear(); // Clear highlights when done
+            }
+        }
+        
+    }
+
+    // Keeps a found element raised for a while, then ends the track. False
+    // while nothing has been found yet.
+    bool holdFound(SearchTrack& search, int track, bool& animationComplete) {
+        const float HOLD_DURATION = 2.0f;
+        if (search.foundIndex == -1) {
+            return false;
+        }
+        search.foundHoldTime += 1.0f / 60.0f;
+        search.bounce = 1.0f; // Maintain bounce state during hold
+        
+        // Keep the element elevated
+        displacement(search.foundIndex).y = -5.0f;
+        
+        if (search.foundHoldTime >= HOLD_DURATION) {
+            settle(search.foundIndex);
+            searchTracks.erase(track);
+            animationComplete = true;
+        }
+        return true;
+    }
+
+    // Linear scan on animation track `track`
+    void search(int value, bool& animationComplete, int track = 0) {
+        currentOperation = Operation::Search;
+        SearchTrack& search = searchTracks[track];
+        
+        if (!search.animating) {
+            // Initialize search state
+            search = SearchTrack();
+            search.animating = true;
+            animationComplete = false;
+
+            // The same linear scan the animation steps through, at native speed
+            countNative(counterPanel, costMeter, "search", array.size(), [&] { array.find(value); });
+            return;
+        }
+
+        // If we've found an element and are in the hold phase
+        if (holdFound(search, track, animationComplete)) {
+            return;
+        }
+        
+        // Animate search
+        if (search.currentIndex < array.size()) {
+            search.progress += animationSpeed;
+            
+            if (search.progress >= 1.0f) {
+                if (array[search.currentIndex] == value) {
+                    search.foundIndex = search.currentIndex;
+                    search.bounce = 1.0f; // Start bounce
+                    search.foundHoldTime = 0.0f;
+                    displacement(search.foundIndex).y = -5.0f;
+                } else {
+                    search.currentIndex++;
+                    search.progress = 0.f;
+                }
+            }
+        } else {
+            // Search complete (element not found)
+            searchTracks.erase(track);
+            animationComplete = true;
+        }
+    }
+
+    // Binary, branchless, interpolation or exponential search of a sorted
+    // array on track `track`: one probe per step, the cells outside the
+    // window still in play dimmed
+    void searchSorted(core::SortedSearch method, int value, bool& animationComplete, int track = 0) {
+        currentOperation = Operation::Search;
+        SearchTrack& search = searchTracks[track];
+
+        if (!search.animating) {
+            const std::vector<int>& values = array.values();
+            std::string name = core::sortedSearchName(method);
+            lastReport = Report::Search;
+            if (!std::is_sorted(values.begin(), values.end())) {
+                searchReport = name + " search needs a sorted array: sort it first";
+                searchTracks.erase(track);
+                animationComplete = true;
+                return;
+            }
+
+            search = SearchTrack();
+            search.animating = true;
+            search.sorted = true;
+            search.result = core::sortedSearchTraced(method, values, value, search.probes);
+            countNative(counterPanel, costMeter, name + " search", values.size(),
+                        [&] { core::sortedSearch(method, values.data(), values.size(), value); });
+
+            searchReport = name + " search for " + std::to_string(value) + ", n = " +
+                           std::to_string(values.size()) + ": " +
+                           (search.result == core::npos ? "not found" : "found at " + std::to_string(search.result)) +
+                           " after " + std::to_string(search.probes.size()) + " probes";
+
+            // Every mode over the same array, on lookups that hit and miss
+            std::vector<int> queries = core::searchQueries(values, SEARCH_TIMING_LOOKUPS, static_cast<uint64_t>(value));
+            searchReport += "\nNative, per lookup over " + std::to_string(queries.size()) + " lookups (half hits):";
+            for (int k = 0; k < core::SORTED_SEARCH_COUNT; ++k) {
+                core::SortedSearch other = static_cast<core::SortedSearch>(k);
+                core::SearchTiming timing = core::timeSortedSearch(other, values, queries);
+                char entry[96];
+                std::snprintf(entry, sizeof(entry), "%s%s %s, %.1f probes", k % 2 == 0 ? "\n" : "   ",
+                              core::sortedSearchName(other), NativeCostMeter::formatNs(timing.nsPerLookup).c_str(),
+                              timing.probesPerLookup);
+                searchReport += entry;
+            }
+            animationComplete = false;
+            return;
+        }
+
+        if (holdFound(search, track, animationComplete)) {
+            return;
+        }
+
+        if (search.probeIndex < search.probes.size()) {
+            search.progress += animationSpeed;
+            if (search.progress >= 1.0f) {
+                search.progress = 0.f;
+                search.probeIndex++;
+            }
+        } else if (search.result != core::npos) {
+            search.foundIndex = static_cast<int>(search.result);
+            search.bounce = 1.0f;
+            search.foundHoldTime = 0.0f;
+            displacement(search.foundIndex).y = -5.0f;
+        } else {
+            searchTracks.erase(track);
+            animationComplete = true;
+        }
+    }
+
+    // Swap in a new value at `index` on animation track `track`
+    void updateValue(int index, int value, bool& animationComplete, int track = 0) {
+        auto it = updateTracks.find(track);
+        
+        if (it == updateTracks.end()) {
+            // Initialize update animation
+            if (index < 0 || index >= array.size()) {
+                animationComplete = true;
+                return;
+            }
+
+            UpdateTrack update;
+            update.index = index;
+            update.oldValue = array[index];
+            update.newValue = value;
+            
+            // Set initial positions
+            update.oldCellPosition = slotPosition(index);
+            update.newCellPosition = update.oldCellPosition - sf::Vector2f(0, 100); // Start above
+            
+            updateTracks[track] = update;
+            animationComplete = false;
+            return;
+        }
+
+        UpdateTrack& update = it->second;
+
+        // Update animation progress
+        update.progress += animationSpeed * 0.5f;
+        
+        // Animate both cells simultaneously
+        float progress = std::min(update.progress, 1.0f);
+        
+        // Old cell slides down
+        update.oldCellPosition.y = slotPosition(update.index).y + 100.0f * progress;
+        
+        // New cell comes down from above
+        update.newCellPosition.y = slotPosition(update.index).y - 100.0f * (1.0f - progress);
+        
+        // Update actual array value at 50% progress
+        if (update.progress >= 0.5f && array[update.index] != update.newValue) {
+            countNative(counterPanel, costMeter, "update", array.size(),
+                        [&] { array.update(update.index, update.newValue); });
+        }
+        
+        // Complete animation
+        if (update.progress >= 1.0f) {
+            array.update(update.index, update.newValue); // Ensure final value
+            settle(update.index);
+            updateTracks.erase(it);
+            animationComplete = true;
+        }
+    }
+
+    template <typename T>
+    static bool stillRunning(const std::future<T>& timing) {
+        return timing.valid() && timing.wait_for(std::chrono::seconds(0)) != std::future_status::ready;
+    }
+
+    // Native timing still running on a worker. Sorts and scans wait for it
+    // rather than compete with it for the cores, and a new future assigned
+    // over a running one would block the frame in its destructor until it
+    // finished.
+    bool timingNatively() const {
+        return stillRunning(sortMeasuring) || stillRunning(scalingTiming) || stillRunning(scanTimingInFlight);
+    }
+
+    // Refuse an operation while timingNatively(), showing the timing it waits on
+    void refuseWhileTiming(bool& animationComplete) {
+        if (stillRunning(scanTimingInFlight)) {
+            lastReport = Report::Scan;
+        } else {
+            sortParallel = !stillRunning(sortMeasuring);
+            lastReport = Report::Sort;
+        }
+        animationComplete = true;
+    }
+
+    // Sort with `algorithm`. A worker times the same input natively and runs
+    // it once under the hardware counters. Meanwhile small arrays are sorted
+    // under the tracing observer and replayed; large ones are checked and
+    // sorted under the counting observer on the worker too, and the sort
+    // waits for it.
+    void sort(core::SortAlgorithm algorithm, bool& animationComplete) {
+        currentOperation = Operation::Sort;
+
+        if (!sorting) {
+            if (timingNatively()) {
+                refuseWhileTiming(animationComplete);
+                return;
+            }
+            const std::vector<int>& input = array.values();
+            sortHeading = std::string(core::sortAlgorithmName(algorithm)) + " sort, n = " +
+                          std::to_string(input.size());
+            sortParallel = false;
+            lastReport = Report::Sort;
+            sortShown = core::SortStats();
+            sortSteps.clear();
+
+            bool large = input.size() > SORT_ANIMATE_LIMIT;
+            bool replay = false;
+            if (!large) {
+                std::string error;
+                if (!core::checkSortable(algorithm, input, error)) {
+                    sortTiming = "Refused: " + error;
+                    animationComplete = true;
+                    return;
                 }
-                
-                animating = true;
-                animationComplete = false;
-                
-                // Highlight cells that will move (the removed cell and all to its right)
-                highlightedIndices.clear();
-                highlightedIndices.push_back(index); // The cell being removed
-                for (size_t i = index + 1; i < array.size(); ++i) {
-                    highlightedIndices.push_back(i); // Cells shifting left
+                sortResult = input;
+                core::SortStats total;
+                replay = core::sortTraced(algorithm, sortResult, total, sortSteps);
+                sortShown.auxiliaryBytes = total.auxiliaryBytes;
+                if (!replay) {
+                    sortSteps.clear();
+                    sortShown = total;
+                    takeResult(sortResult);
                 }
             }
-        } else {
-            // Animate removal
-            animationProgress += shiftingSpeed;
-            
-            // 1. Animate the removed cell sliding down
-            if (removeIndex < currentPositions.size()) {
-                currentPositions[removeIndex].y = startPositions[removeIndex].y + 
-                    (80.f * animationProgress);
+            sortTiming = large ? "Sorting and timing natively..." : "Timing natively...";
+            sortMeasuring = std::async(std::launch::async, &ArrayVisualizer::measureSort, algorithm, input, large);
+            if (!large && !replay) {
+                animationComplete = true;
+                return;
             }
-            
-            // 2. Animate neighboring cells shifting left
-            for (size_t i = 0; i < currentPositions.size(); ++i) {
-                if (i != removeIndex && i >= removeIndex) {
-                    currentPositions[i].x = startPositions[i].x + 
-                        (targetPositions[i-1].x - startPositions[i].x) * animationProgress;
+
+            sortWaiting = large;
+            sortNext = 0;
+            sortProgress = 0.f;
+            // Slow enough to follow on a few cells, never longer than SORT_MAX_FRAMES
+            sortStepsPerFrame = std::max(animationSpeed * 2.f, sortSteps.size() / SORT_MAX_FRAMES);
+            sorting = true;
+            animationComplete = false;
+            return;
+        }
+
+        if (sortWaiting) {
+            collectSortMeasurement();
+            if (!sortMeasuring.valid()) {
+                // Empty if the worker refused the sort
+                if (!sortResult.empty()) {
+                    takeResult(sortResult);
                 }
-            }
-            
-            // Check if animation is complete
-            if (animationProgress >= 1.0f) {
-                // Actually remove the element
-                array.erase(array.begin() + removeIndex);
-                updateCellPositions();
-                currentPositions = cellPositions;
-                
-                animating = false;
+                sortWaiting = false;
+                sorting = false;
                 animationComplete = true;
-                highlightedIndices.clear(); // Clear highlights when done
             }
+            return;
+        }
+
+        sortProgress += sortStepsPerFrame;
+        while (sortProgress >= 1.f && sortNext < sortSteps.size()) {
+            applySortStep(sortSteps[sortNext++]);
+            sortProgress -= 1.f;
+        }
+
+        if (sortNext == sortSteps.size()) {
+            // The replay ends on these same values
+            takeResult(sortResult);
+            sortSteps.clear();
+            highlightedIndices.clear();
+            sorting = false;
+            animationComplete = true;
         }
-        
     }
 
-    void search(int value, bool& animationComplete) {
-        currentOperation = Operation::Search;
-        static bool animating = false;
-        static size_t currentIndex = 0;
-        static int foundIndex = -1;
-        static std::vector<float> searchProgress;
-        static float foundHoldTime = 0.0f;
-        static const float HOLD_DURATION = 2.0f;
-        
-        if (!animating) {
-            // Reset positions and states when starting new search
-            for (size_t i = 0; i < currentPositions.size(); ++i) {
-                currentPositions[i] = cellPositions[i];
+    // Runs on a worker: the native and std::sort times, one native run under
+    // the worker's own counters (they count only the thread that opens them),
+    // and when `counted` the check and the counted sort the replay would do
+    static SortMeasurement measureSort(core::SortAlgorithm algorithm, std::vector<int> input, bool counted) {
+        SortMeasurement measured;
+        measured.elements = input.size();
+        std::string error;
+        if (counted && !core::checkSortable(algorithm, input, error)) {
+            measured.timing = "Refused: " + error;
+            return measured;
+        }
+
+        int runs = input.size() <= 65536 ? 5 : 1;
+        double nativeNs = core::nativeSortNs(algorithm, input, runs);
+        double referenceNs = core::stdSortNs(input, runs);
+        measured.timing = "Native: " + NativeCostMeter::formatNs(nativeNs) + "   std::sort: " +
+                          NativeCostMeter::formatNs(referenceNs) + "   (median of " + std::to_string(runs) + ")";
+
+        std::vector<int> scratch(input);
+        core::PerfCounters counters;
+        auto start = std::chrono::steady_clock::now();
+        measured.counters = counters.measure([&] { core::sortNative(algorithm, scratch); });
+        measured.ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+
+        if (counted) {
+            measured.total = core::sortCounted(algorithm, input);
+            measured.result = std::move(input);
+        }
+        return measured;
+    }
+
+    // Takes a finished sort measurement: its times, its counters, and for a
+    // large array the sorted values and counts the sort is waiting on
+    void collectSortMeasurement() {
+        if (!sortMeasuring.valid() || stillRunning(sortMeasuring)) {
+            return;
+        }
+        SortMeasurement measured = sortMeasuring.get();
+        sortTiming = measured.timing;
+        if (measured.counters.ok && counterPanel) {
+            counterPanel->show(sortHeading, measured.elements, measured.counters);
+        }
+        if (measured.ns > 0 && costMeter) {
+            costMeter->record(sortHeading, measured.elements, measured.ns);
+        }
+        if (sortWaiting) {
+            sortShown = measured.total;
+            sortResult = std::move(measured.result);
+        }
+    }
+
+    // Parallel sort on a work-stealing pool. Small arrays replay the tasks in
+    // the order they ran, with a lane per thread.
+    void parallelSort(core::ParallelSort algorithm, bool& animationComplete) {
+        currentOperation = Operation::Sort;
+
+        if (!sorting) {
+            if (timingNatively()) {
+                refuseWhileTiming(animationComplete);
+                return;
             }
-            
-            // Initialize search state
-            foundIndex = -1;
-            currentIndex = 0;
-            foundHoldTime = 0.0f;
-            searchProgress.assign(array.size(), 0.0f);
-            foundBounce.assign(array.size(), 0.0f); // Clear all bounce states
-            animating = true;
+            const std::vector<int>& input = array.values();
+            size_t hardware = std::max(1u, std::thread::hardware_concurrency());
+            core::ThreadPool pool(std::min(hardware, MAX_SORT_LANES));
+            sortHeading = std::string(core::parallelSortName(algorithm)) + " sort, n = " +
+                          std::to_string(input.size()) + ", " + std::to_string(pool.size()) + " threads (" +
+                          std::to_string(hardware) + " hardware)";
+            sortParallel = true;
+            lastReport = Report::Sort;
+
+            sortResult = input;
+            if (input.size() > SORT_ANIMATE_LIMIT) {
+                countNative(counterPanel, costMeter, sortHeading, input.size(),
+                            [&] { core::parallelSort(algorithm, sortResult, pool); });
+                // Timed on a worker once this sort is done with the cores
+                startScalingTiming(algorithm, input, hardware);
+                takeResult(sortResult);
+                animationComplete = true;
+                return;
+            }
+
+            // Small leaves, so even a short array splits into several tasks
+            core::ParallelSortTrace trace(pool.size());
+            core::ParallelSortOptions options;
+            options.cutoff = std::max<size_t>(8, input.size() / (pool.size() * 4));
+            options.trace = &trace;
+            core::parallelSort(algorithm, sortResult, pool, options);
+            parallelEvents = trace.take();
+            lanes.assign(pool.size(), std::make_pair(size_t(0), size_t(0)));
+            startScalingTiming(algorithm, input, hardware);
+
+            sortNext = 0;
+            sortProgress = 0.f;
+            sortStepsPerFrame = std::max(animationSpeed * 2.f, parallelEvents.size() / SORT_MAX_FRAMES);
+            sorting = true;
             animationComplete = false;
+            return;
+        }
+
+        sortProgress += sortStepsPerFrame;
+        while (sortProgress >= 1.f && sortNext < parallelEvents.size()) {
+            applyParallelEvent(parallelEvents[sortNext++]);
+            sortProgress -= 1.f;
+        }
+
+        if (sortNext == parallelEvents.size()) {
+            takeResult(sortResult);
+            parallelEvents.clear();
+            lanes.clear();
             highlightedIndices.clear();
+            sorting = false;
+            animationComplete = true;
+        }
+    }
+
+    // Native runs of the same input on 1..hardware threads, next to std::sort,
+    // measured on a worker so the window keeps drawing; draw() picks them up.
+    // Only call while !timingNatively().
+    void startScalingTiming(core::ParallelSort algorithm, const std::vector<int>& input, size_t hardware) {
+        scalingText = "Timing natively on 1.." + std::to_string(hardware) + " threads...";
+        scalingTiming = std::async(std::launch::async, &ArrayVisualizer::timeParallelSort, algorithm, input, hardware);
+    }
+
+    static std::string timeParallelSort(core::ParallelSort algorithm, std::vector<int> input, size_t hardware) {
+        int runs = input.size() <= 65536 ? 5 : 1;
+        std::vector<core::ScalingPoint> points =
+            core::measureParallelScaling(algorithm, input, core::scalingThreadCounts(hardware), runs);
+        std::string text = "Speedup:";
+        for (size_t k = 0; k < points.size(); ++k) {
+            char entry[32];
+            std::snprintf(entry, sizeof(entry), "%s%zut %.2fx", k > 0 && k % 6 == 0 ? "\n    " : "   ",
+                          points[k].threads, points[k].ns > 0 ? points[0].ns / points[k].ns : 0.0);
+            text += entry;
+        }
+        double parallelNs;
+        return text + "\nNative: " + NativeCostMeter::formatNs(points.back().ns) + " on " +
+               std::to_string(points.back().threads) + " threads   std::sort: " +
+               NativeCostMeter::formatNs(core::stdSortNs(input, runs)) + "   std::sort(par): " +
+               (core::parallelStdSortNs(input, runs, parallelNs) ? NativeCostMeter::formatNs(parallelNs)
+                                                                  : std::string("not built (PARSTL=1)"));
+    }
+
+    // Puts a sort's or scan's final values in place, keeping the array's capacity
+    void takeResult(std::vector<int>& result) {
+        array.overwrite(result);
+        std::vector<int>().swap(result);
+    }
+
+    void applyParallelEvent(const core::ParallelSortEvent& event) {
+        if (!event.end) {
+            lanes[event.thread] = std::make_pair(size_t(event.lo), size_t(event.hi));
+            return;
+        }
+        lanes[event.thread] = std::make_pair(size_t(0), size_t(0));
+        sortKind = core::SortStep::Write;
+        highlightedIndices.clear();
+        for (size_t i = event.lo; i < event.hi; ++i) {
+            array.update(i, event.values[i - event.lo]);
+            highlightedIndices.push_back(i);
+        }
+    }
+
+    void applySortStep(const core::SortStep& step) {
+        sortKind = step.kind;
+        highlightedIndices.clear();
+        highlightedIndices.push_back(step.i);
+        if (step.kind != core::SortStep::Write && step.j != core::SortStep::NO_INDEX) {
+            highlightedIndices.push_back(step.j);
+        }
+
+        switch (step.kind) {
+            case core::SortStep::Compare:
+                ++sortShown.comparisons;
+                break;
+            case core::SortStep::Swap: {
+                int first = array[step.i];
+                array.update(step.i, array[step.j]);
+                array.update(step.j, first);
+                ++sortShown.swaps;
+                break;
+            }
+            case core::SortStep::Write:
+                array.update(step.i, step.value);
+                ++sortShown.writes;
+                break;
+        }
+    }
+
+    // The next value an append adds: ten past the last, so sample data
+    // stays sorted for the sorted searches
+    int nextAppendValue() const {
+        if (array.empty()) return 10;
+        int last = array[array.size() - 1];
+        return last > std::numeric_limits<int>::max() - 10 ? last : last + 10;
+    }
+
+    const core::GrowthPolicy& growth() const { return array.growth(); }
+
+    // A new policy starts a fresh latency plot, so its amortized cost reads
+    // on its own
+    void setGrowth(const core::GrowthPolicy& policy) {
+        array.setGrowth(policy);
+        if (appendPlot) appendPlot->clear();
+    }
+
+    // Appends `value`. With the capacity view on, a reallocation it causes
+    // plays out before the value drops into its slot.
+    void append(int value, bool& animationComplete) {
+        currentOperation = Operation::Insert;
+
+        if (growPhase == GrowPhase::Idle) {
+            size_t before = array.capacity();
+            bool reallocated = false;
+            double ns = 0.0;
+            countNative(counterPanel, costMeter, "append", array.size(),
+                        [&] { reallocated = timedAppend(value, ns); });
+            size_t index = array.size() - 1;
+            displaced.clear();
+            displacement(index).y = -100.f;
+            highlightedIndices.assign(1, index);
+
+            capacityReport = reallocated
+                ? "append: grew " + std::to_string(before) + " -> " + std::to_string(array.capacity()) +
+                      " slots, copied " + std::to_string(index) + " in " + NativeCostMeter::formatNs(ns)
+                : "append: fit in spare capacity, " + NativeCostMeter::formatNs(ns);
+            lastReport = Report::Capacity;
+            startGrow(reallocated ? before : 0, index, true);
+            animationComplete = false;
+            return;
+        }
+        stepGrow(animationComplete);
+    }
+
+    // `count` appends at native speed, each timed into the latency plot. Not
+    // animated: the capacity view jumps to the result.
+    void appendBurst(size_t count) {
+        size_t grown = 0;
+        double ns = 0.0;
+        for (size_t k = 0; k < count; ++k) {
+            grown += timedAppend(nextAppendValue(), ns) ? 1 : 0;
+        }
+        displaced.clear();
+        capacityReport = std::to_string(count) + " appends: " + std::to_string(grown) + " reallocations";
+        lastReport = Report::Capacity;
+    }
+
+    // Grows the capacity to at least `capacity` slots, animated like the
+    // reallocation an append causes
+    void reserve(size_t capacity, bool& animationComplete) {
+        currentOperation = Operation::Insert;
+
+        if (growPhase == GrowPhase::Idle) {
+            size_t before = array.capacity();
+            bool reallocated = false;
+            auto start = std::chrono::steady_clock::now();
+            countNative(counterPanel, costMeter, "reserve", array.size(),
+                        [&] { reallocated = array.reserve(capacity); });
+            auto end = std::chrono::steady_clock::now();
+            double ns = std::chrono::duration<double, std::nano>(end - start).count();
+            capacityReport = reallocated
+                ? "reserve: grew " + std::to_string(before) + " -> " + std::to_string(array.capacity()) +
+                      " slots, copied " + std::to_string(array.size()) + " in " + NativeCostMeter::formatNs(ns)
+                : "reserve: already " + std::to_string(before) + " slots";
+            lastReport = Report::Capacity;
+            if (!startGrow(reallocated ? before : 0, array.size(), false)) {
+                animationComplete = true;
+                return;
+            }
+            animationComplete = false;
+            return;
+        }
+        stepGrow(animationComplete);
+    }
+
+    // One native append, timed on its own and recorded in the latency plot.
+    // True when it reallocated.
+    bool timedAppend(int value, double& ns) {
+        auto start = std::chrono::steady_clock::now();
+        bool reallocated = array.append(value);
+        auto end = std::chrono::steady_clock::now();
+        ns = std::chrono::duration<double, std::nano>(end - start).count();
+        if (appendPlot) appendPlot->record(ns, reallocated);
+        return reallocated;
+    }
+
+    // Starts showing a move of `elements` out of a buffer of `previousCapacity`
+    // slots (0: nothing moved), then the drop of an appended value. False
+    // when there is nothing to show.
+    bool startGrow(size_t previousCapacity, size_t elements, bool appends) {
+        growAppends = appends;
+        if (showCapacity && previousCapacity > 0 && elements > 0) {
+            oldCapacity = previousCapacity;
+            copyCount = elements;
+            copied = 0.f;
+            growProgress = 0.f;
+            growPhase = GrowPhase::Copy;
         } else {
-            // If we've found an element and are in the hold phase
-            if (foundIndex != -1 && foundHoldTime < HOLD_DURATION) {
-                foundHoldTime += 1.0f / 60.0f;
-                
-                // Keep the element elevated
-                if (foundIndex < currentPositions.size()) {
-                    currentPositions[foundIndex].y = cellPositions[foundIndex].y - 5.0f;
+            growPhase = appends ? GrowPhase::Drop : GrowPhase::Idle;
+        }
+        return growPhase != GrowPhase::Idle;
+    }
+
+    // Vertical offset of the new buffer while a reallocation is shown
+    float newBufferOffset() const {
+        if (growPhase == GrowPhase::Settle) return NEW_BUFFER_OFFSET * (1.f - growProgress);
+        return growPhase == GrowPhase::Copy || growPhase == GrowPhase::Free ? NEW_BUFFER_OFFSET : 0.f;
+    }
+
+    // Offset of moving element i from its slot in the old buffer
+    float growOffset(size_t i) const {
+        if (growPhase != GrowPhase::Copy) return newBufferOffset();
+        size_t arrived = static_cast<size_t>(copied);
+        if (i < arrived) return NEW_BUFFER_OFFSET;
+        return i == arrived ? NEW_BUFFER_OFFSET * (copied - arrived) : 0.f;
+    }
+
+    void stepGrow(bool& animationComplete) {
+        switch (growPhase) {
+            case GrowPhase::Copy:
+                // Slow enough to follow on a few cells, never longer than GROW_COPY_FRAMES
+                copied = std::min(static_cast<float>(copyCount),
+                                  copied + std::max(animationSpeed * 3.f, copyCount / GROW_COPY_FRAMES));
+                if (copied >= copyCount) {
+                    growPhase = GrowPhase::Free;
+                    growProgress = 0.f;
                 }
-                
-                // Highlight only the found element
-                highlightedIndices.clear();
-                highlightedIndices.push_back(foundIndex);
-                
-                // Ensure foundBounce is properly set for the found element
-                if (foundIndex < foundBounce.size()) {
-                    foundBounce[foundIndex] = 1.0f; // Maintain bounce state during hold
+                break;
+            case GrowPhase::Free:
+                growProgress += animationSpeed;
+                if (growProgress >= 1.f) {
+                    growPhase = GrowPhase::Settle;
+                    growProgress = 0.f;
                 }
-                
-                if (foundHoldTime >= HOLD_DURATION) {
-                    // Reset positions and states
-                    for (size_t i = 0; i < currentPositions.size(); ++i) {
-                        currentPositions[i] = cellPositions[i];
-                    }
-                    highlightedIndices.clear();
-                    foundBounce.assign(array.size(), 0.0f); // Clear all bounce states
-                    animationComplete = true;
-                    animating = false;
+                break;
+            case GrowPhase::Settle:
+                growProgress = std::min(1.f, growProgress + animationSpeed * 1.5f);
+                if (growProgress >= 1.f) {
+                    growPhase = growAppends ? GrowPhase::Drop : GrowPhase::Idle;
+                }
+                break;
+            case GrowPhase::Drop: {
+                size_t index = array.size() - 1;
+                sf::Vector2f& offset = displacement(index);
+                offset = offset * (1.f - animationSpeed);
+                if (offset.y * offset.y < 1.f) {
+                    settle(index);
+                    growPhase = GrowPhase::Idle;
                 }
+                break;
+            }
+            case GrowPhase::Idle:
+                break;
+        }
+
+        if (growPhase == GrowPhase::Copy || growPhase == GrowPhase::Free || growPhase == GrowPhase::Settle) {
+            // drawnPosition() places the moving cells from growOffset()
+            highlightedIndices.clear();
+            if (growPhase == GrowPhase::Copy) highlightedIndices.push_back(static_cast<size_t>(copied));
+            if (growAppends) highlightedIndices.push_back(array.size() - 1);
+        }
+
+        if (growPhase == GrowPhase::Idle) {
+            highlightedIndices.clear();
+            animationComplete = true;
+        }
+    }
+
+    // Outlines of the capacity: the spare slots, or while a reallocation is
+    // shown, the old buffer (fading once freed) and the new one below it
+    void drawSlots(RenderContext& window) {
+        float stride = cellWidth + 5.f;
+        auto outline = [&](size_t from, size_t to, float y, float alpha) {
+            size_t first, last;
+            visibleCellRange(viewLeft, viewRight, position.x, stride, to, first, last);
+            sf::RectangleShape slot(sf::Vector2f(cellWidth, cellHeight));
+            slot.setFillColor(sf::Color::Transparent);
+            slot.setOutlineThickness(2.f);
+            slot.setOutlineColor(sf::Color(120, 120, 120, static_cast<sf::Uint8>(255.f * alpha)));
+            for (size_t i = std::max(from, first); i < last; ++i) {
+                slot.setPosition(position.x + i * stride, y);
+                window.draw(slot);
+            }
+        };
+
+        if (growPhase == GrowPhase::Idle || growPhase == GrowPhase::Drop) {
+            outline(array.size() - (growPhase == GrowPhase::Drop ? 1 : 0), array.capacity(), position.y, 1.f);
+            return;
+        }
+        if (growPhase != GrowPhase::Settle) {
+            outline(0, oldCapacity, position.y, growPhase == GrowPhase::Free ? 1.f - growProgress : 1.f);
+        }
+        outline(0, array.capacity(), position.y + newBufferOffset(), 1.f);
+    }
+
+    bool reportsCapacity() const { return lastReport == Report::Capacity; }
+
+    // The report of whichever came last: a sort, a scan, a sorted search, or
+    // an append or reserve
+    std::string report() const {
+        if (lastReport == Report::Capacity) {
+            return "n = " + std::to_string(array.size()) + ", capacity " + std::to_string(array.capacity()) +
+                   " (growth " + core::growthPolicyName(array.growth()) + ")\n" + capacityReport;
+        }
+        if (lastReport == Report::Scan) {
+            return scanSummary();
+        }
+        return lastReport == Report::Search ? searchReport : sortSummary();
+    }
+
+    // Sequential or blelloch scan of the array. Small arrays replay it step by
+    // step; every run reports the native throughput of all the methods.
+    void scan(core::ScanMethod method, core::ScanKind kind, bool& animationComplete) {
+        currentOperation = Operation::Sort;
+
+        if (!scanning) {
+            if (timingNatively()) {
+                refuseWhileTiming(animationComplete);
                 return;
             }
-            
-            // Animate search
-            if (currentIndex < array.size()) {
-                highlightedIndices.clear();
-                highlightedIndices.push_back(currentIndex);
-                
-                searchProgress[currentIndex] += animationSpeed;
-                
-                if (searchProgress[currentIndex] >= 1.0f) {
-                    if (array[currentIndex] == value) {
-                        foundIndex = currentIndex;
-                        // Ensure foundBounce is properly sized
-                        if (foundBounce.size() <= foundIndex) {
-                            foundBounce.resize(foundIndex + 1, 0.0f);
-                        }
-                        foundBounce[foundIndex] = 1.0f; // Start bounce
-                        currentPositions[foundIndex].y = cellPositions[foundIndex].y - 5.0f;
-                        foundHoldTime = 0.0f;
-                    } else {
-                        currentIndex++;
-                    }
-                }
-            } else {
-                // Search complete (element not found)
-                animating = false;
+            const std::vector<int>& input = array.values();
+            scanMethod = method;
+            scanHeading = std::string(core::scanMethodName(method)) + " " + core::scanKindName(kind) +
+                          " scan, n = " + std::to_string(input.size());
+            lastReport = Report::Scan;
+
+            scanResult = input;
+            std::vector<int> scratch(input.size());
+            countNative(counterPanel, costMeter, scanHeading, input.size(),
+                        [&] { core::scan(method, kind, input.data(), scratch.data(), input.size()); });
+            if (input.size() > SORT_ANIMATE_LIMIT || !core::scanTraced(method, kind, scanResult, scanSteps) ||
+                scanSteps.empty()) {
+                startScanTiming(kind, input);
+                scanResult = std::move(scratch);
+                takeResult(scanResult);
+                scanSteps.clear();
                 animationComplete = true;
+                return;
             }
+            startScanTiming(kind, input);
+
+            scanNext = 0;
+            scanProgress = 0.f;
+            scanStepsPerFrame = std::max(animationSpeed * 2.f, scanSteps.size() / SORT_MAX_FRAMES);
+            scanning = true;
+            animationComplete = false;
+            return;
         }
-        
-        // Update bounce animation for found element
-        if (foundIndex != -1 && foundIndex < foundBounce.size() && foundBounce[foundIndex] > 0) {
-            foundBounce[foundIndex] -= animationSpeed * 0.5f;
-            if (foundBounce[foundIndex] < 0) foundBounce[foundIndex] = 0;
+
+        scanProgress += scanStepsPerFrame;
+        while (scanProgress >= 1.f && scanNext < scanSteps.size()) {
+            applyScanStep(scanSteps[scanNext++]);
+            scanProgress -= 1.f;
+        }
+
+        if (scanNext == scanSteps.size()) {
+            // The replay ends on these same values
+            takeResult(scanResult);
+            scanSteps.clear();
+            highlightedIndices.clear();
+            scanning = false;
+            animationComplete = true;
         }
     }
 
-    void updateValue(int index, int value, bool& animationComplete) {
-        currentOperation = Operation::Update;
-        
-        if (!updateAnimating) {
-            // Initialize update animation
-            if (index >= 0 && index < array.size()) {
-                updateIndex = index;
-                oldValue = array[index];
-                newValue = value;
-                updateAnimationProgress = 0.f;
-                
-                // Set initial positions
-                oldCellPosition = cellPositions[index];
-                newCellPosition = oldCellPosition - sf::Vector2f(0, 100); // Start above
-                
-                highlightedIndices.clear();
-                highlightedIndices.push_back(index);
-                
-                updateAnimating = true;
-                animationComplete = false;
+    void applyScanStep(const core::ScanStep& step) {
+        scanCurrent = step;
+        sortKind = core::SortStep::Write;
+        highlightedIndices.clear();
+        // Up-sweeps and carries only read the left element
+        bool writesLeft = step.kind == core::ScanStep::Down;
+        if (step.left != core::ScanStep::NO_INDEX) {
+            if (writesLeft) array.update(step.left, step.leftValue);
+            highlightedIndices.push_back(step.left);
+        }
+        if (step.right != core::ScanStep::NO_INDEX) {
+            array.update(step.right, step.rightValue);
+            highlightedIndices.push_back(step.right);
+        }
+    }
+
+    // Brackets over every pair the current blelloch level adds, the one just
+    // applied in white. A pair reaching into the padding ends at the last cell.
+    void drawScanLevel(RenderContext& window) {
+        size_t n = array.size();
+        size_t half = size_t(1) << scanCurrent.level;
+        float height = 8.f + 5.f * scanCurrent.level;
+        sf::Color color = scanCurrent.kind == core::ScanStep::Up ? searchingColor : highlightColor;
+        sf::VertexArray brackets(sf::Quads);
+        for (size_t right = 2 * half - 1, left = half - 1; left < n; right += 2 * half, left += 2 * half) {
+            size_t shown = std::min(right, n - 1);
+            float x0 = slotPosition(left).x + cellWidth / 2.f;
+            float x1 = slotPosition(shown).x + cellWidth / 2.f;
+            if (x1 < viewLeft || x0 > viewRight) continue;
+            float top = position.y - 4.f - height;
+            bool current = left == scanCurrent.left || right == scanCurrent.right;
+            sf::Color line = current ? sf::Color::White : color;
+            appendQuad(brackets, sf::Vector2f(x0 - 1.f, top), sf::Vector2f(2.f, height), line);
+            appendQuad(brackets, sf::Vector2f(x0 - 1.f, top), sf::Vector2f(x1 - x0 + 2.f, 2.f), line);
+            appendQuad(brackets, sf::Vector2f(x1 - 1.f, top), sf::Vector2f(2.f, height), line);
+        }
+        window.draw(brackets);
+    }
+
+    // Timed on a worker like the parallel sorts; draw() picks the rates up.
+    // Only call while !timingNatively().
+    void startScanTiming(core::ScanKind kind, const std::vector<int>& values) {
+        scanTiming = "Timing natively on at least " + std::to_string(SCAN_TIMING_ELEMENTS) + " values...";
+        scanTimingInFlight = std::async(std::launch::async, &ArrayVisualizer::timeScans, kind, values);
+    }
+
+    // Native GB/s of every scan method next to memcpy, on the array's values
+    // repeated out to SCAN_TIMING_ELEMENTS when it is smaller
+    static std::string timeScans(core::ScanKind kind, std::vector<int> values) {
+        std::vector<int> input(values);
+        if (input.size() < SCAN_TIMING_ELEMENTS) {
+            input.resize(SCAN_TIMING_ELEMENTS, 1);
+            for (size_t i = values.size(); !values.empty() && i < input.size(); ++i) {
+                input[i] = values[i % values.size()];
+            }
+        }
+        size_t hardware = std::max(1u, std::thread::hardware_concurrency());
+        core::ThreadPool pool(hardware);
+        const int runs = 3;
+        auto rate = [&](core::ScanMethod method) {
+            return core::scanGigabytesPerSecond(input.size(), core::scanNs(method, kind, input, &pool, runs));
+        };
+
+        char text[320];
+        std::snprintf(text, sizeof(text),
+                      "Native at n = %zu (%.0f MB): memcpy %.2f GB/s\n"
+                      "sequential %.2f   simd %s%.2f   (GB/s, 1 thread)\n"
+                      "chunked %.2f   blelloch %.2f   (GB/s, %zu threads)",
+                      input.size(), input.size() * sizeof(int) / 1048576.0,
+                      core::scanGigabytesPerSecond(input.size(), core::memcpyNs(input, runs)),
+                      rate(core::ScanMethod::Sequential), core::simdScanAvailable() ? "" : "(scalar) ",
+                      rate(core::ScanMethod::Simd), rate(core::ScanMethod::Chunked), rate(core::ScanMethod::Blelloch),
+                      hardware);
+        return text;
+    }
+
+    // The last scan's heading, where a replay has got to, and the native rates
+    std::string scanSummary() const {
+        if (scanHeading.empty()) {
+            return "";
+        }
+        std::string progress;
+        if (scanning) {
+            switch (scanCurrent.kind) {
+                case core::ScanStep::Carry:    progress = ": carrying the running sum"; break;
+                case core::ScanStep::Up:       progress = ": up-sweep, level " + std::to_string(scanCurrent.level); break;
+                case core::ScanStep::Clear:    progress = ": root cleared"; break;
+                case core::ScanStep::Down:     progress = ": down-sweep, level " + std::to_string(scanCurrent.level); break;
+                case core::ScanStep::AddInput: progress = ": adding the input back"; break;
+            }
+        }
+        return scanHeading + progress + "\n" + scanTiming;
+    }
+
+    // Counters of the last sort (live during a replay) and its native times
+    std::string sortSummary() const {
+        if (sortHeading.empty()) {
+            return "";
+        }
+        if (sortParallel) {
+            return sortHeading + "\n" + scalingText;
+        }
+        char counts[160];
+        std::snprintf(counts, sizeof(counts), "%llu comparisons   %llu swaps   %llu writes   ",
+                      static_cast<unsigned long long>(sortShown.comparisons),
+                      static_cast<unsigned long long>(sortShown.swaps),
+                      static_cast<unsigned long long>(sortShown.writes));
+        std::string auxiliary = "auxiliary: in place";
+        if (sortShown.auxiliaryBytes > 0) {
+            char bytes[48];
+            std::snprintf(bytes, sizeof(bytes), "auxiliary: %.1f KB", sortShown.auxiliaryBytes / 1024.0);
+            auxiliary = bytes;
+        }
+        return sortHeading + "\n" + counts + auxiliary + "\n" + sortTiming;
+    }
+};
+
+// Row-major matrices drawn as grids, each with its memory order as a strip
+// underneath, replaying a traced matrix kernel on small operands: touched
+// cells glow (blue for reads, orange for writes) and fade, written cells stay
+// tinted, and a blocked kernel's current tiles are outlined. Meanwhile the
+// kernel and its counterpart run natively at full size on a worker thread
+// (the UI thread keeps drawing beside it) and report their times.
+class MatrixVisualizer {
+private:
+    sf::Font& font;
+    sf::Vector2f position;
+    float cellSize;
+
+    struct Operand {
+        std::vector<float> heat;        // 1 when touched, fading each frame
+        std::vector<uint8_t> written;
+        std::vector<uint8_t> lastWrite; // Whether the latest touch wrote
+        bool hasTile = false;
+        core::MatrixStep tile{};
+    };
+
+    core::MatrixKernel kernel = core::MatrixKernel::RowMajor;
+    int operandCount = 0;
+    Operand operands[3];
+    std::vector<core::MatrixStep> steps;
+    size_t next = 0;
+    float progress = 0.f;
+    float stepsPerFrame = 1.f;
+
+    std::future<std::string> native;    // Timings in flight
+    std::string nativeText;
+    size_t nativeSize = 0;
+
+    sf::Color cellColor = sf::Color(45, 45, 60);
+    sf::Color writtenColor = sf::Color(40, 75, 105);
+    sf::Color readColor = sf::Color(100, 100, 255);
+    sf::Color writeColor = sf::Color(255, 165, 0);
+    sf::Color tileColor = sf::Color(255, 225, 25);
+
+    static sf::Color mix(sf::Color from, sf::Color to, float t) {
+        auto channel = [t](sf::Uint8 a, sf::Uint8 b) { return static_cast<sf::Uint8>(a + (b - a) * t); };
+        return sf::Color(channel(from.r, to.r), channel(from.g, to.g), channel(from.b, to.b));
+    }
+
+    sf::Color colorOf(const Operand& operand, size_t index) const {
+        sf::Color base = operand.written[index] ? writtenColor : cellColor;
+        float heat = operand.heat[index];
+        if (heat <= 0.f) return base;
+        return mix(base, operand.lastWrite[index] ? writeColor : readColor, heat);
+    }
+
+    sf::Vector2f gridOrigin(int m) const {
+        return position + sf::Vector2f(m * (ANIMATE_SIZE * cellSize + 40.f), 0.f);
+    }
+
+    void drawText(RenderContext& window, const std::string& string, sf::Vector2f pos, unsigned size,
+                  sf::Color color = sf::Color::White) {
+        sf::Text text(string, font, size);
+        text.setFillColor(color);
+        text.setPosition(pos);
+        window.draw(text);
+    }
+
+    void apply(const core::MatrixStep& step) {
+        Operand& operand = operands[step.matrix];
+        if (step.kind == core::MatrixStep::Tile) {
+            operand.tile = step;
+            operand.hasTile = true;
+            return;
+        }
+        size_t index = step.row * ANIMATE_SIZE + step.col;
+        operand.heat[index] = 1.f;
+        operand.lastWrite[index] = step.kind == core::MatrixStep::Write;
+        if (step.kind == core::MatrixStep::Write) operand.written[index] = 1;
+    }
+
+    // The kernel and its counterpart at n x n; runs on the worker thread
+    static std::string timeNative(core::MatrixKernel kernel, size_t n) {
+        core::MatrixKernel pair[2] = {kernel, core::matrixCounterpart(kernel)};
+        double ns[2] = {0.0, 0.0};
+        std::string lines = "Native at n = " + std::to_string(n) + " (tiles of " +
+                            std::to_string(core::MATRIX_TILE) + "):";
+        for (int k = 0; k < 2; ++k) {
+            std::string error;
+            if (!core::checkMatrixKernel(pair[k], n, error)) {
+                lines += "\n    Refused: " + error;
+                continue;
+            }
+            // Large operands run once; they take long enough to time alone
+            int runs = n <= 1024 && core::matrixOperands(pair[k]) < 3 ? 5 : 1;
+            core::MatrixTiming timing = core::timeMatrixKernel(pair[k], n, core::MATRIX_TILE, runs);
+            char rate[48];
+            std::snprintf(rate, sizeof(rate), ", %.2f %s", timing.rate, core::matrixRateUnit(pair[k]));
+            lines += "\n    " + std::string(core::matrixKernelName(pair[k])) + ": " +
+                     NativeCostMeter::formatNs(timing.ns) + rate;
+            ns[k] = timing.ns;
+        }
+        if (ns[0] > 0.0 && ns[1] > 0.0) {
+            char ratio[96];
+            std::snprintf(ratio, sizeof(ratio), "\n    %s takes %.2fx the time of %s", core::matrixKernelName(pair[0]),
+                          ns[0] / ns[1], core::matrixKernelName(pair[1]));
+            lines += ratio;
+        }
+        return lines;
+    }
+
+public:
+    // Edge of the animated matrices, and of their tiles
+    static constexpr size_t ANIMATE_SIZE = 12;
+    static constexpr size_t ANIMATE_TILE = 4;
+    // Longest replay in frames; long traces apply several steps a frame
+    static constexpr float MAX_FRAMES = 60.f * 15.f;
+    // Heat a touched cell keeps from one frame to the next
+    static constexpr float HEAT_DECAY = 0.9f;
+
+    MatrixVisualizer(sf::Font& fontRef, sf::Vector2f pos, float size)
+        : font(fontRef), position(pos), cellSize(size) {}
+
+    // Still replaying or timing
+    bool busy() const { return next < steps.size() || native.valid(); }
+
+    // Replays `matrixKernel` and times it against its counterpart at n x n.
+    // Only call while idle.
+    void start(core::MatrixKernel matrixKernel, size_t n) {
+        kernel = matrixKernel;
+        operandCount = core::matrixOperands(kernel);
+        for (Operand& operand : operands) {
+            operand = Operand();
+            operand.heat.assign(ANIMATE_SIZE * ANIMATE_SIZE, 0.f);
+            operand.written.assign(ANIMATE_SIZE * ANIMATE_SIZE, 0);
+            operand.lastWrite.assign(ANIMATE_SIZE * ANIMATE_SIZE, 0);
+        }
+        steps = core::traceMatrixKernel(kernel, ANIMATE_SIZE, ANIMATE_TILE);
+        next = 0;
+        progress = 0.f;
+        stepsPerFrame = std::max(0.25f, steps.size() / MAX_FRAMES);
+
+        nativeSize = n;
+        nativeText = "Timing natively at n = " + std::to_string(n) + "...";
+        native = std::async(std::launch::async, &MatrixVisualizer::timeNative, kernel, n);
+    }
+
+    void update() {
+        for (int m = 0; m < operandCount; ++m) {
+            for (float& heat : operands[m].heat) {
+                heat = heat < 0.02f ? 0.f : heat * HEAT_DECAY;
             }
-        } else {
-            // Update animation progress
-            updateAnimationProgress += animationSpeed * 0.5f;
-            
-            // Animate both cells simultaneously
-            float progress = std::min(updateAnimationProgress, 1.0f);
-            
-            // Old cell slides down
-            oldCellPosition.y = cellPositions[updateIndex].y + 100.0f * progress;
-            
-            // New cell comes down from above
-            newCellPosition.y = cellPositions[updateIndex].y - 100.0f * (1.0f - progress);
-            
-            // Update actual array value at 50% progress
-            if (updateAnimationProgress >= 0.5f && array[updateIndex] != newValue) {
-                array[updateIndex] = newValue;
+        }
+        progress += stepsPerFrame;
+        while (progress >= 1.f && next < steps.size()) {
+            apply(steps[next++]);
+            progress -= 1.f;
+        }
+        if (next == steps.size()) {
+            for (Operand& operand : operands) operand.hasTile = false;
+        }
+        if (native.valid() && native.wait_for(std::chrono::seconds(0)) == std::future_status::ready) {
+            nativeText = native.get();
+        }
+    }
+
+    void draw(RenderContext& window) {
+        static const char* labels[] = {"A", "B = A^T", "C = A x B"};
+        const float stride = cellSize;
+        sf::VertexArray cells(sf::Quads);
+
+        for (int m = 0; m < operandCount; ++m) {
+            const Operand& operand = operands[m];
+            sf::Vector2f origin = gridOrigin(m);
+            drawText(window, m == 1 && operandCount == 3 ? "B" : labels[m], origin - sf::Vector2f(0.f, 26.f), 18);
+            for (size_t row = 0; row < ANIMATE_SIZE; ++row) {
+                for (size_t col = 0; col < ANIMATE_SIZE; ++col) {
+                    appendQuad(cells, origin + sf::Vector2f(col * stride, row * stride),
+                               sf::Vector2f(stride - 2.f, stride - 2.f), colorOf(operand, row * ANIMATE_SIZE + col));
+                }
             }
-            
-            // Complete animation
-            if (updateAnimationProgress >= 1.0f) {
-                array[updateIndex] = newValue; // Ensure final value
-                updateCellPositions();
-                currentPositions = cellPositions;
-                
-                updateAnimating = false;
-                animationComplete = true;
-                highlightedIndices.clear();
+        }
+
+        // The same cells in the order they sit in memory
+        float gridBottom = position.y + ANIMATE_SIZE * stride;
+        float stripLeft = position.x + 20.f;
+        float stripCell = (gridOrigin(2).x + ANIMATE_SIZE * stride - stripLeft) / (ANIMATE_SIZE * ANIMATE_SIZE);
+        if (operandCount > 0) {
+            drawText(window, "In memory, row after row:", {position.x, gridBottom + 8.f}, 14, sf::Color(180, 180, 180));
+        }
+        for (int m = 0; m < operandCount; ++m) {
+            float y = gridBottom + 34.f + m * 24.f;
+            drawText(window, std::string(1, static_cast<char>('A' + m)), {position.x, y - 2.f}, 14);
+            for (size_t index = 0; index < ANIMATE_SIZE * ANIMATE_SIZE; ++index) {
+                // A wider gap between rows
+                float gap = index % ANIMATE_SIZE == ANIMATE_SIZE - 1 ? 2.f : 0.5f;
+                appendQuad(cells, sf::Vector2f(stripLeft + index * stripCell, y),
+                           sf::Vector2f(std::max(1.f, stripCell - gap), 16.f), colorOf(operands[m], index));
             }
         }
+        window.draw(cells);
+
+        // Tiles in progress
+        for (int m = 0; m < operandCount; ++m) {
+            const Operand& operand = operands[m];
+            if (!operand.hasTile) continue;
+            sf::RectangleShape outline(sf::Vector2f(operand.tile.cols * stride - 2.f, operand.tile.rows * stride - 2.f));
+            outline.setPosition(gridOrigin(m) + sf::Vector2f(operand.tile.col * stride, operand.tile.row * stride));
+            outline.setFillColor(sf::Color::Transparent);
+            outline.setOutlineThickness(3.f);
+            outline.setOutlineColor(tileColor);
+            window.draw(outline);
+        }
     }
 
+    std::string report() const {
+        if (operandCount == 0) {
+            return "Pick a kernel to replay it on " + std::to_string(ANIMATE_SIZE) + " x " +
+                   std::to_string(ANIMATE_SIZE) + " matrices and time it natively";
+        }
+        std::string heading = std::string(core::matrixKernelName(kernel)) + " on " + std::to_string(ANIMATE_SIZE) +
+                              " x " + std::to_string(ANIMATE_SIZE);
+        if (kernel == core::MatrixKernel::BlockedTranspose || kernel == core::MatrixKernel::TiledMultiply) {
+            heading += ", tiles of " + std::to_string(ANIMATE_TILE);
+        }
+        heading += ": step " + std::to_string(next) + " of " + std::to_string(steps.size());
+        return heading + "\n" + nativeText;
+    }
 };
 
 class StringVisualizer{
 private:    
-    std::string text;
+    core::String text;
     sf::Vector2f position;
     sf::Font& font;
-    std::vector<sf::RectangleShape> characterBoxes;
-    std::vector<sf::Text> characterTexts;
-    std::vector<sf::Text> indexTexts;
-    float indexTextOffset = 10.f; 
     float boxWidth, boxHeight;
 
-    std::vector<sf::Vector2f> currentPositions; // Actual drawn positions
-    std::vector<sf::Vector2f> cellPositions;   
+    // Layout is worked out per frame for the visible window only: character i
+    // sits at position.x + i * boxWidth - scrollX, so a megabyte of text costs
+    // no per-character positions. The few characters an animation moves off
+    // their slot carry an offset here.
+    double scrollX = 0.0;       // Double: slots of long texts are past float's exact range
+    std::vector<std::pair<size_t, sf::Vector2f>> displaced;
     
     Operation currentOperation = Operation::None;
 
@@ -1009,7 +3365,11 @@ private:
     sf::Color removingColor;     // Color for removal
     sf::Color searchingColor;    // Color for cells being searched
     sf::Color foundColor;       // Color for found element
-    std::vector<float> foundBounce;  // For the found element bounce effect
+
+    // The found match [foundFirst, foundLast) bounces
+    size_t foundFirst = 0;
+    size_t foundLast = 0;
+    float foundBounce = 0.f;
 
     // Variables for update animation
     bool updateAnimating = false;
@@ -1020,9 +3380,72 @@ private:
     sf::Vector2f oldCellPosition;
     sf::Vector2f newCellPosition;
 
+    // Characters shifted together by insert/remove
+    CellBlock shiftBlock;
+    float viewLeft = 0.f;       // Horizontal extent of the view at the last draw
+    float viewRight = 1200.f;
+
+    sf::VertexArray aggregateBatch{sf::Quads};  // Boxes batched at QualityTier::Aggregate
+
+    // A search animates at most this many positions before the match (or the
+    // end); the rest of the text is scanned natively
+    static const size_t SEARCH_RUN_UP = 24;
+
+    bool isFound(size_t i) const { return foundBounce > 0 && i >= foundFirst && i < foundLast; }
+
+    sf::Color cellColor(size_t i) const {
+        if (std::find(highlightedIndices.begin(), highlightedIndices.end(), i) == highlightedIndices.end()) {
+            return defaultColor;
+        }
+        if (isFound(i)) {
+            return foundColor;
+        } else if (currentOperation == Operation::Insert) {
+            return insertingColor;
+        } else if (currentOperation == Operation::Remove) {
+            return removingColor;
+        }
+        return searchingColor;
+    }
+
+    sf::Vector2f slotPosition(size_t i) const {
+        return sf::Vector2f(position.x + static_cast<float>(i * static_cast<double>(boxWidth) - scrollX), position.y);
+    }
+
+    sf::Vector2f drawnPosition(size_t i) const {
+        for (const auto& cell : displaced) {
+            if (cell.first == i) return slotPosition(i) + cell.second;
+        }
+        return slotPosition(i);
+    }
+
+    sf::Vector2f& displacement(size_t i) {
+        for (auto& cell : displaced) {
+            if (cell.first == i) return cell.second;
+        }
+        displaced.emplace_back(i, sf::Vector2f(0.f, 0.f));
+        return displaced.back().second;
+    }
+
+    void clampScroll() {
+        // The row may scroll until its last character reaches the right edge
+        double maxScroll = std::max(0.0, text.size() * static_cast<double>(boxWidth) - (viewRight - position.x) + boxWidth);
+        scrollX = std::min(std::max(scrollX, 0.0), maxScroll);
+    }
+
+    // Scrolls just far enough that character i is on screen
+    void scrollToShow(size_t i) {
+        float x = slotPosition(i).x;
+        if (x < viewLeft + boxWidth) {
+            scrollX -= viewLeft + boxWidth - x;
+        } else if (x + 2 * boxWidth > viewRight) {
+            scrollX += x + 2 * boxWidth - viewRight;
+        }
+        clampScroll();
+    }
 
 public:
     float animationSpeed = 0.03f;    
+    QualityTier quality = QualityTier::Full;
 
 public:
     StringVisualizer(sf::Font& fontRef, sf::Vector2f pos, float width,
@@ -1035,81 +3458,133 @@ public:
         searchingColor(sf::Color(100, 100, 255)), // Light blue (searching)
         foundColor(sf::Color(0, 255, 0))         // Bright green (found)
         {
-            text = "Hello";
-            updatecellPosition();
-            // Initialize current positions to match cell positions
-            currentPositions = cellPositions;
+            text = core::String("Hello");
         }      
 
-    std::string getString(){
-        return text;
+    const std::string& getString() const {
+        return text.str();
     }
 
-    void updatecellPosition(){
-        cellPositions.clear();
-        for (size_t i = 0; i < text.size(); ++i) {
-            cellPositions.emplace_back(
-                position.x + (i * boxWidth),
-                position.y
-            );
+    // Replace the contents without animating. Only call while idle.
+    void load(std::string value) {
+        text = core::String(std::move(value));
+        highlightedIndices.clear();
+        displaced.clear();
+        foundBounce = 0.f;
+        shiftBlock.clear();
+        scrollX = 0.0;
+    }
+
+    // Characters [first, last) are on screen
+    void visibleRange(size_t& first, size_t& last) const {
+        double left = scrollX + (viewLeft - position.x);
+        double right = scrollX + (viewRight - position.x);
+        double lo = std::floor(left / boxWidth) - 1.0;
+        double hi = std::ceil(right / boxWidth) + 2.0;
+        first = lo <= 0.0 ? 0 : std::min(text.size(), static_cast<size_t>(lo));
+        last = hi <= 0.0 ? 0 : std::min(text.size(), static_cast<size_t>(hi));
+    }
+
+    // Arrow keys step a character, Page Up/Down a screen, Home/End jump to
+    // the ends; the mouse wheel scrolls three characters a notch. Only call
+    // while idle: shifting blocks are baked at fixed positions.
+    void handleScrollEvent(const sf::Event& event) {
+        double page = std::max(1.0, std::floor((viewRight - viewLeft) / boxWidth) - 2.0) * boxWidth;
+        if (event.type == sf::Event::MouseWheelScrolled) {
+            scrollX -= event.mouseWheelScroll.delta * 3.0 * boxWidth;
+        } else if (event.type == sf::Event::KeyPressed) {
+            switch (event.key.code) {
+                case sf::Keyboard::Left:     scrollX -= boxWidth; break;
+                case sf::Keyboard::Right:    scrollX += boxWidth; break;
+                case sf::Keyboard::PageUp:   scrollX -= page; break;
+                case sf::Keyboard::PageDown: scrollX += page; break;
+                case sf::Keyboard::Home:     scrollX = 0.0; break;
+                case sf::Keyboard::End:      scrollX = text.size() * static_cast<double>(boxWidth); break;
+                default: return;
+            }
+        } else {
+            return;
         }
-        currentPositions.resize(cellPositions.size());
+        clampScroll();
+    }
+
+    // Bake characters [blockFirst, text.size()) into the shift block, keeping
+    // only the ones that can be on screen.
+    void startShiftBlock(size_t blockFirst, sf::Color fillColor, sf::Vector2f startOffset) {
+        size_t bakeFirst, bakeLast;
+        visibleRange(bakeFirst, bakeLast);
+        shiftBlock.build([this](size_t i) { return slotPosition(i); }, blockFirst, text.size(),
+                         bakeFirst, bakeLast, sf::Vector2f(boxWidth, boxHeight), fillColor, startOffset);
     }
 
-    void draw(sf::RenderWindow& window){
+    void draw(RenderContext& window){
+        const sf::View& view = window.getView();
+        viewLeft = view.getCenter().x - view.getSize().x / 2.f;
+        viewRight = view.getCenter().x + view.getSize().x / 2.f;
 
-        for(size_t i = 0; i <text.size(); ++i){
+        size_t firstVisible, lastVisible;
+        visibleRange(firstVisible, lastVisible);
+
+        // Shifting boxes go out in one draw; only their labels are per cell
+        shiftBlock.draw(window);
+
+        for(size_t i = firstVisible; i < lastVisible; ++i){
 
             // Skip drawing the original cell if it's the one being updated and we're animating
             if (updateAnimating && i == updateIndex) {
                 continue;
             }
 
-            float x = currentPositions[i].x;
-            float y = currentPositions[i].y;
+            bool inBlock = shiftBlock.contains(i);
+            sf::Vector2f cell = drawnPosition(i);
+            float x = cell.x;
+            float y = cell.y;
+            if (inBlock) {
+                x += shiftBlock.getOffset().x;
+                y += shiftBlock.getOffset().y;
+            }
 
             // Apply bounce effect if this is the found element
             float bounceOffset = 0.0f;
-            if (i < foundBounce.size() && foundBounce[i] > 0) {
-                bounceOffset = -30.0f * foundBounce[i] * foundBounce[i];
+            if (isFound(i) && quality < QualityTier::NoCellText) {
+                bounceOffset = -30.0f * foundBounce * foundBounce;
             }
 
-            // draw box
-            sf::RectangleShape box(sf::Vector2f(boxWidth, boxHeight));
-            box.setPosition(x, y + bounceOffset);
+            if (!inBlock && quality == QualityTier::Aggregate) {
+                appendQuad(aggregateBatch, sf::Vector2f(x, y), sf::Vector2f(boxWidth, boxHeight), cellColor(i));
+            } else if (!inBlock) {
+                // draw box
+                sf::RectangleShape box(sf::Vector2f(boxWidth, boxHeight));
+                box.setPosition(x, y + bounceOffset);
 
-            // Determine cell color
-            if (std::find(highlightedIndices.begin(), highlightedIndices.end(), i) != highlightedIndices.end()) {
-                if (i < foundBounce.size() && foundBounce[i] > 0) {
-                    box.setFillColor(foundColor);
-                } else if (currentOperation == Operation::Insert) {
-                    box.setFillColor(insertingColor);
-                } else if (currentOperation == Operation::Remove) {
-                    box.setFillColor(removingColor);
-                } else {
-                    box.setFillColor(searchingColor);
-                }
-            } else {
-                box.setFillColor(defaultColor);
+                box.setFillColor(cellColor(i));
+                box.setOutlineThickness(quality < QualityTier::NoOutlines ? 2.f : 0.f);
+                box.setOutlineColor(sf::Color::Black);
+                window.draw(box);
             }
 
-            box.setOutlineThickness(2.f);
-            box.setOutlineColor(sf::Color::Black);
-            window.draw(box);
-
-            // draw index
-            sf::Text indexText(std::to_string(i), font, 16);
-            indexText.setPosition(x + boxWidth/2 - indexText.getLocalBounds().width/2, 
-                                y + boxHeight + 5 + bounceOffset);
-            indexText.setFillColor(sf::Color::White);
-            window.draw(indexText);
+            // draw index (every fifth once indices are wider than a box)
+            if (quality == QualityTier::Full && (i < 10000 || i % 5 == 0)) {
+                sf::Text indexText(std::to_string(i), font, 16);
+                indexText.setPosition(x + boxWidth/2 - indexText.getLocalBounds().width/2, 
+                                    y + boxHeight + 5 + bounceOffset);
+                indexText.setFillColor(sf::Color::White);
+                window.draw(indexText);
+            }
 
             // draw value
-            sf::Text valueText(std::string(1, text[i]), font, 18);
-            valueText.setPosition(x + boxWidth/2 - valueText.getLocalBounds().width/2, 
-                                y + boxHeight/2 - valueText.getLocalBounds().height/2 + bounceOffset);
-            valueText.setFillColor(sf::Color::White);
-            window.draw(valueText);
+            if (quality < QualityTier::NoCellText) {
+                sf::Text valueText(std::string(1, text[i]), font, 18);
+                valueText.setPosition(x + boxWidth/2 - valueText.getLocalBounds().width/2, 
+                                    y + boxHeight/2 - valueText.getLocalBounds().height/2 + bounceOffset);
+                valueText.setFillColor(sf::Color::White);
+                window.draw(valueText);
+            }
+        }
+
+        if (quality == QualityTier::Aggregate) {
+            window.draw(aggregateBatch);
+            aggregateBatch.clear();
         }
 
         // Draw the updating cells if we're in an update animation
@@ -1155,40 +3630,29 @@ public:
 
         currentOperation = Operation::Insert;
         static bool animating = false;
-        static size_t insertIndex = 0;
-        static std::vector<sf::Vector2f> startPositions;
 
         if(!animating){
             // Start insertion
             if(index >=0 && index <= text.size()){
                 text.insert(index, value);
-                updatecellPosition();
-
-
-                // Set start positions for animation
-                startPositions = cellPositions;
-
+                scrollToShow(index);
+                displaced.clear();
 
                 // New characters start above
                 for(size_t i = index; i < index + value.size(); i++) {
-                    startPositions[i] = sf::Vector2f(position.x + i * boxWidth, position.y - 100);
+                    displacement(i) = sf::Vector2f(0.f, -100.f);
                 }
                 
-                // Existing characters start shifted left
-                for(size_t i = index + value.size(); i < text.size(); i++) {
-                    startPositions[i] = sf::Vector2f(position.x + (i - value.size()) * boxWidth, position.y);
-                }
+                // Existing characters start shifted left, as one block
+                startShiftBlock(index + value.size(), insertingColor,
+                                sf::Vector2f(-(value.size() * boxWidth), 0.f));
 
-                currentPositions = startPositions;
-                insertIndex = index;
                 animating = true;
                 animationComplete = false;
 
-                
-
-                // Highlight cells that will move (the inserted cell and all to its right)
+                // Highlight the inserted characters
                 highlightedIndices.clear();
-                for (size_t i = index; i < text.size(); ++i) {
+                for (size_t i = index; i < index + value.size(); ++i) {
                     highlightedIndices.push_back(i);
                 }
             } 
@@ -1196,23 +3660,27 @@ public:
         else{
             // Animate insertion
             bool allComplete = true;
-            for (size_t i = 0; i < text.size(); ++i) {
-                if (i >= insertIndex) {
-                    currentPositions[i] = currentPositions[i] + (cellPositions[i] - currentPositions[i]) * animationSpeed;
-                    
-                    float dx = cellPositions[i].x - currentPositions[i].x;
-                    float dy = cellPositions[i].y - currentPositions[i].y;
-                    float distanceSquared = dx*dx + dy*dy;
-                    
-                    if (distanceSquared >= 1.0f) {
-                        allComplete = false;
-                    } else {
-                        currentPositions[i] = cellPositions[i];
-                    }
+            for (auto& cell : displaced) {
+                cell.second = cell.second * (1.f - animationSpeed);
+                
+                float distanceSquared = cell.second.x * cell.second.x + cell.second.y * cell.second.y;
+                
+                if (distanceSquared >= 1.0f) {
+                    allComplete = false;
+                } else {
+                    cell.second = sf::Vector2f(0.f, 0.f);
                 }
             }
+
+            shiftBlock.setOffset(shiftBlock.getOffset() * (1.f - animationSpeed));
+            float blockDx = shiftBlock.getOffset().x;
+            if (blockDx * blockDx >= 1.0f) {
+                allComplete = false;
+            }
             
             if (allComplete) {
+                shiftBlock.clear();
+                displaced.clear();
                 animating = false;
                 animationComplete = true;
                 highlightedIndices.clear(); // Clear highlights when done
@@ -1225,62 +3693,42 @@ public:
         currentOperation = Operation::Remove;
         static bool animating = false;
         static size_t removeIndex = 0;
-        static std::vector<sf::Vector2f> startPositions;
-        static std::vector<sf::Vector2f> targetPositions;
         static float animationProgress = 0.f;
-        static int removedValue = 0;  
     
         if (!animating) {
             // Start removal
             if (index >= 0 && index < text.size()) {
-                removedValue = text[index];
                 removeIndex = index;
+                animationProgress = 0.f;
+                scrollToShow(index);
+                displaced.clear();
                 
-                // Store current positions
-                startPositions = currentPositions;
-                
-                // Calculate target positions (shift left for right neighbors)
-                targetPositions = startPositions;
-                targetPositions.erase(targetPositions.begin() + index);
-                
-                for (size_t i = index; i < targetPositions.size(); ++i) {
-                    targetPositions[i].x = startPositions[i+1].x - (boxWidth);
-                }
+                // Right neighbors shift left together as one block
+                startShiftBlock(index + 1, removingColor, sf::Vector2f(0.f, 0.f));
                 
                 animating = true;
                 animationComplete = false;
                 
-                // Highlight cells that will move (the removed cell and all to its right)
                 highlightedIndices.clear();
                 highlightedIndices.push_back(index); // The cell being removed
-                for (size_t i = index + 1; i < text.size(); ++i) {
-                    highlightedIndices.push_back(i); // Cells shifting left
-                }
             }
         } else {
             // Animate removal
             animationProgress += animationSpeed;
+            float progress = std::min(animationProgress, 1.0f);
             
             // 1. Animate the removed cell sliding down
-            if (removeIndex < currentPositions.size()) {
-                currentPositions[removeIndex].y = startPositions[removeIndex].y + 
-                    (100.f * animationProgress);
-            }
+            displacement(removeIndex).y = 100.f * progress;
             
             // 2. Animate neighboring cells shifting left
-            for (size_t i = 0; i < currentPositions.size(); ++i) {
-                if (i != removeIndex && i >= removeIndex) {
-                    currentPositions[i].x = startPositions[i].x + 
-                        (targetPositions[i-1].x - startPositions[i].x) * animationProgress;
-                }
-            }
+            shiftBlock.setOffset(sf::Vector2f(-boxWidth * progress, 0.f));
             
             // Check if animation is complete
             if (animationProgress >= 1.0f) {
                 // Actually remove the element
-                text.erase(removeIndex, 1);
-                updatecellPosition();
-                currentPositions = cellPositions;
+                text.remove(removeIndex);
+                displaced.clear();
+                shiftBlock.clear();
                 
                 animating = false;
                 animationComplete = true;
@@ -1299,9 +3747,10 @@ public:
                 oldValue = text[index];
                 newValue = value;
                 updateAnimationProgress = 0.f;
+                scrollToShow(index);
                 
                 // Set initial positions
-                oldCellPosition = cellPositions[index];
+                oldCellPosition = slotPosition(index);
                 newCellPosition = oldCellPosition - sf::Vector2f(0, 100); // Start above
                 
                 highlightedIndices.clear();
@@ -1319,21 +3768,19 @@ public:
             float progress = std::min(updateAnimationProgress, 1.0f);
             
             // Old cell slides down
-            oldCellPosition.y = cellPositions[updateIndex].y + 100.0f * progress;
+            oldCellPosition.y = slotPosition(updateIndex).y + 100.0f * progress;
             
             // New cell comes down from above
-            newCellPosition.y = cellPositions[updateIndex].y - 100.0f * (1.0f - progress);
+            newCellPosition.y = slotPosition(updateIndex).y - 100.0f * (1.0f - progress);
             
             //updates value at 50% progress:
             if (updateAnimationProgress >= 0.5f && text[updateIndex] != newValue) {
-                text[updateIndex] = newValue;
+                text.update(updateIndex, newValue);
             }
 
             // Complete animation
             if (updateAnimationProgress >= 1.0f) {
-                text[updateIndex] = newValue; // Ensure final value
-                updatecellPosition();
-                currentPositions = cellPositions;
+                text.update(updateIndex, newValue); // Ensure final value
                 
                 updateAnimating = false;
                 animationComplete = true;
@@ -1342,57 +3789,57 @@ public:
         }
     }
 
-    void search(int value, bool& animationComplete) {
+    // Looks for the first occurrence of `pattern`. The match is found natively
+    // up front; only the last SEARCH_RUN_UP positions before it (or before the
+    // end, if there is none) are stepped through on screen.
+    void search(const std::string& pattern, bool& animationComplete) {
         currentOperation = Operation::Search;
         static bool animating = false;
         static size_t currentIndex = 0;
-        static int foundIndex = -1;
-        static std::vector<float> searchProgress;
+        static size_t scanEnd = 0;
+        static size_t match = core::npos;
+        static bool found = false;
+        static float searchProgress = 0.0f;
         static float foundHoldTime = 0.0f;
         static const float HOLD_DURATION = 2.0f;
         
         if (!animating) {
             // Reset positions and states when starting new search
-            for (size_t i = 0; i < currentPositions.size(); ++i) {
-                currentPositions[i] = cellPositions[i];
-            }
+            displaced.clear();
             
             // Initialize search state
-            foundIndex = -1;
-            currentIndex = 0;
+            match = text.find(pattern);
+            if (match != core::npos) {
+                scanEnd = match + 1;
+            } else {
+                scanEnd = text.size() >= pattern.size() ? text.size() - pattern.size() + 1 : 0;
+            }
+            currentIndex = scanEnd > SEARCH_RUN_UP ? scanEnd - SEARCH_RUN_UP : 0;
+            found = false;
             foundHoldTime = 0.0f;
-            searchProgress.assign(text.size(), 0.0f);
-            foundBounce.assign(text.size(), 0.0f); // Clear all bounce states
+            searchProgress = 0.0f;
+            foundBounce = 0.0f; // Clear the bounce state
             animating = true;
             animationComplete = false;
             highlightedIndices.clear();
 
         } else {
             // If we've found an element and are in the hold phase
-            if (foundIndex != -1 && foundHoldTime < HOLD_DURATION) {
+            if (found && foundHoldTime < HOLD_DURATION) {
                 foundHoldTime += 1.0f / 60.0f;
                 
-                // Keep the element elevated
-                if (foundIndex < currentPositions.size()) {
-                    currentPositions[foundIndex].y = cellPositions[foundIndex].y - 5.0f;
-                }
-                
-                // Highlight only the found element
+                // Highlight only the found characters, kept elevated and bouncing
                 highlightedIndices.clear();
-                highlightedIndices.push_back(foundIndex);
-                
-                // Ensure foundBounce is properly set for the found element
-                if (foundIndex < foundBounce.size()) {
-                    foundBounce[foundIndex] = 1.0f; // Maintain bounce state during hold
+                for (size_t i = foundFirst; i < foundLast; ++i) {
+                    highlightedIndices.push_back(i);
                 }
+                foundBounce = 1.0f; // Maintain bounce state during hold
                 
                 if (foundHoldTime >= HOLD_DURATION) {
                     // Reset positions and states
-                    for (size_t i = 0; i < currentPositions.size(); ++i) {
-                        currentPositions[i] = cellPositions[i];
-                    }
+                    displaced.clear();
                     highlightedIndices.clear();
-                    foundBounce.assign(text.size(), 0.0f); // Clear all bounce states
+                    foundBounce = 0.0f; // Clear the bounce state
                     animationComplete = true;
                     animating = false;
                 }
@@ -1400,21 +3847,27 @@ public:
             }
             
             // Animate search
-            if (currentIndex < text.size()) {
+            if (currentIndex < scanEnd) {
+                size_t windowEnd = std::min(text.size(), currentIndex + pattern.size());
+                scrollToShow(windowEnd - 1);
+                scrollToShow(currentIndex);
                 highlightedIndices.clear();
-                highlightedIndices.push_back(currentIndex);
+                for (size_t i = currentIndex; i < windowEnd; ++i) {
+                    highlightedIndices.push_back(i);
+                }
                 
-                searchProgress[currentIndex] += animationSpeed;
+                searchProgress += animationSpeed;
                 
-                if (searchProgress[currentIndex] >= 1.0f) {
-                    if (text[currentIndex] == value) {
-                        foundIndex = currentIndex;
-                        // Ensure foundBounce is properly sized
-                        if (foundBounce.size() <= foundIndex) {
-                            foundBounce.resize(foundIndex + 1, 0.0f);
+                if (searchProgress >= 1.0f) {
+                    searchProgress = 0.0f;
+                    if (currentIndex == match) {
+                        found = true;
+                        foundFirst = currentIndex;
+                        foundLast = windowEnd;
+                        foundBounce = 1.0f; // Start bounce
+                        for (size_t i = foundFirst; i < foundLast; ++i) {
+                            displacement(i) = sf::Vector2f(0.f, -5.0f);
                         }
-                        foundBounce[foundIndex] = 1.0f; // Start bounce
-                        currentPositions[foundIndex].y = cellPositions[foundIndex].y - 5.0f;
                         foundHoldTime = 0.0f;
                     } else {
                         currentIndex++;
@@ -1422,15 +3875,16 @@ public:
                 }
             } else {
                 // Search complete (element not found)
+                highlightedIndices.clear();
                 animating = false;
                 animationComplete = true;
             }
         }
         
         // Update bounce animation for found element
-        if (foundIndex != -1 && foundIndex < foundBounce.size() && foundBounce[foundIndex] > 0) {
-            foundBounce[foundIndex] -= animationSpeed * 0.5f;
-            if (foundBounce[foundIndex] < 0) foundBounce[foundIndex] = 0;
+        if (found && foundBounce > 0) {
+            foundBounce -= animationSpeed * 0.5f;
+            if (foundBounce < 0) foundBounce = 0;
         }
     }
 
@@ -1451,6 +3905,8 @@ public:
     Node* tail;
     int size;
 
+    core::LinkedList list;  // Headless model; the nodes above mirror it for layout
+
     // Visualization properties
     sf::Vector2f basePosition;
     float nodeWidth;
@@ -1482,8 +3938,14 @@ public:
 
     Operation currentOperation = Operation::None;
 
+    sf::VertexArray aggregateNodes{sf::Quads};  // Nodes batched at QualityTier::Aggregate
+    sf::VertexArray aggregateLinks{sf::Lines};  // Arrows batched at QualityTier::Aggregate
+
 public:
     float animationSpeed = 0.03f;    
+    QualityTier quality = QualityTier::Full;
+    CounterPanel* counterPanel = nullptr;  // Optional hardware counter readout
+    NativeCostMeter* costMeter = nullptr;  // Optional native timing (comparison screen)
 public:
     Linkedlistvisualizer(sf::Font& fontRef, sf::Vector2f pos, 
         float width, float height)
@@ -1510,12 +3972,35 @@ public:
             node3->next = node4;
             tail = node4;
             size = 4;
+            for (int value : {10, 20, 30, 40}) {
+                list.pushBack(value);
+            }
             updateNodePositions();
         }
     ~Linkedlistvisualizer() {
         clear();
     } 
 
+    // Replace the contents without animating. Only call while idle.
+    void load(const std::vector<int>& values) {
+        clear();
+        list.clear();
+        for (int value : values) {
+            Node* node = new Node(value);
+            if (tail != nullptr) {
+                tail->next = node;
+            } else {
+                head = node;
+            }
+            tail = node;
+            list.pushBack(value);
+        }
+        size = static_cast<int>(values.size());
+        highlightedIndices.clear();
+        foundBounce.clear();
+        updateNodePositions();
+    }
+
     void updateNodePositions() {
         Node* current = head;
         int index = 0;
@@ -1529,7 +4014,7 @@ public:
         }
     }
 
-    void draw(sf::RenderWindow& window) {
+    void draw(RenderContext& window) {
         // Draw all nodes and arrows
         Node* current = head;
         int index = 1;  // Track node position (1-based)
@@ -1544,7 +4029,7 @@ public:
     
             // Calculate bounce offset if this node is found during search
             float bounceOffset = 0.0f;
-            if (index < foundBounce.size() && foundBounce[index] > 0) {
+            if (index < foundBounce.size() && foundBounce[index] > 0 && quality < QualityTier::NoCellText) {
                 bounceOffset = -30.0f * foundBounce[index] * foundBounce[index];
             }
     
@@ -1553,6 +4038,19 @@ public:
             sf::Vector2f nodePosition = current->position;
             nodePosition.y += bounceOffset;  // Apply bounce effect
             nodeRect.setPosition(nodePosition);
+
+            if (quality == QualityTier::Aggregate) {
+                bool highlighted = std::find(highlightedIndices.begin(), highlightedIndices.end(), index) != highlightedIndices.end();
+                appendQuad(aggregateNodes, nodePosition, sf::Vector2f(nodeWidth, nodeHeight),
+                           highlighted ? searchingColor : defaultColor);
+                if (current->next != nullptr && !(isAnimating && current->next == newNode)) {
+                    aggregateLinks.append(sf::Vertex(nodePosition + sf::Vector2f(nodeWidth, nodeHeight/2), sf::Color::White));
+                    aggregateLinks.append(sf::Vertex(current->next->position + sf::Vector2f(0, nodeHeight/2), sf::Color::White));
+                }
+                current = current->next;
+                index++;
+                continue;
+            }
             
             // Determine node color based on operation and highlighting
             if (std::find(highlightedIndices.begin(), highlightedIndices.end(), index) != highlightedIndices.end()) {
@@ -1574,33 +4072,37 @@ public:
                 }
             }
             
-            nodeRect.setOutlineThickness(2.f);
+            nodeRect.setOutlineThickness(quality < QualityTier::NoOutlines ? 2.f : 0.f);
             nodeRect.setOutlineColor(sf::Color::Black);
             window.draw(nodeRect);
             
             // Draw node value (with bounce offset)
-            sf::Text valueText(std::to_string(current->data), font, 20);
-            valueText.setPosition(
-                nodePosition.x + nodeWidth/2 - valueText.getLocalBounds().width/2,
-                nodePosition.y + nodeHeight/2 - valueText.getLocalBounds().height/2
-            );
-            valueText.setFillColor(sf::Color::White);
-            window.draw(valueText);
+            if (quality < QualityTier::NoCellText) {
+                sf::Text valueText(std::to_string(current->data), font, 20);
+                valueText.setPosition(
+                    nodePosition.x + nodeWidth/2 - valueText.getLocalBounds().width/2,
+                    nodePosition.y + nodeHeight/2 - valueText.getLocalBounds().height/2
+                );
+                valueText.setFillColor(sf::Color::White);
+                window.draw(valueText);
+            }
     
             // Draw node index below
-            sf::Text indexText(std::to_string(index - 1), font, 16);  // 0-based index
-            indexText.setPosition(
-                nodePosition.x + nodeWidth/2 - indexText.getLocalBounds().width/2,
-                nodePosition.y + nodeHeight + 5
-            );
-            indexText.setFillColor(sf::Color::White);
-            window.draw(indexText);
+            if (quality == QualityTier::Full) {
+                sf::Text indexText(std::to_string(index - 1), font, 16);  // 0-based index
+                indexText.setPosition(
+                    nodePosition.x + nodeWidth/2 - indexText.getLocalBounds().width/2,
+                    nodePosition.y + nodeHeight + 5
+                );
+                indexText.setFillColor(sf::Color::White);
+                window.draw(indexText);
+            }
             
             // Draw arrows (skip if pointing to nullptr or to the node being deleted)
             if (current->next != nullptr && !(isAnimating && current->next == newNode)) {
                 // Calculate bounce offset for next node
                 float nextBounceOffset = 0.0f;
-                if (index+1 < foundBounce.size() && foundBounce[index+1] > 0) {
+                if (index+1 < foundBounce.size() && foundBounce[index+1] > 0 && quality < QualityTier::NoCellText) {
                     nextBounceOffset = -30.0f * foundBounce[index+1] * foundBounce[index+1];
                 }
 
@@ -1612,8 +4114,10 @@ public:
                 endPos.y += nextBounceOffset; // Apply bounce to next node
 
                 // If this node or next node is found, angle the arrow upward
-                bool isFoundNode = (foundBounce.size() > index && foundBounce[index] > 0);
-                bool isNextNodeFound = (foundBounce.size() > index+1 && foundBounce[index+1] > 0);
+                bool isFoundNode = (foundBounce.size() > index && foundBounce[index] > 0) &&
+                                   quality < QualityTier::NoCellText;
+                bool isNextNodeFound = (foundBounce.size() > index+1 && foundBounce[index+1] > 0) &&
+                                       quality < QualityTier::NoCellText;
 
                 if (isFoundNode || isNextNodeFound) {
                     // Adjust positions for upward angle
@@ -1634,7 +4138,7 @@ public:
                     arrowHead.setPoint(1, sf::Vector2f(8, 8));    // Increased size
                     arrowHead.setPoint(2, sf::Vector2f(0, -8));   // Increased size
                     arrowHead.setFillColor(sf::Color::White);
-                    arrowHead.setOutlineThickness(1.f);           // Added outline
+                    arrowHead.setOutlineThickness(quality < QualityTier::NoOutlines ? 1.f : 0.f);
                     arrowHead.setOutlineColor(sf::Color::Black);   // Contrast outline
                     arrowHead.setPosition(endPos);
                     window.draw(arrowHead);
@@ -1653,7 +4157,7 @@ public:
                     arrowHead.setPoint(1, sf::Vector2f(0, 8));    // Increased size
                     arrowHead.setPoint(2, sf::Vector2f(12, 0));   // Increased size
                     arrowHead.setFillColor(sf::Color::White);
-                    arrowHead.setOutlineThickness(1.f);           // Added outline
+                    arrowHead.setOutlineThickness(quality < QualityTier::NoOutlines ? 1.f : 0.f);
                     arrowHead.setOutlineColor(sf::Color::Black);  // Contrast outline
                     arrowHead.setPosition(endPos.x - 12, endPos.y); // Adjusted position
                     window.draw(arrowHead);
@@ -1663,6 +4167,13 @@ public:
             current = current->next;
             index++;
         }
+
+        if (quality == QualityTier::Aggregate) {
+            window.draw(aggregateLinks);
+            window.draw(aggregateNodes);
+            aggregateLinks.clear();
+            aggregateNodes.clear();
+        }
     
         // Draw the new node if it's being animated (for insertions)
         if (isAnimating && newNode != nullptr && currentOperation != Operation::Remove) {
@@ -1738,6 +4249,7 @@ public:
                     tail = newNode;
                 }
                 size++;
+                countNative(counterPanel, costMeter, "insert at head", list.size(), [&] { list.pushFront(newNode->data); });
                 
                 isAnimating = false;
                 animationComplete = true;
@@ -1805,6 +4317,7 @@ public:
                 }
                 tail = newNode; // Update tail
                 size++;
+                countNative(counterPanel, costMeter, "insert at tail", list.size(), [&] { list.pushBack(newNode->data); });
     
                 isAnimating = false;
                 animationComplete = true;
@@ -1889,6 +4402,7 @@ public:
                 
                 prevNode->next = newNode;
                 size++;
+                countNative(counterPanel, costMeter, "insert", list.size(), [&] { list.insert(position - 1, newNode->data); });
                 
                 isAnimating = false;
                 animationComplete = true;
@@ -1985,6 +4499,7 @@ public:
 
                 delete toDelete;
                 size--;
+                countNative(counterPanel, costMeter, "delete", list.size(), [&] { list.remove(position - 1); });
                 
                 isAnimating = false;
                 animationComplete = true;
@@ -2023,6 +4538,7 @@ public:
             // Update the actual node with new value and position it above
             nodeToUpdate->data = value;
             nodeToUpdate->position = nodeToUpdate->position - sf::Vector2f(0, 100);
+            countNative(counterPanel, costMeter, "update", list.size(), [&] { list.update(position - 1, value); });
     
             isAnimating = true;
             animationProgress = 0.f;
@@ -2079,6 +4595,9 @@ public:
             // Clear any previous highlights
             highlightedIndices.clear();
             foundBounce.assign(foundBounce.size(), 0.0f);
+
+            // The same pointer chase the animation steps through, at native speed
+            countNative(counterPanel, costMeter, "search", list.size(), [&] { list.find(value); });
         } else {
             // If we've found a node and are in the hold phase
             if (foundNode != nullptr && foundHoldTime < HOLD_DURATION) {
@@ -2150,7 +4669,7 @@ public:
 
 class StackVisualizer {
 private:    
-    std::vector<int> stack;
+    core::Stack stack;
     sf::Vector2f position;
     float cellWidth;
     float cellHeight;
@@ -2173,8 +4692,11 @@ private:
 
     Operation currentOperation = Operation::None;
 
+    sf::VertexArray aggregateBatch{sf::Quads};  // Cells batched at QualityTier::Aggregate
+
 public: 
     float animationSpeed = 0.03f;  // Increased animation speed
+    QualityTier quality = QualityTier::Full;
 
 public:
     StackVisualizer(sf::Font& fontRef, sf::Vector2f pos, 
@@ -2186,7 +4708,20 @@ public:
         stack = {10, 20, 30, 40, 50};
     }
 
-    void drawContainer(sf::RenderWindow& window) {
+    // Replace the contents without animating. Only call while idle.
+    void load(const std::vector<int>& values) {
+        stack = core::Stack(values);
+    }
+
+    // Bottom to top
+    std::vector<int> values() const {
+        std::vector<int> result;
+        result.reserve(stack.size());
+        for (size_t i = 0; i < stack.size(); ++i) result.push_back(stack[i]);
+        return result;
+    }
+
+    void drawContainer(RenderContext& window) {
         // Draw three sides (left, bottom, right) - no top line
         sf::VertexArray walls(sf::Lines, 6); // 3 lines = 6 vertices
         
@@ -2213,7 +4748,7 @@ public:
         window.draw(base);
     }
 
-    void draw(sf::RenderWindow& window) {
+    void draw(RenderContext& window) {
         // Draw container 
         drawContainer(window);
         
@@ -2229,22 +4764,34 @@ public:
             float x = stackBaseX - cellWidth;
             float y = stackBaseY - (i + 1) * cellHeight;
             
+            if (quality == QualityTier::Aggregate) {
+                appendQuad(aggregateBatch, sf::Vector2f(x, y), sf::Vector2f(cellWidth, cellHeight), defaultColor);
+                continue;
+            }
+
             // Draw stack element
             sf::RectangleShape cell(sf::Vector2f(cellWidth, cellHeight));
             cell.setPosition(x, y);
             cell.setFillColor(defaultColor);
-            cell.setOutlineThickness(2.f);
+            cell.setOutlineThickness(quality < QualityTier::NoOutlines ? 2.f : 0.f);
             cell.setOutlineColor(sf::Color::Black);
             window.draw(cell);
             
             // Draw value
-            sf::Text valueText(std::to_string(stack[i]), font, 20);
-            valueText.setPosition(
-                x + cellWidth/2 - valueText.getLocalBounds().width/2,
-                y + cellHeight/2 - valueText.getLocalBounds().height/2
-            );
-            valueText.setFillColor(sf::Color::White);
-            window.draw(valueText);
+            if (quality < QualityTier::NoCellText) {
+                sf::Text valueText(std::to_string(stack[i]), font, 20);
+                valueText.setPosition(
+                    x + cellWidth/2 - valueText.getLocalBounds().width/2,
+                    y + cellHeight/2 - valueText.getLocalBounds().height/2
+                );
+                valueText.setFillColor(sf::Color::White);
+                window.draw(valueText);
+            }
+        }
+
+        if (quality == QualityTier::Aggregate) {
+            window.draw(aggregateBatch);
+            aggregateBatch.clear();
         }
     
         // Draw animating element if pushing
@@ -2331,7 +4878,7 @@ public:
             // Check if animation is complete
             if (animationProgress >= 1.0f) {
                 // Actually push the value onto the stack
-                stack.push_back(animatingValue);
+                stack.push(animatingValue);
                 
                 isAnimating = false;
                 animationComplete = true;
@@ -2349,7 +4896,7 @@ public:
     
         if (!isAnimating) {
             // Start pop animation
-            animatingValue = stack.back();
+            animatingValue = stack.top();
             animationProgress = 0.f;
             isAnimating = true;
             animationComplete = false;
@@ -2371,7 +4918,7 @@ public:
             // Check if animation is complete
             if (animationProgress >= 1.0f) {
                 // Actually pop the value from the stack
-                stack.pop_back();
+                stack.pop();
                 
                 isAnimating = false;
                 animationComplete = true;
@@ -2404,7 +4951,7 @@ public:
             );
             
             // Set animating value to the top element
-            animatingValue = stack.back();
+            animatingValue = stack.top();
             animatingPosition = originalPosition;
             
             isAnimating = true;
@@ -2452,18 +4999,25 @@ public:
 
 class QueueVisualizer{
 private:    
-    std::deque<int> queue;
+    core::Queue queue;
     sf::Vector2f position;
     float cellWidth;
     float cellHeight;
     sf::Font& font;
     sf::Color defaultColor;
 
-    // Animation variables
-    bool isAnimating = false;
-    float animationProgress = 0.f;
-    int animatingValue = 0;
-    sf::Vector2f animatingPosition;
+    // Animation variables. Enqueue works on the back and dequeue/front on the
+    // front, so each end has its own element in flight and the two can animate
+    // at the same time.
+    struct EndAnimation {
+        bool active = false;
+        Operation op = Operation::None;
+        float progress = 0.f;
+        int value = -1;
+        sf::Vector2f position;
+    };
+    EndAnimation backAnimation;     // Enqueue
+    EndAnimation frontAnimation;    // Dequeue / Front
 
     std::vector<sf::Vector2f> currentPositions; // Actual drawn positions
     std::vector<sf::Vector2f> cellPositions;    //  Target position
@@ -2477,10 +5031,11 @@ private:
     const float stackBaseY = containerY + 10.f; 
 
 
-    Operation currentOperation = Operation::None;
+    sf::VertexArray aggregateBatch{sf::Quads};  // Cells batched at QualityTier::Aggregate
 
 public: 
     float animationSpeed = 0.03f;  // Increased animation speed
+    QualityTier quality = QualityTier::Full;
 
 public:
     QueueVisualizer(sf::Font& fontRef, sf::Vector2f pos, 
@@ -2494,6 +5049,45 @@ public:
         currentPositions = cellPositions;
     }    
 
+    size_t size() const { return queue.size(); }
+
+    // Replace the contents without animating. Only call while idle.
+    void load(const std::vector<int>& values) {
+        queue = core::Queue(values);
+        updateCellPositions();
+        currentPositions = cellPositions;
+    }
+
+    // Front to back
+    std::vector<int> values() const {
+        std::vector<int> result;
+        result.reserve(queue.size());
+        for (size_t i = 0; i < queue.size(); ++i) result.push_back(queue[i]);
+        return result;
+    }
+
+    // How far (in cells) the rest of the queue has slid left for a running dequeue
+    float frontShift() const {
+        return (frontAnimation.active && frontAnimation.op == Operation::Dequeue) ? frontAnimation.progress : 0.f;
+    }
+
+    void drawAnimatingCell(RenderContext& window, const EndAnimation& animation, sf::Color fillColor) {
+        sf::RectangleShape cell(sf::Vector2f(cellWidth, cellHeight));
+        cell.setPosition(animation.position);
+        cell.setFillColor(fillColor);
+        cell.setOutlineThickness(2.f);
+        cell.setOutlineColor(sf::Color::Black);
+        window.draw(cell);
+
+        sf::Text valueText(std::to_string(animation.value), font, 20);
+        valueText.setPosition(
+            animation.position.x + cellWidth / 2 - valueText.getLocalBounds().width / 2,
+            animation.position.y + cellHeight / 2 - valueText.getLocalBounds().height / 2
+        );
+        valueText.setFillColor(sf::Color::White);
+        window.draw(valueText);
+    }
+
     void updateCellPositions() {
         cellPositions.clear();
         for (size_t i = 0; i < queue.size(); ++i) {
@@ -2505,7 +5099,7 @@ public:
         currentPositions.resize(queue.size());
     }
 
-    void drawContainer(sf::RenderWindow& window){
+    void drawContainer(RenderContext& window){
         // Draw only top and bottom lines (no left/right sides)
         sf::VertexArray lines(sf::Lines, 4); // 2 lines = 4 vertices
 
@@ -2531,194 +5125,153 @@ public:
         window.draw(base);
     }
 
-    void draw(sf::RenderWindow& window) {
+    void draw(RenderContext& window) {
         drawContainer(window);
     
         // Draw all queue elements except the animating one
         for (size_t i = 0; i < queue.size(); ++i) {
-            // Skip drawing the first element during dequeue animation
-            if (isAnimating && (currentOperation == Operation::Dequeue || currentOperation == Operation::Front) && i == 0) {
+            // Skip drawing the first element during dequeue/front animation
+            if (frontAnimation.active && i == 0) {
                 continue;
             }
     
             float x = currentPositions[i].x;
             float y = currentPositions[i].y;
     
+            if (quality == QualityTier::Aggregate) {
+                appendQuad(aggregateBatch, sf::Vector2f(x, y), sf::Vector2f(cellWidth, cellHeight), defaultColor);
+                continue;
+            }
+    
             sf::RectangleShape cell(sf::Vector2f(cellWidth, cellHeight));
             cell.setPosition(x, y);
             cell.setFillColor(defaultColor);
-            cell.setOutlineThickness(2.f);
+            cell.setOutlineThickness(quality < QualityTier::NoOutlines ? 2.f : 0.f);
             cell.setOutlineColor(sf::Color::Black);
             window.draw(cell);
     
-            sf::Text valueText(std::to_string(queue[i]), font, 20);
-            valueText.setPosition(
-                x + cellWidth / 2 - valueText.getLocalBounds().width / 2,
-                y + cellHeight / 2 - valueText.getLocalBounds().height / 2
-            );
-            valueText.setFillColor(sf::Color::White);
-            window.draw(valueText);
+            if (quality < QualityTier::NoCellText) {
+                sf::Text valueText(std::to_string(queue[i]), font, 20);
+                valueText.setPosition(
+                    x + cellWidth / 2 - valueText.getLocalBounds().width / 2,
+                    y + cellHeight / 2 - valueText.getLocalBounds().height / 2
+                );
+                valueText.setFillColor(sf::Color::White);
+                window.draw(valueText);
+            }
+        }
+
+        if (quality == QualityTier::Aggregate) {
+            window.draw(aggregateBatch);
+            aggregateBatch.clear();
         }
     
         // Draw animating element during enqueue
-        if (isAnimating && animatingValue != -1 && currentOperation == Operation::Enqueue) {
-            sf::RectangleShape cell(sf::Vector2f(cellWidth, cellHeight));
-            cell.setPosition(animatingPosition);
-            cell.setFillColor(sf::Color(255, 255, 0, 80)); // Yellow, semi-transparent
-            cell.setOutlineThickness(2.f);
-            cell.setOutlineColor(sf::Color::Black);
-            window.draw(cell);
-    
-            sf::Text valueText(std::to_string(animatingValue), font, 20);
-            valueText.setPosition(
-                animatingPosition.x + cellWidth / 2 - valueText.getLocalBounds().width / 2,
-                animatingPosition.y + cellHeight / 2 - valueText.getLocalBounds().height / 2
-            );
-            valueText.setFillColor(sf::Color::White);
-            window.draw(valueText);
+        if (backAnimation.active) {
+            drawAnimatingCell(window, backAnimation, sf::Color(255, 255, 0, 80)); // Yellow, semi-transparent
         }
     
-        // Draw animating element during dequeue
-        if (isAnimating && currentOperation == Operation::Dequeue && animatingValue != -1) {
-            sf::RectangleShape cell(sf::Vector2f(cellWidth, cellHeight));
-            cell.setPosition(animatingPosition);
-            cell.setFillColor(sf::Color(255, 0, 255, 200)); // Magenta with fading alpha
-    
-            cell.setOutlineThickness(2.f);
-            cell.setOutlineColor(sf::Color::Black);
-            window.draw(cell);
-    
-            sf::Text valueText(std::to_string(animatingValue), font, 20);
-            valueText.setPosition(
-                animatingPosition.x + cellWidth / 2 - valueText.getLocalBounds().width / 2,
-                animatingPosition.y + cellHeight / 2 - valueText.getLocalBounds().height / 2
-            );
-            valueText.setFillColor(sf::Color(255, 255, 255));
-            window.draw(valueText);
-        }
-
-        // Draw animating element during front operation
-        if (isAnimating && currentOperation == Operation::Front && animatingValue != -1) {
-            sf::RectangleShape cell(sf::Vector2f(cellWidth, cellHeight));
-            cell.setPosition(animatingPosition);
-            cell.setFillColor(sf::Color(0, 255, 255, 200));  
-            cell.setOutlineThickness(2.f);
-            cell.setOutlineColor(sf::Color::Black);
-            window.draw(cell);
-
-            sf::Text valueText(std::to_string(animatingValue), font, 20);
-            valueText.setPosition(
-                animatingPosition.x + cellWidth / 2 - valueText.getLocalBounds().width / 2,
-                animatingPosition.y + cellHeight / 2 - valueText.getLocalBounds().height / 2
-            );
-            valueText.setFillColor(sf::Color(255, 255, 255));
-            window.draw(valueText);
+        // Draw animating element during dequeue or front operation
+        if (frontAnimation.active && frontAnimation.op == Operation::Dequeue) {
+            drawAnimatingCell(window, frontAnimation, sf::Color(255, 0, 255, 200)); // Magenta
+        } else if (frontAnimation.active && frontAnimation.op == Operation::Front) {
+            drawAnimatingCell(window, frontAnimation, sf::Color(0, 255, 255, 200)); // Cyan
         }
     }
     
 
     void enqueuevalue(int value, bool& animationComplete){
-        if(!isAnimating){
+        if(!backAnimation.active){
             // Start push animation
-            animatingValue = value;
-            animationProgress = 0.f;
-            isAnimating = true;
+            backAnimation.active = true;
+            backAnimation.op = Operation::Enqueue;
+            backAnimation.value = value;
+            backAnimation.progress = 0.f;
             animationComplete = false;
-            currentOperation = Operation::Enqueue;
     
             // Start position (just to the right of the current end)
-            animatingPosition = sf::Vector2f(
+            backAnimation.position = sf::Vector2f(
                 stackBaseX + queue.size() * cellWidth + 100.f,  
                 stackBaseY  
             );
         }
         else {
             // Animate the push
-            animationProgress += animationSpeed * 0.05;
+            backAnimation.progress += animationSpeed * 0.05;
             
-            // Calculate target position (current end of the queue)
-            float targetX = stackBaseX + queue.size() * cellWidth;
+            // Calculate target position (current end of the queue, which moves
+            // left while a dequeue is running at the front)
+            float targetX = stackBaseX + (queue.size() - frontShift()) * cellWidth;
             
             // Smooth animation using linear interpolation
-            animatingPosition.x = animatingPosition.x + 
-                                (targetX - animatingPosition.x) * animationProgress;
+            backAnimation.position.x = backAnimation.position.x + 
+                                (targetX - backAnimation.position.x) * backAnimation.progress;
             
             // Check if animation is complete
-            if (animationProgress >= 1.0f) {
+            if (backAnimation.progress >= 1.0f) {
                 // Actually push the value onto the queue
-                queue.push_back(animatingValue);
+                queue.enqueue(backAnimation.value);
                 updateCellPositions();  // Update cell positions to include new element
-                currentPositions = cellPositions;  // Sync current positions
+                currentPositions.back() = sf::Vector2f(targetX, stackBaseY);
                 
-                isAnimating = false;
+                backAnimation = EndAnimation();
                 animationComplete = true;
-                animatingValue = -1;  // Reset the animating value
-                currentOperation = Operation::None;
             }
         }
     }
 
     void dequeuevalue(bool& animationComplete) {
-        if (queue.empty()) return;
-    
-        static std::vector<sf::Vector2f> originalPositions;
-        static float progress = 0.f;
-    
         const float dequeuedSlideDistance = 100.f;
-        const float elementShiftDistance = 60.f;
     
-        if (!isAnimating) {
-            originalPositions = currentPositions;
-            progress = 0.f;
-            isAnimating = true;
-            currentOperation = Operation::Dequeue;
-            animatingValue = queue.front();
-            animatingPosition = originalPositions[0];
+        if (!frontAnimation.active) {
+            if (queue.empty()) {
+                animationComplete = true;
+                return;
+            }
+            frontAnimation.active = true;
+            frontAnimation.op = Operation::Dequeue;
+            frontAnimation.value = queue.front();
+            frontAnimation.progress = 0.f;
+            frontAnimation.position = cellPositions[0];
+            animationComplete = false;
         } else {
-            progress += animationSpeed * 0.05f;
-            progress = std::min(progress, 1.0f);
+            frontAnimation.progress += animationSpeed * 0.05f;
+            frontAnimation.progress = std::min(frontAnimation.progress, 1.0f);
+            float progress = frontAnimation.progress;
     
             // Animate the dequeued element sliding left
-            animatingPosition.x = originalPositions[0].x - (dequeuedSlideDistance * progress);
+            frontAnimation.position.x = cellPositions[0].x - (dequeuedSlideDistance * progress);
     
-            // Animate remaining elements
-            for (size_t i = 1; i < originalPositions.size(); ++i) {
-                if (i < currentPositions.size()) {
-                    float startX = originalPositions[i].x;
-                    float targetX = originalPositions[i - 1].x;
-                    currentPositions[i].x = startX + (targetX - startX) * progress;
-                }
+            // Animate remaining elements (including any enqueued meanwhile)
+            for (size_t i = 1; i < currentPositions.size(); ++i) {
+                currentPositions[i].x = cellPositions[i].x - cellWidth * progress;
             }
     
             if (progress >= 1.0f) {
-                queue.pop_front();
+                queue.dequeue();
                 updateCellPositions(); // updates `cellPositions`
                 currentPositions = cellPositions;
     
-                isAnimating = false;
+                frontAnimation = EndAnimation();
                 animationComplete = true;
-                animatingValue = -1;
-                currentOperation = Operation::None;
             }
         }
     }
     
     
     void frontvalue(bool& animationComplete) {
-        static bool isFrontAnimating = false;
-        static float frontProgress = 0.f;
         static float holdTime = 0.f;
         static sf::Vector2f originalPosition;
         const float FRONT_DURATION = 2.0f; // 2 seconds
         const float FRONT_DISTANCE = 50.f; // How far to slide left (smaller distance)
         
-        if (!isFrontAnimating && !queue.empty()) {
+        if (!frontAnimation.active && !queue.empty()) {
             // Start front animation
-            isFrontAnimating = true;
-            frontProgress = 0.f;
+            frontAnimation.active = true;
+            frontAnimation.op = Operation::Front;
+            frontAnimation.progress = 0.f;
             holdTime = 0.f;
             animationComplete = false;
-            currentOperation = Operation::Front;
             
             // Store original position (front of queue)
             originalPosition = sf::Vector2f(
@@ -2727,20 +5280,18 @@ public:
             );
             
             // Set animating value to the front element
-            animatingValue = queue.front();
-            animatingPosition = originalPosition;
-            
-            isAnimating = true;
+            frontAnimation.value = queue.front();
+            frontAnimation.position = originalPosition;
         } 
-        else if (isFrontAnimating) {
+        else if (frontAnimation.active) {
             // Animate the front highlight
-            if (frontProgress < 1.0f) {
+            if (frontAnimation.progress < 1.0f) {
                 // Slide left animation
-                frontProgress += animationSpeed * 2.0f; // Faster animation
+                frontAnimation.progress += animationSpeed * 2.0f; // Faster animation
                 
                 // Calculate new position (ease out)
-                float easedProgress = 1.f - (1.f - frontProgress) * (1.f - frontProgress); // Ease out quad
-                animatingPosition.x = originalPosition.x - FRONT_DISTANCE * easedProgress;
+                float easedProgress = 1.f - (1.f - frontAnimation.progress) * (1.f - frontAnimation.progress); // Ease out quad
+                frontAnimation.position.x = originalPosition.x - FRONT_DISTANCE * easedProgress;
             } 
             else {
                 // Hold at front position
@@ -2752,15 +5303,12 @@ public:
                     
                     if (returnProgress >= 1.0f) {
                         // Animation complete
-                        isFrontAnimating = false;
+                        frontAnimation = EndAnimation();
                         animationComplete = true;
-                        currentOperation = Operation::None;
-                        animatingValue = -1;
-                        isAnimating = false;
                     } 
                     else {
                         // Slide back right
-                        animatingPosition.x = originalPosition.x - FRONT_DISTANCE + 
+                        frontAnimation.position.x = originalPosition.x - FRONT_DISTANCE + 
                                            FRONT_DISTANCE * returnProgress;
                     }
                 }
@@ -2788,6 +5336,8 @@ public:
     Node* root;
     int size;
 
+    core::BinarySearchTree tree;  // Headless model; the nodes above mirror it for layout
+
     // Visualization properties
     float nodeRadius;
     float horizontalSpacing;  
@@ -2795,6 +5345,20 @@ public:
     sf::Vector2f basePosition;
     sf::Font& font;
 
+    // A child sits horizontalSpacing * spacingRatio^depth to the side of its
+    // parent. The default ratio spreads small trees out; large trees use 0.5,
+    // at which no two subtrees can overlap, and share layoutHeight between
+    // their levels. insertnode refuses to go deeper than maxInsertDepth.
+    float spacingRatio = 0.7f;
+    int maxInsertDepth = 4;
+    float defaultRadius;
+    float layoutHalfWidth = 400.f;  // Room either side of basePosition for large trees
+    float layoutHeight = 600.f;     // Room below basePosition for large trees
+
+    static constexpr float DEFAULT_HORIZONTAL_SPACING = 300.f;
+    static constexpr float DEFAULT_VERTICAL_SPACING = 100.f;
+    static constexpr int SPARE_LEVELS = 3;  // Levels left for animated inserts below a large tree
+
     // Color
     sf::Color defaultColor;
     sf::Color traversalColor;
@@ -2834,8 +5398,8 @@ public:
     // sf::Color traversalColor = sf::Color(100, 200, 255);  // Light blue for traversal
     sf::Color foundColor = sf::Color(0, 255, 0);         // Green for found node
     bool isHighlightedFound = false;
-    bool isSearching;
-    Node* foundNode;
+    bool isSearching = false;
+    Node* foundNode = nullptr;
 
     bool isBlinking = false;
     float blinkTime = 0.0f;
@@ -2845,14 +5409,19 @@ public:
 
     Operation currentOperation;
 
+    sf::VertexArray aggregateNodes{sf::Quads};  // Nodes batched at QualityTier::Aggregate
+    sf::VertexArray aggregateLinks{sf::Lines};  // Edges batched at QualityTier::Aggregate
+    std::vector<Node*> drawStack;               // Reused by the per-frame walks
+
 public:
     float animationSpeed = 0.03f;
+    QualityTier quality = QualityTier::Full;
 
 public:
     BinaryTreeVisualizer(sf::Font& fontRef, sf::Vector2f pos, float radius)
     : root(nullptr), size(0), nodeRadius(radius), 
-    horizontalSpacing(300.f), verticalSpacing(100.f),
-    basePosition(pos), font(fontRef),
+    horizontalSpacing(DEFAULT_HORIZONTAL_SPACING), verticalSpacing(DEFAULT_VERTICAL_SPACING),
+    basePosition(pos), font(fontRef), defaultRadius(radius),
     defaultColor(sf::Color(70, 130, 180)),
     traversalColor(sf::Color(255, 127, 80)),
     highlightColor(sf::Color(255, 165, 0)),
@@ -2890,22 +5459,182 @@ public:
     root->right->right->position = sf::Vector2f(basePosition.x + 1.5f * horizontalSpacing, basePosition.y + 2 * verticalSpacing);
 
     size = 3;
+    for (int value : {60, 55, 65, 45, 57, 62, 70}) {
+        tree.insert(value);
+    }
     }
 
     ~BinaryTreeVisualizer() {
         clearTree(root);
     }
 
+    // Replace the contents without animating with the tree inserting values
+    // in order builds, laid out the way insertnode does (but with no depth
+    // limit). The model builds it in O(n log n) rather than by inserting,
+    // which is O(n^2) for sorted keys. Only call while idle.
+    void load(const std::vector<int>& values) {
+        clearTree(root);
+        resetLayout();
+        tree.assignInsertOrder(values.data(), values.size());
+        mirrorModel();
+    }
+
+    // Replace the contents with the tree `values` is the preorder of (as
+    // saved by a snapshot), built in O(n) by the model and laid out as load()
+    // does. Values that cannot be such a preorder are loaded in order instead.
+    // Only call while idle.
+    void loadPreorder(const int* values, size_t n) {
+        clearTree(root);
+        resetLayout();
+        if (!tree.assignPreorder(values, n)) {
+            tree.assignInsertOrder(values, n);
+        }
+        mirrorModel();
+    }
+
+    // Lay out the model, fitting trees too deep for the insertnode layout
+    void mirrorModel() {
+        size = static_cast<int>(tree.size());
+        int levels = static_cast<int>(tree.height());
+        if (levels > maxInsertDepth) {
+            fitLayout(levels);
+        }
+        root = mirror(tree.getRoot(), basePosition, horizontalSpacing * spacingRatio);
+    }
+
+    // Replace the contents with a balanced tree of `values` in O(n) (plus a
+    // sort if they are not sorted yet), laid out as it is built: the model is
+    // built by core::BinarySearchTree::assignSorted and mirrored node by node
+    // straight into final positions. Only call while idle.
+    void buildBalanced(std::vector<int> values) {
+        if (!std::is_sorted(values.begin(), values.end())) {
+            std::sort(values.begin(), values.end());
+        }
+        clearTree(root);
+        tree.assignSorted(values.data(), values.size());
+        size = static_cast<int>(values.size());
+        fitLayout(static_cast<int>(tree.height()));
+        root = mirror(tree.getRoot(), basePosition, horizontalSpacing * spacingRatio);
+    }
+
+    void resetLayout() {
+        spacingRatio = 0.7f;
+        horizontalSpacing = DEFAULT_HORIZONTAL_SPACING;
+        verticalSpacing = DEFAULT_VERTICAL_SPACING;
+        maxInsertDepth = 4;
+        nodeRadius = defaultRadius;
+    }
+
+    // Spacing for a tree `levels` deep: halving per level, with the levels
+    // (and a few spare ones for inserts) sharing layoutHeight
+    void fitLayout(int levels) {
+        spacingRatio = 0.5f;
+        horizontalSpacing = layoutHalfWidth;
+        maxInsertDepth = std::max(4, levels + SPARE_LEVELS);
+        verticalSpacing = std::min(DEFAULT_VERTICAL_SPACING, layoutHeight / maxInsertDepth);
+        nodeRadius = std::min(defaultRadius, verticalSpacing * 0.4f);
+    }
+
+    // A copy of the model's subtree with `source` at `pos` and its children
+    // `offset` to either side. Walks here use an explicit stack, as the model's
+    // do: sorted or duplicate-heavy keys make a chain as deep as the tree.
+    Node* mirror(const core::BinarySearchTree::Node* source, sf::Vector2f pos, float offset) {
+        struct Pending {
+            const core::BinarySearchTree::Node* source;
+            Node** link;
+            sf::Vector2f pos;
+            float offset;
+        };
+        Node* top = nullptr;
+        std::vector<Pending> pending;
+        if (source) pending.push_back({source, &top, pos, offset});
+        while (!pending.empty()) {
+            Pending next = pending.back();
+            pending.pop_back();
+            Node* node = new Node(next.source->data);
+            node->position = next.pos;
+            *next.link = node;
+            float childOffset = next.offset * spacingRatio;
+            if (next.source->right) {
+                pending.push_back({next.source->right, &node->right,
+                                   next.pos + sf::Vector2f(next.offset, verticalSpacing), childOffset});
+            }
+            if (next.source->left) {
+                pending.push_back({next.source->left, &node->left,
+                                   next.pos + sf::Vector2f(-next.offset, verticalSpacing), childOffset});
+            }
+        }
+        return top;
+    }
+
+    void place(Node* node, sf::Vector2f pos, float offset) {
+        struct Pending {
+            Node* node;
+            sf::Vector2f pos;
+            float offset;
+        };
+        std::vector<Pending> pending;
+        if (node) pending.push_back({node, pos, offset});
+        while (!pending.empty()) {
+            Pending next = pending.back();
+            pending.pop_back();
+            next.node->position = next.pos;
+            float childOffset = next.offset * spacingRatio;
+            if (next.node->right) {
+                pending.push_back({next.node->right, next.pos + sf::Vector2f(next.offset, verticalSpacing), childOffset});
+            }
+            if (next.node->left) {
+                pending.push_back({next.node->left, next.pos + sf::Vector2f(-next.offset, verticalSpacing), childOffset});
+            }
+        }
+    }
+
     void clearTree(Node* node) {
-        if (node) {
-            clearTree(node->left);
-            clearTree(node->right);
-            delete node;
+        std::vector<Node*> pending;
+        if (node) pending.push_back(node);
+        while (!pending.empty()) {
+            Node* current = pending.back();
+            pending.pop_back();
+            if (current->left) pending.push_back(current->left);
+            if (current->right) pending.push_back(current->right);
+            delete current;
         }
     }
 
-    void draw(sf::RenderWindow& window) {
-        if (root) {
+    enum class Walk { In, Pre, Post };
+
+    // Every node in the walk's order. Each node is pushed twice, as the
+    // model's collect() does: expanded on the first pop, visited on the second.
+    std::vector<Node*> walkOrder(Walk order) const {
+        std::vector<Node*> path;
+        std::vector<std::pair<Node*, bool>> pending;
+        if (root) pending.emplace_back(root, false);
+        while (!pending.empty()) {
+            Node* current = pending.back().first;
+            bool expanded = pending.back().second;
+            pending.pop_back();
+            if (expanded) {
+                path.push_back(current);
+                continue;
+            }
+            // Pushed in reverse of the visiting order
+            if (order == Walk::Post) pending.emplace_back(current, true);
+            if (current->right) pending.emplace_back(current->right, false);
+            if (order == Walk::In) pending.emplace_back(current, true);
+            if (current->left) pending.emplace_back(current->left, false);
+            if (order == Walk::Pre) pending.emplace_back(current, true);
+        }
+        return path;
+    }
+
+    void draw(RenderContext& window) {
+        if (root && quality == QualityTier::Aggregate) {
+            batchNode(root);
+            window.draw(aggregateLinks);
+            window.draw(aggregateNodes);
+            aggregateLinks.clear();
+            aggregateNodes.clear();
+        } else if (root) {
             drawNode(window, root);
         }
         if (isAnimating && animatingNode && !isTraversing) {
@@ -2928,9 +5657,42 @@ public:
         }
     }
 
-    void drawNode(sf::RenderWindow& window, Node* node) {
-        if (!node) return;
-    
+    // Aggregate tier: every edge and node (as a square) goes into two batches
+    void batchNode(Node* top) {
+        drawStack.clear();
+        if (top) drawStack.push_back(top);
+        while (!drawStack.empty()) {
+            Node* node = drawStack.back();
+            drawStack.pop_back();
+            for (Node* child : {node->left, node->right}) {
+                if (child) {
+                    aggregateLinks.append(sf::Vertex(node->position, sf::Color::White));
+                    aggregateLinks.append(sf::Vertex(child->position, sf::Color::White));
+                }
+            }
+            sf::Color color = (node == currentlyHighlightedNode) ? traversalColor :
+                              (node == foundNode && showFoundColor) ? foundColor : defaultColor;
+            appendQuad(aggregateNodes, node->position - sf::Vector2f(nodeRadius, nodeRadius),
+                       sf::Vector2f(2 * nodeRadius, 2 * nodeRadius), color);
+            if (node->right) drawStack.push_back(node->right);
+            if (node->left) drawStack.push_back(node->left);
+        }
+    }
+
+    // Nodes in preorder, each with the edges to its children
+    void drawNode(RenderContext& window, Node* top) {
+        drawStack.clear();
+        if (top) drawStack.push_back(top);
+        while (!drawStack.empty()) {
+            Node* node = drawStack.back();
+            drawStack.pop_back();
+            if (node->right) drawStack.push_back(node->right);
+            if (node->left) drawStack.push_back(node->left);
+            drawOne(window, node);
+        }
+    }
+
+    void drawOne(RenderContext& window, Node* node) {
         // Always draw connections in white
         auto drawConnection = [&](Node* target) {
             if (!target) return;
@@ -2969,22 +5731,20 @@ public:
         }
     
         // Common node styling
-        nodeShape.setOutlineThickness(2.f);
+        nodeShape.setOutlineThickness(quality < QualityTier::NoOutlines ? 2.f : 0.f);
         nodeShape.setOutlineColor(sf::Color::Black);
         window.draw(nodeShape);
     
         // Draw node value
-        sf::Text valueText(std::to_string(node->data), font, 20);
-        valueText.setPosition(
-            node->position.x - valueText.getLocalBounds().width/2,
-            node->position.y - valueText.getLocalBounds().height/2
-        );
-        valueText.setFillColor(sf::Color::White);
-        window.draw(valueText);
-    
-        // Recursively draw children
-        drawNode(window, node->left);
-        drawNode(window, node->right);
+        if (quality < QualityTier::NoCellText) {
+            sf::Text valueText(std::to_string(node->data), font, 20);
+            valueText.setPosition(
+                node->position.x - valueText.getLocalBounds().width/2,
+                node->position.y - valueText.getLocalBounds().height/2
+            );
+            valueText.setFillColor(sf::Color::White);
+            window.draw(valueText);
+        }
     }
 
     void insertnode(int value, bool& animationComplete) {
@@ -2999,6 +5759,7 @@ public:
                 root = new Node(value);
                 root->position = basePosition;
                 size++;
+                tree.insert(value);
                 animationComplete = true;
                 isTraversing = false;
                 return;
@@ -3009,7 +5770,7 @@ public:
             bool isLeftChild = false;
             int level = 0;
     
-            while (current && level < 4) {
+            while (current && level < maxInsertDepth) {
                 traversalPath.push_back(current);
                 parent = current;
     
@@ -3023,7 +5784,7 @@ public:
                 level++;
             }
     
-            if (level >= 4) {
+            if (level >= maxInsertDepth) {
                 animationComplete = true;
                 isTraversing = false;
                 return;
@@ -3032,7 +5793,7 @@ public:
             // Setup new node animation
             animatingNode = new Node(value);
     
-            float levelSpacing = horizontalSpacing * std::pow(0.7f, level);
+            float levelSpacing = horizontalSpacing * std::pow(spacingRatio, level);
             animationTargetPos = isLeftChild ?
                 sf::Vector2f(parent->position.x - levelSpacing, parent->position.y + verticalSpacing) :
                 sf::Vector2f(parent->position.x + levelSpacing, parent->position.y + verticalSpacing);
@@ -3080,7 +5841,7 @@ public:
                 bool isLeftChild = false;
                 int level = 0;
     
-                while (current && level < 4) {
+                while (current && level < maxInsertDepth) {
                     parent = current;
                     if (value < current->data) {
                         current = current->left;
@@ -3100,6 +5861,7 @@ public:
     
                 animatingNode->position = animationTargetPos;
                 size++;
+                tree.insert(value);
                 isAnimating = false;
                 animatingNode = nullptr;
                 animationComplete = true;
@@ -3223,6 +5985,8 @@ public:
                         performRemoval(nodeToRemove, parent, isLeftChild);
                     }
                     
+                    tree.remove(value);
+
                     // Update positions (only for moved nodes)
                     for (size_t i = 0; i < nodesToMove.size(); i++) {
                         nodesToMove[i]->position = targetPositions[i];
@@ -3360,15 +6124,7 @@ public:
             currentStep = 0;
             highlightTime = 0.0f;
             
-            // Perform in-order traversal and store the path
-            std::function<void(Node*)> inorder = [&](Node* node) {
-                if (!node) return;
-                inorder(node->left);
-                traversalPath.push_back(node);
-                inorder(node->right);
-            };
-            
-            inorder(root);
+            traversalPath = walkOrder(Walk::In);
             
             if (traversalPath.empty()) {
                 animationComplete = true;
@@ -3414,15 +6170,7 @@ public:
             currentStep = 0;
             highlightTime = 0.0f;
             
-            // Perform pre-order traversal and store the path
-            std::function<void(Node*)> preorder = [&](Node* node) {
-                if (!node) return;
-                traversalPath.push_back(node);  // Visit root first
-                preorder(node->left);          // Then left subtree
-                preorder(node->right);         // Then right subtree
-            };
-            
-            preorder(root);
+            traversalPath = walkOrder(Walk::Pre);
             
             if (traversalPath.empty()) {
                 animationComplete = true;
@@ -3468,15 +6216,7 @@ public:
             currentStep = 0;
             highlightTime = 0.0f;
             
-            // Perform post-order traversal and store the path
-            std::function<void(Node*)> postorder = [&](Node* node) {
-                if (!node) return;
-                postorder(node->left);    // Visit left subtree first
-                postorder(node->right);   // Then right subtree
-                traversalPath.push_back(node); // Finally visit the node itself
-            };
-            
-            postorder(root);
+            traversalPath = walkOrder(Walk::Post);
             
             if (traversalPath.empty()) {
                 animationComplete = true;
@@ -3540,24 +6280,108 @@ void runarrayvisualizer(sf::Font& font){
                         sf::Color(0, 100, 0, 200), sf::Color::White));
     buttons.emplace_back(new Button("Back to Menu", font, {975.f, 25.f}, {200.f, 50.f}, 
                         sf::Color(150, 0, 0, 200), sf::Color::White));
+    buttons.emplace_back(new Button("Import", font, {725.f, 225.f}, {100.f, 40.f}, 
+                        sf::Color(0, 0, 100, 200), sf::Color::White));
+    buttons.emplace_back(new Button("Algorithm: insertion", font, {475.f, 325.f}, {240.f, 40.f}, 
+                        sf::Color(60, 60, 60, 200), sf::Color::White));
+    buttons.emplace_back(new Button("Sort", font, {725.f, 325.f}, {100.f, 40.f}, 
+                        sf::Color(0, 100, 100, 200), sf::Color::White));
+    buttons.emplace_back(new Button("linear", font, {175.f, 325.f}, {125.f, 40.f}, 
+                        sf::Color(60, 60, 60, 200), sf::Color::White));
+    buttons.emplace_back(new Button("Capacity: off", font, {50.f, 40.f}, {170.f, 40.f}, 
+                        sf::Color(60, 60, 60, 200), sf::Color::White));
+    buttons.emplace_back(new Button("Growth: 2x", font, {230.f, 40.f}, {150.f, 40.f}, 
+                        sf::Color(60, 60, 60, 200), sf::Color::White));
+    buttons.emplace_back(new Button("Reserve", font, {490.f, 40.f}, {100.f, 40.f}, 
+                        sf::Color(0, 0, 100, 200), sf::Color::White));
+    buttons.emplace_back(new Button("Append", font, {600.f, 40.f}, {100.f, 40.f}, 
+                        sf::Color(0, 100, 0, 200), sf::Color::White));
+    buttons.emplace_back(new Button("Append x100", font, {710.f, 40.f}, {150.f, 40.f}, 
+                        sf::Color(0, 100, 0, 200), sf::Color::White));
 
-    // Animation state tracking
-    bool isAnimating = false;
-    bool animationComplete = false;
-    enum class Operation { None, Insert, Remove, Search, Update };
-    Operation currentOperation = Operation::None;
-    int operationIndex = 0;
-    int operationValue = 0;
+    // Sorting: comparisons, swaps, writes and auxiliary memory of the chosen
+    // algorithm, against its native time on the same input. The choices after
+    // the sequential sorts are the parallel ones, which report speedup per
+    // thread count instead, and after those the prefix scans: sequential and
+    // blelloch, each inclusive and exclusive, reporting GB/s against memcpy.
+    int sortChoice = 0;
+    const int SCAN_CHOICE = core::SORT_ALGORITHM_COUNT + core::PARALLEL_SORT_COUNT;
+    const int SORT_CHOICES = SCAN_CHOICE + 4;
+    auto scanChoice = [&](core::ScanMethod& method, core::ScanKind& kind) {
+        if (sortChoice < SCAN_CHOICE) return false;
+        int s = sortChoice - SCAN_CHOICE;
+        method = s < 2 ? core::ScanMethod::Sequential : core::ScanMethod::Blelloch;
+        kind = s % 2 == 0 ? core::ScanKind::Inclusive : core::ScanKind::Exclusive;
+        return true;
+    };
+    auto sortChoiceLabel = [&]() -> std::string {
+        core::ScanMethod method;
+        core::ScanKind kind;
+        if (scanChoice(method, kind)) {
+            return std::string("Scan: ") + core::scanMethodName(method) +
+                   (kind == core::ScanKind::Inclusive ? " incl." : " excl.");
+        }
+        if (sortChoice < core::SORT_ALGORITHM_COUNT) {
+            return std::string("Algorithm: ") + core::sortAlgorithmName(static_cast<core::SortAlgorithm>(sortChoice));
+        }
+        return std::string("Algorithm: ") +
+               core::parallelSortName(static_cast<core::ParallelSort>(sortChoice - core::SORT_ALGORITHM_COUNT));
+    };
+    sf::Text reportStatus("", font, 16);    // The last sort's, scan's or sorted search's report
+    reportStatus.setPosition(475.f, 372.f);
+    reportStatus.setFillColor(sf::Color(200, 200, 200));
+
+    // Search mode: linear, or one of the sorted-array searches (-1 is linear)
+    int searchMode = -1;
+
+    // Capacity: spare slots past the size, reallocations animated, and the
+    // latency of every append plotted under the report. Growth cycles through
+    // two factors and a fixed increment.
+    const char* GROWTH_CHOICES[] = {"2x", "1.5x", "+16"};
+    const int GROWTH_CHOICE_COUNT = 3;
+    int growthChoice = 0;
+    TextInput reserveInput(font, {390.f, 40.f}, {90.f, 40.f}, "Reserve:");
+    const int MAX_RESERVE = 1 << 26;    // 256 MB of ints
+    LatencyPlot appendPlot(font, sf::FloatRect(530.f, 420.f, 355.f, 58.f), "append", "reallocating");
+    arrayVis.appendPlot = &appendPlot;
+
+    // Bulk import from a CSV or raw little-endian int32 file (.bin, .raw,
+    // .i32), parsed a slice per frame. The visualizer draws at the Aggregate
+    // tier until the values are in.
+    TextInput importPathInput(font, {475.f, 225.f}, {240.f, 40.f}, "Import file:", 260);
+    importPathInput.allowPathCharacters();
+    std::unique_ptr<core::IntegerImport> fileImport;
+    const float IMPORT_SLICE_MS = 10.f;
+    sf::Text importStatus("", font, 16);
+    importStatus.setPosition(475.f, 272.f);
+    importStatus.setFillColor(sf::Color(200, 200, 200));
+    sf::RectangleShape importBar(sf::Vector2f(350.f, 8.f));
+    importBar.setPosition(475.f, 296.f);
+    importBar.setFillColor(sf::Color(60, 60, 60));
+    sf::RectangleShape importFill(sf::Vector2f(0.f, 8.f));
+    importFill.setPosition(475.f, 296.f);
+    importFill.setFillColor(sf::Color(0, 160, 0));
+
+    // Every operation runs on its own animation track. Operations on disjoint
+    // cells (e.g. two searches, or updates at different indices) animate
+    // together; overlapping ones wait for their turn.
+    AnimationTracks tracks;
+    const size_t END = AnimationRegion::END;
+    sf::Text trackStatus("", font, 16);
+    trackStatus.setPosition(50.f, 400.f);
+    trackStatus.setFillColor(sf::Color(200, 200, 200));
 
     // Update button actions
     buttons[0]->setAction([&]() {  // Insert button
-        if (!isAnimating && !insertIndexInput.isEmpty() && !insertValueInput.isEmpty()) {
-            operationIndex = std::stoi(insertIndexInput.getText());
-            operationValue = std::stoi(insertValueInput.getText());
-            if (operationIndex >= 0 && operationIndex <= arrayVis.getArray().size()) {
-                currentOperation = Operation::Insert;
-                isAnimating = true;
-                animationComplete = false;
+        // The import replaces the whole array when it finishes
+        if (fileImport) return;
+        if (!insertIndexInput.isEmpty() && !insertValueInput.isEmpty()) {
+            int index = std::stoi(insertIndexInput.getText());
+            int value = std::stoi(insertValueInput.getText());
+            if (index >= 0 && index <= arrayVis.getArray().size()) {
+                // Shifts everything from index on
+                tracks.submit({static_cast<size_t>(index), END, true},
+                    [&arrayVis, index, value](int, bool& done) { arrayVis.insert(index, value, done); });
             }
         }
         insertIndexInput.clear();
@@ -3565,35 +6389,41 @@ void runarrayvisualizer(sf::Font& font){
     });
 
     buttons[1]->setAction([&]() {  // Remove button
-        if (!isAnimating && !removeIndexInput.isEmpty()) {
-            operationIndex = std::stoi(removeIndexInput.getText());
-            if (operationIndex >= 0 && operationIndex < arrayVis.getArray().size()) {
-                currentOperation = Operation::Remove;
-                isAnimating = true;
-                animationComplete = false;
+        if (fileImport) return;
+        if (!removeIndexInput.isEmpty()) {
+            int index = std::stoi(removeIndexInput.getText());
+            if (index >= 0 && index < arrayVis.getArray().size()) {
+                tracks.submit({static_cast<size_t>(index), END, true},
+                    [&arrayVis, index](int, bool& done) { arrayVis.remove(index, done); });
             }
         }
         removeIndexInput.clear();
     });
 
     buttons[2]->setAction([&]() {  // Search button
-        if (!isAnimating && !searchValueInput.isEmpty()) {
-            operationValue = std::stoi(searchValueInput.getText());
-            currentOperation = Operation::Search;
-            isAnimating = true;
-            animationComplete = false;
+        if (fileImport) return;
+        if (!searchValueInput.isEmpty()) {
+            int value = std::stoi(searchValueInput.getText());
+            if (searchMode < 0) {
+                tracks.submit({0, END, false},
+                    [&arrayVis, value](int track, bool& done) { arrayVis.search(value, done, track); });
+            } else {
+                core::SortedSearch method = static_cast<core::SortedSearch>(searchMode);
+                tracks.submit({0, END, false},
+                    [&arrayVis, method, value](int track, bool& done) { arrayVis.searchSorted(method, value, done, track); });
+            }
         }
         searchValueInput.clear();
     });
 
     buttons[3]->setAction([&]() {  // Update button
-        if (!isAnimating && !updateIndex.isEmpty() && !updatevalue.isEmpty()) {
-            operationIndex = std::stoi(updateIndex.getText());
-            operationValue = std::stoi(updatevalue.getText());
-            if (operationIndex >= 0 && operationIndex <= arrayVis.getArray().size()) {
-                currentOperation = Operation::Update;
-                isAnimating = true;
-                animationComplete = false;
+        if (fileImport) return;
+        if (!updateIndex.isEmpty() && !updatevalue.isEmpty()) {
+            int index = std::stoi(updateIndex.getText());
+            int value = std::stoi(updatevalue.getText());
+            if (index >= 0 && index < arrayVis.getArray().size()) {
+                tracks.submit({static_cast<size_t>(index), static_cast<size_t>(index) + 1, true},
+                    [&arrayVis, index, value](int track, bool& done) { arrayVis.updateValue(index, value, done, track); });
             }
         }
         updateIndex.clear();
@@ -3604,96 +6434,312 @@ void runarrayvisualizer(sf::Font& font){
         window.close();
     });
 
+    buttons[5]->setAction([&]() {  // Import button
+        if (!fileImport && !importPathInput.isEmpty()) {
+            std::string path = importPathInput.getText();
+            fileImport.reset(new core::IntegerImport(path, core::importFormatFor(path)));
+        }
+    });
+
+    buttons[6]->setAction([&]() {  // Algorithm button cycles through the sorts and scans
+        sortChoice = (sortChoice + 1) % SORT_CHOICES;
+        buttons[6]->setLabel(sortChoiceLabel());
+        buttons[7]->setLabel(sortChoice < SCAN_CHOICE ? "Sort" : "Scan");
+    });
+
+    buttons[7]->setAction([&]() {  // Sort (or scan) button
+        if (fileImport) return;
+        // Moves values everywhere
+        core::ScanMethod method;
+        core::ScanKind kind;
+        if (scanChoice(method, kind)) {
+            tracks.submit({0, END, true},
+                [&arrayVis, method, kind](int, bool& done) { arrayVis.scan(method, kind, done); });
+        } else if (sortChoice < core::SORT_ALGORITHM_COUNT) {
+            core::SortAlgorithm algorithm = static_cast<core::SortAlgorithm>(sortChoice);
+            tracks.submit({0, END, true},
+                [&arrayVis, algorithm](int, bool& done) { arrayVis.sort(algorithm, done); });
+        } else {
+            core::ParallelSort algorithm = static_cast<core::ParallelSort>(sortChoice - core::SORT_ALGORITHM_COUNT);
+            tracks.submit({0, END, true},
+                [&arrayVis, algorithm](int, bool& done) { arrayVis.parallelSort(algorithm, done); });
+        }
+    });
+
+    buttons[8]->setAction([&]() {  // Search mode button
+        searchMode = searchMode + 1 < core::SORTED_SEARCH_COUNT ? searchMode + 1 : -1;
+        buttons[8]->setLabel(searchMode < 0 ? "linear" : core::sortedSearchName(static_cast<core::SortedSearch>(searchMode)));
+    });
+
+    buttons[9]->setAction([&]() {  // Capacity view toggle
+        if (tracks.busy()) return;
+        arrayVis.showCapacity = !arrayVis.showCapacity;
+        buttons[9]->setLabel(arrayVis.showCapacity ? "Capacity: on" : "Capacity: off");
+    });
+
+    buttons[10]->setAction([&]() {  // Growth button cycles through the policies
+        if (tracks.busy()) return;
+        growthChoice = (growthChoice + 1) % GROWTH_CHOICE_COUNT;
+        core::GrowthPolicy policy;
+        core::parseGrowthPolicy(GROWTH_CHOICES[growthChoice], policy);
+        arrayVis.setGrowth(policy);
+        buttons[10]->setLabel(std::string("Growth: ") + GROWTH_CHOICES[growthChoice]);
+    });
+
+    // Growing moves every element, so these hold the whole array
+    buttons[11]->setAction([&]() {  // Reserve button
+        if (!reserveInput.isEmpty() && !fileImport) {
+            int capacity = std::stoi(reserveInput.getText());
+            if (capacity > 0 && capacity <= MAX_RESERVE) {
+                tracks.submit({0, END, true},
+                    [&arrayVis, capacity](int, bool& done) { arrayVis.reserve(static_cast<size_t>(capacity), done); });
+            }
+        }
+        reserveInput.clear();
+    });
+
+    buttons[12]->setAction([&]() {  // Append button
+        if (fileImport) return;
+        tracks.submit({0, END, true},
+            [&arrayVis](int, bool& done) { arrayVis.append(arrayVis.nextAppendValue(), done); });
+    });
+
+    buttons[13]->setAction([&]() {  // Append x100 button
+        if (fileImport) return;
+        tracks.submit({0, END, true}, [&arrayVis](int, bool& done) {
+            arrayVis.appendBurst(100);
+            done = true;
+        });
+    });
+
+    // Frame-budget driven render quality
+    QualityGovernor governor(font);
+    sf::Clock frameClock;
+    RenderContext context(window);
+    AllocationHud allocHud(font);
+    RenderStatsHud renderHud(font);
+    OperationPhaseTracker phaseTracker;
+
+    // Seeded bulk loads
+    WorkloadPanel workloadPanel(font, {900.f, 280.f});
+    workloadPanel.setAction([&](const std::vector<int>& values) {
+        if (tracks.busy() || fileImport) return false;
+        arrayVis.load(values);
+        return true;
+    });
+
+    // Hardware counters for the native operation behind each animation
+    CounterPanel counterPanel(font, {900.f, 100.f});
+    arrayVis.counterPanel = &counterPanel;
+
+    // Contents persist in array.dsvsnap between sessions (F5 save, F6 reload)
+    SnapshotSlot snapshot("array",
+        [&](const std::string& path, std::string& error) { return core::saveSnapshot(path, "array", arrayVis.getArray(), error); },
+        [&](const core::SnapshotReader& saved) { arrayVis.load(std::vector<int>(saved.values(), saved.values() + saved.count())); });
+    snapshot.restore();
+
     // Main loop
     while (window.isOpen()) {
+        frameClock.restart();
+        DSV_TRACE_ZONE("frame");
+        context.resetStats();
+        allocHud.beginFrame();
+        DSV_TRACE_MARK(eventsStart);
         sf::Event event;
         while (window.pollEvent(event)) {
             if (event.type == sf::Event::Closed) {
                 window.close();
             }
-
-            // Handle input fields
-            if (!isAnimating) {
-                insertIndexInput.handleEvent(event, window);
-                insertValueInput.handleEvent(event, window);
-                removeIndexInput.handleEvent(event, window);
-                searchValueInput.handleEvent(event, window);
-                updateIndex.handleEvent(event, window);
-                updatevalue.handleEvent(event, window);
-                
-                for (auto& btn : buttons) {
-                    btn->handleEvent(event, window);
-                }
+            handleTraceKey(event);
+            workloadPanel.handleEvent(event, window);
+            snapshot.handleEvent(event, !tracks.busy() && !fileImport);
+
+            // Handle input fields (operations queue up while others animate)
+            insertIndexInput.handleEvent(event, window);
+            insertValueInput.handleEvent(event, window);
+            removeIndexInput.handleEvent(event, window);
+            searchValueInput.handleEvent(event, window);
+            updateIndex.handleEvent(event, window);
+            updatevalue.handleEvent(event, window);
+            importPathInput.handleEvent(event, window);
+            reserveInput.handleEvent(event, window);
+            
+            for (auto& btn : buttons) {
+                btn->handleEvent(event, window);
             }
         }
 
         // Handle animations
-        if (isAnimating) {
-            switch (currentOperation) {
-                case Operation::Insert:
-                    arrayVis.insert(operationIndex, operationValue, animationComplete);
-                    break;
-                case Operation::Remove:
-                    arrayVis.remove(operationIndex, animationComplete);
-                    break;
-                case Operation::Search:
-                    arrayVis.search(operationValue, animationComplete);
-                    break;
-                case Operation::Update:
-                    arrayVis.updateValue(operationIndex, operationValue, animationComplete);
-                    break;
-                case Operation::None:
-                    break;
-            }
-            
-            if (animationComplete) {
-                isAnimating = false;
-                currentOperation = Operation::None;
-                
-                // Clear input fields if operation completed
-                switch (currentOperation) {
-                    case Operation::Insert:
-                        insertIndexInput.clear();
-                        insertValueInput.clear();
-                        break;
-                    case Operation::Remove:
-                        removeIndexInput.clear();
-                        break;
-                    case Operation::Search:
-                        searchValueInput.clear();
-                        break;
-                    case Operation::Update:
-                        updateIndex.clear();
-                        updatevalue.clear();
-                        break;
-                    case Operation::None:
-                        break;
-                }
+        DSV_TRACE_RECORD("events", eventsStart);
+        allocHud.beginSection();
+        bool wasAnimating = tracks.busy();
+        DSV_TRACE_MARK(animateStart);
+        tracks.update();
+        
+        OperationPhase phase = phaseTracker.advance(wasAnimating, tracks.busy());
+        allocHud.endAnimate(phase);
+        DSV_TRACE_RECORD(OperationPhaseTracker::zoneName(phase), animateStart);
+
+        // Parse for one slice; kept out of the governor's frame time
+        sf::Time importTime;
+        if (fileImport) {
+            DSV_TRACE_ZONE("import");
+            sf::Clock sliceClock;
+            while (sliceClock.getElapsedTime().asMilliseconds() < IMPORT_SLICE_MS && fileImport->step(1 << 20)) {
+            }
+            importTime = sliceClock.getElapsedTime();
+
+            if (fileImport->failed()) {
+                importStatus.setString("Import failed: " + fileImport->getError());
+                fileImport.reset();
+            } else if (fileImport->done() && !tracks.busy()) {
+                size_t count = fileImport->count();
+                arrayVis.load(fileImport->take());
+                importStatus.setString("Imported " + std::to_string(count) + " values");
+                fileImport.reset();
+            } else {
+                char progress[96];
+                std::snprintf(progress, sizeof(progress), "Importing (%s): %.0f%% of %.1f MB",
+                              fileImport->phaseName(), fileImport->progress() * 100.0,
+                              fileImport->fileSize() / 1048576.0);
+                importStatus.setString(progress);
             }
         }
-        
+
         window.clear(sf::Color(30, 30, 30));
         
         // Draw array
-        arrayVis.draw(window);
+        allocHud.beginSection();
+        DSV_TRACE_MARK(drawStart);
+        renderHud.beginVisualizer(context);
+        arrayVis.quality = fileImport ? QualityTier::Aggregate : governor.getTier();
+        arrayVis.draw(context);
+        allocHud.endDraw();
+        renderHud.endVisualizer(context);
+        DSV_TRACE_RECORD("draw visualizer", drawStart);
+        DSV_TRACE_MARK(controlsStart);
         
         // Draw input fields and buttons
-        insertIndexInput.draw(window);
-        insertValueInput.draw(window);
-        removeIndexInput.draw(window);
-        searchValueInput.draw(window);
-        updateIndex.draw(window);
-        updatevalue.draw(window);
+        insertIndexInput.draw(context);
+        insertValueInput.draw(context);
+        removeIndexInput.draw(context);
+        searchValueInput.draw(context);
+        updateIndex.draw(context);
+        updatevalue.draw(context);
+        importPathInput.draw(context);
+        reserveInput.draw(context);
+        context.draw(importStatus);
+        reportStatus.setString(arrayVis.report());
+        context.draw(reportStatus);
+        if (arrayVis.reportsCapacity() && !appendPlot.empty()) {
+            appendPlot.draw(context);
+        }
+        if (fileImport) {
+            importFill.setSize(sf::Vector2f(350.f * static_cast<float>(fileImport->progress()), 8.f));
+            context.draw(importBar);
+            context.draw(importFill);
+        }
         
         for (auto& btn : buttons) {
-            if (isAnimating) {
-                btn->setAlpha(150);
-            } else {
-                btn->setAlpha(255);
-            }
-            btn->draw(window);
+            btn->setAlpha(255);
+            btn->draw(context);
+        }
+
+        if (tracks.busy()) {
+            trackStatus.setString("Animating: " + std::to_string(tracks.runningCount()) + " running, " +
+                                  std::to_string(tracks.waitingCount()) + " waiting");
+            context.draw(trackStatus);
         }
         
+        workloadPanel.draw(context);
+        DSV_TRACE_RECORD("draw controls", controlsStart);
+        allocHud.endFrame();
+        governor.update(frameClock.getElapsedTime() - importTime);
+        governor.drawHud(context);
+        allocHud.draw(context);
+        counterPanel.draw(context);
+        renderHud.draw(context);
+        renderHud.endFrame(context);
+
+        DSV_TRACE_MARK(displayStart);
+        window.display();
+        DSV_TRACE_RECORD("display", displayStart);
+    }
+
+    snapshot.save();
+}
+
+// Traversal order and cache blocking on a row-major matrix: each kernel
+// replays on small matrices while it and its counterpart are timed natively
+// at the chosen size.
+void runmatrixvisualizer(sf::Font& font){
+    sf::RenderWindow window(sf::VideoMode(1200, 672), "Matrix Visualizer");
+    window.setFramerateLimit(60);
+
+    MatrixVisualizer matrixVis(font, {320.f, 110.f}, 21.f);
+
+    sf::Text title("Matrix Visualizer", font, 30);
+    title.setPosition(20.f, 20.f);
+    sf::Text status("", font, 18);
+    status.setFillColor(sf::Color(200, 200, 200));
+    status.setPosition(320.f, 480.f);
+    sf::Text legend("Blue: read   Orange: write   Yellow: tiles in progress", font, 14);
+    legend.setFillColor(sf::Color(180, 180, 180));
+    legend.setPosition(320.f, 640.f);
+
+    // Native sizes; multiplies past MATRIX_MULTIPLY_BUDGET are refused
+    const size_t SIZES[] = {256, 512, 1024, 2048, 4096};
+    const int SIZE_COUNT = 5;
+    int sizeChoice = 2;
+
+    // One button per kernel, then the native size and Back
+    std::vector<std::unique_ptr<Button>> buttons;
+    for (int k = 0; k < core::MATRIX_KERNEL_COUNT; ++k) {
+        core::MatrixKernel kernel = static_cast<core::MatrixKernel>(k);
+        buttons.emplace_back(new Button(core::matrixKernelName(kernel), font, {20.f, 80.f + k * 44.f}, {260.f, 36.f},
+                            sf::Color(0, 0, 100, 200), sf::Color::White));
+        buttons.back()->setAction([&, kernel]() {
+            if (!matrixVis.busy()) matrixVis.start(kernel, SIZES[sizeChoice]);
+        });
+    }
+    buttons.emplace_back(new Button("Native n = 1024", font, {20.f, 364.f}, {260.f, 36.f},
+                        sf::Color(60, 60, 60, 200), sf::Color::White));
+    Button* sizeButton = buttons.back().get();
+    sizeButton->setAction([&]() {
+        sizeChoice = (sizeChoice + 1) % SIZE_COUNT;
+        sizeButton->setLabel("Native n = " + std::to_string(SIZES[sizeChoice]));
+    });
+    buttons.emplace_back(new Button("Back to Menu", font, {975.f, 25.f}, {200.f, 50.f},
+                        sf::Color(150, 0, 0, 200), sf::Color::White));
+    buttons.back()->setAction([&]() {
+        window.close();
+    });
+
+    RenderContext context(window);
+
+    while (window.isOpen()) {
+        context.resetStats();
+        sf::Event event;
+        while (window.pollEvent(event)) {
+            if (event.type == sf::Event::Closed) {
+                window.close();
+            }
+            for (auto& btn : buttons) {
+                btn->handleEvent(event, window);
+            }
+        }
+
+        matrixVis.update();
+
+        window.clear(sf::Color(30, 30, 30));
+        matrixVis.draw(context);
+        status.setString(matrixVis.report());
+        context.draw(title);
+        context.draw(status);
+        context.draw(legend);
+        for (auto& btn : buttons) {
+            btn->draw(context);
+        }
         window.display();
     }
 }
@@ -3726,6 +6772,18 @@ void runstringvisualizer(sf::Font& font){
                         sf::Color(0, 100, 0, 200), sf::Color::White));
     buttons.emplace_back(new Button("Back to Menu", font, {975.f, 25.f}, {200.f, 50.f}, 
                         sf::Color(150, 0, 0, 200), sf::Color::White));
+    buttons.emplace_back(new Button("Open", font, {725.f, 225.f}, {100.f, 40.f}, 
+                        sf::Color(0, 0, 100, 200), sf::Color::White));
+
+    // Text files of any size, read through a memory mapping. Only the
+    // characters in view are laid out, so scroll (arrows, Page Up/Down,
+    // Home/End, mouse wheel) and search work the same on a megabyte.
+    TextInput openPathInput(font, {475.f, 225.f}, {240.f, 40.f}, "Open file:", 260);
+    openPathInput.allowPathCharacters();
+    sf::Text textStatus("", font, 16);
+    textStatus.setPosition(50.f, 420.f);
+    textStatus.setFillColor(sf::Color(200, 200, 200));
+    std::string openMessage;
 
     // Animation state tracking
     bool isAnimating = false;
@@ -3766,7 +6824,7 @@ void runstringvisualizer(sf::Font& font){
 
     buttons[2]->setAction([&]() {  // Search button
         if (!isAnimating && !searchValueInput.isEmpty()) {
-            operationValue2 = searchValueInput.getText()[0];
+            operationValue = searchValueInput.getText();
             currentOperation = Operation::Search;
             isAnimating = true;
             animationComplete = false;
@@ -3791,13 +6849,59 @@ void runstringvisualizer(sf::Font& font){
     buttons[4]->setAction([&]() {  // Back to Menu button
         window.close();
     });
+
+    buttons[5]->setAction([&]() {  // Open button
+        if (!isAnimating && !openPathInput.isEmpty()) {
+            core::MappedFile file;
+            std::string error;
+            if (!file.open(openPathInput.getText(), error)) {
+                openMessage = error;
+            } else {
+                // One copy out of the mapping; edits need a private buffer anyway
+                stringVis.load(file.size() > 0 ? std::string(file.data(), file.size()) : std::string());
+                openMessage = "Opened " + openPathInput.getText();
+            }
+        }
+    });
     
+    // Frame-budget driven render quality
+    QualityGovernor governor(font);
+    sf::Clock frameClock;
+    RenderContext context(window);
+    AllocationHud allocHud(font);
+    RenderStatsHud renderHud(font);
+    OperationPhaseTracker phaseTracker;
+
+    // Seeded bulk loads (letters a-z for strings)
+    WorkloadPanel workloadPanel(font, {900.f, 100.f}, 25);
+    workloadPanel.setAction([&](const std::vector<int>& values) {
+        if (isAnimating) return false;
+        std::string letters;
+        for (int v : values) letters += static_cast<char>('a' + v % 26);
+        stringVis.load(letters);
+        return true;
+    });
+
+    // Contents persist in string.dsvsnap between sessions (F5 save, F6 reload)
+    SnapshotSlot snapshot("string",
+        [&](const std::string& path, std::string& error) { return core::saveSnapshot(path, stringVis.getString(), error); },
+        [&](const core::SnapshotReader& saved) { stringVis.load(std::string(saved.text(), saved.count())); });
+    snapshot.restore();
+
     while(window.isOpen()){
+        frameClock.restart();
+        DSV_TRACE_ZONE("frame");
+        context.resetStats();
+        allocHud.beginFrame();
+        DSV_TRACE_MARK(eventsStart);
         sf::Event event;
         while (window.pollEvent(event)) {
             if (event.type == sf::Event::Closed) {
                 window.close();
             }
+            handleTraceKey(event);
+            workloadPanel.handleEvent(event, window);
+            snapshot.handleEvent(event, !isAnimating);
 
             // Handle input fields
             if (!isAnimating) {
@@ -3807,6 +6911,8 @@ void runstringvisualizer(sf::Font& font){
                 searchValueInput.handleEvent(event, window);
                 updateIndex.handleEvent(event,window);
                 updateValue.handleEvent(event,window);
+                openPathInput.handleEvent(event, window);
+                stringVis.handleScrollEvent(event);
                 
                 for (auto& btn : buttons) {
                     btn->handleEvent(event, window);
@@ -3816,6 +6922,10 @@ void runstringvisualizer(sf::Font& font){
         } 
 
         // Handle animations
+        DSV_TRACE_RECORD("events", eventsStart);
+        allocHud.beginSection();
+        bool wasAnimating = isAnimating;
+        DSV_TRACE_MARK(animateStart);
         if (isAnimating) {
             switch (currentOperation) {
                 case Operation::Insert:
@@ -3825,7 +6935,7 @@ void runstringvisualizer(sf::Font& font){
                     stringVis.remove(operationIndex, animationComplete);
                     break;
                 case Operation::Search:
-                    stringVis.search(operationValue2, animationComplete);
+                    stringVis.search(operationValue, animationComplete);
                     break;    
                 case Operation::Update:
                     stringVis.updatevalue(operationIndex, operationValue2, animationComplete);
@@ -3861,17 +6971,37 @@ void runstringvisualizer(sf::Font& font){
             }
         }
 
+        OperationPhase phase = phaseTracker.advance(wasAnimating, isAnimating);
+        allocHud.endAnimate(phase);
+        DSV_TRACE_RECORD(OperationPhaseTracker::zoneName(phase), animateStart);
+
         window.clear(sf::Color(30, 30, 30));
 
-        stringVis.draw(window);
+        allocHud.beginSection();
+        DSV_TRACE_MARK(drawStart);
+        renderHud.beginVisualizer(context);
+        stringVis.quality = governor.getTier();
+        stringVis.draw(context);
+        allocHud.endDraw();
+        renderHud.endVisualizer(context);
+        DSV_TRACE_RECORD("draw visualizer", drawStart);
+        DSV_TRACE_MARK(controlsStart);
 
         // Draw input fields and buttons
-        insertIndexInput.draw(window);
-        insertValueInput.draw(window);
-        removeIndexInput.draw(window);
-        searchValueInput.draw(window);
-        updateIndex.draw(window);
-        updateValue.draw(window);
+        insertIndexInput.draw(context);
+        insertValueInput.draw(context);
+        removeIndexInput.draw(context);
+        searchValueInput.draw(context);
+        updateIndex.draw(context);
+        updateValue.draw(context);
+        openPathInput.draw(context);
+
+        size_t firstShown, lastShown;
+        stringVis.visibleRange(firstShown, lastShown);
+        textStatus.setString((openMessage.empty() ? "" : openMessage + "\n") + "Characters " +
+                             std::to_string(firstShown) + "-" + std::to_string(lastShown) + " of " +
+                             std::to_string(stringVis.getString().size()));
+        context.draw(textStatus);
 
         for (auto& btn : buttons) {
             if (isAnimating) {
@@ -3879,11 +7009,24 @@ void runstringvisualizer(sf::Font& font){
             } else {
                 btn->setAlpha(255);
             }
-            btn->draw(window);
+            btn->draw(context);
         }
 
+        workloadPanel.draw(context);
+        DSV_TRACE_RECORD("draw controls", controlsStart);
+        allocHud.endFrame();
+        governor.update(frameClock.getElapsedTime());
+        governor.drawHud(context);
+        allocHud.draw(context);
+        renderHud.draw(context);
+        renderHud.endFrame(context);
+
+        DSV_TRACE_MARK(displayStart);
         window.display();
+        DSV_TRACE_RECORD("display", displayStart);
     }
+
+    snapshot.save();
 }
 
 void runlinkedlistvisualizer(sf::Font& font){
@@ -4003,12 +7146,46 @@ void runlinkedlistvisualizer(sf::Font& font){
         window.close();
     });
 
+    // Frame-budget driven render quality
+    QualityGovernor governor(font);
+    sf::Clock frameClock;
+    RenderContext context(window);
+    AllocationHud allocHud(font);
+    RenderStatsHud renderHud(font);
+    OperationPhaseTracker phaseTracker;
+
+    // Seeded bulk loads
+    WorkloadPanel workloadPanel(font, {900.f, 280.f});
+    workloadPanel.setAction([&](const std::vector<int>& values) {
+        if (isAnimating) return false;
+        linkedlistVis.load(values);
+        return true;
+    });
+
+    // Hardware counters for the native operation behind each animation
+    CounterPanel counterPanel(font, {900.f, 100.f});
+    linkedlistVis.counterPanel = &counterPanel;
+
+    // Contents persist in linked-list.dsvsnap between sessions (F5 save, F6 reload)
+    SnapshotSlot snapshot("linked-list",
+        [&](const std::string& path, std::string& error) { return core::saveSnapshot(path, "linked-list", linkedlistVis.list.values(), error); },
+        [&](const core::SnapshotReader& saved) { linkedlistVis.load(std::vector<int>(saved.values(), saved.values() + saved.count())); });
+    snapshot.restore();
+
     while(window.isOpen()){
+        frameClock.restart();
+        DSV_TRACE_ZONE("frame");
+        context.resetStats();
+        allocHud.beginFrame();
+        DSV_TRACE_MARK(eventsStart);
         sf::Event event;
         while (window.pollEvent(event)) {
             if (event.type == sf::Event::Closed) {
                 window.close();
             }
+            handleTraceKey(event);
+            workloadPanel.handleEvent(event, window);
+            snapshot.handleEvent(event, !isAnimating);
 
             // Handle Input fields
             if(!isAnimating){
@@ -4027,6 +7204,10 @@ void runlinkedlistvisualizer(sf::Font& font){
             }
         }
         // Handle animations
+        DSV_TRACE_RECORD("events", eventsStart);
+        allocHud.beginSection();
+        bool wasAnimating = isAnimating;
+        DSV_TRACE_MARK(animateStart);
         if(isAnimating){
             switch(currentOperation){
                 case Operation::InsertAtHead:
@@ -4081,20 +7262,32 @@ void runlinkedlistvisualizer(sf::Font& font){
                 }            
             }
         }
+        OperationPhase phase = phaseTracker.advance(wasAnimating, isAnimating);
+        allocHud.endAnimate(phase);
+        DSV_TRACE_RECORD(OperationPhaseTracker::zoneName(phase), animateStart);
+
         window.clear(sf::Color(30, 30, 30));
         
         // Draw array
-        linkedlistVis.draw(window);
+        allocHud.beginSection();
+        DSV_TRACE_MARK(drawStart);
+        renderHud.beginVisualizer(context);
+        linkedlistVis.quality = governor.getTier();
+        linkedlistVis.draw(context);
+        allocHud.endDraw();
+        renderHud.endVisualizer(context);
+        DSV_TRACE_RECORD("draw visualizer", drawStart);
+        DSV_TRACE_MARK(controlsStart);
         
         // Draw input fields and buttons
-        insertAtHeadValue.draw(window);
-        insertAtTailValue.draw(window);
-        insertIndexInput.draw(window);
-        insertAtAnyPositionInput.draw(window);
-        removeIndexInput.draw(window);
-        updatePosition.draw(window);
-        updatevalue.draw(window);
-        searchValueInput.draw(window);
+        insertAtHeadValue.draw(context);
+        insertAtTailValue.draw(context);
+        insertIndexInput.draw(context);
+        insertAtAnyPositionInput.draw(context);
+        removeIndexInput.draw(context);
+        updatePosition.draw(context);
+        updatevalue.draw(context);
+        searchValueInput.draw(context);
 
         for (auto& btn : buttons) {
             if (isAnimating) {
@@ -4102,11 +7295,25 @@ void runlinkedlistvisualizer(sf::Font& font){
             } else {
                 btn->setAlpha(255);
             }
-            btn->draw(window);
+            btn->draw(context);
         }
 
+        workloadPanel.draw(context);
+        DSV_TRACE_RECORD("draw controls", controlsStart);
+        allocHud.endFrame();
+        governor.update(frameClock.getElapsedTime());
+        governor.drawHud(context);
+        allocHud.draw(context);
+        counterPanel.draw(context);
+        renderHud.draw(context);
+        renderHud.endFrame(context);
+
+        DSV_TRACE_MARK(displayStart);
         window.display();
+        DSV_TRACE_RECORD("display", displayStart);
     }
+
+    snapshot.save();
 }
 
 void runstackvisualizer(sf::Font& font){
@@ -4171,13 +7378,43 @@ void runstackvisualizer(sf::Font& font){
         window.close();
     });
 
+    // Frame-budget driven render quality
+    QualityGovernor governor(font);
+    sf::Clock frameClock;
+    RenderContext context(window);
+    AllocationHud allocHud(font);
+    RenderStatsHud renderHud(font);
+    OperationPhaseTracker phaseTracker;
+
+    // Seeded bulk loads
+    WorkloadPanel workloadPanel(font, {900.f, 100.f});
+    workloadPanel.setAction([&](const std::vector<int>& values) {
+        if (isAnimating) return false;
+        stackVis.load(values);
+        return true;
+    });
+
+    // Contents persist in stack.dsvsnap between sessions (F5 save, F6 reload)
+    SnapshotSlot snapshot("stack",
+        [&](const std::string& path, std::string& error) { return core::saveSnapshot(path, "stack", stackVis.values(), error); },
+        [&](const core::SnapshotReader& saved) { stackVis.load(std::vector<int>(saved.values(), saved.values() + saved.count())); });
+    snapshot.restore();
+
     // Main loop
     while (window.isOpen()) {
+        frameClock.restart();
+        DSV_TRACE_ZONE("frame");
+        context.resetStats();
+        allocHud.beginFrame();
+        DSV_TRACE_MARK(eventsStart);
         sf::Event event;
         while (window.pollEvent(event)) {
             if (event.type == sf::Event::Closed) {
                 window.close();
             }
+            handleTraceKey(event);
+            workloadPanel.handleEvent(event, window);
+            snapshot.handleEvent(event, !isAnimating);
 
             // Handle input fields
             if (!isAnimating) {
@@ -4190,6 +7427,10 @@ void runstackvisualizer(sf::Font& font){
         }
 
         // Handle animations
+        DSV_TRACE_RECORD("events", eventsStart);
+        allocHud.beginSection();
+        bool wasAnimating = isAnimating;
+        DSV_TRACE_MARK(animateStart);
         if (isAnimating) {
             switch (currentOperation) {
                 case Operation::Push:
@@ -4224,12 +7465,24 @@ void runstackvisualizer(sf::Font& font){
             }
         }
 
+        OperationPhase phase = phaseTracker.advance(wasAnimating, isAnimating);
+        allocHud.endAnimate(phase);
+        DSV_TRACE_RECORD(OperationPhaseTracker::zoneName(phase), animateStart);
+
         window.clear(sf::Color(30, 30, 30));
 
-        stackVis.draw(window);
+        allocHud.beginSection();
+        DSV_TRACE_MARK(drawStart);
+        renderHud.beginVisualizer(context);
+        stackVis.quality = governor.getTier();
+        stackVis.draw(context);
+        allocHud.endDraw();
+        renderHud.endVisualizer(context);
+        DSV_TRACE_RECORD("draw visualizer", drawStart);
+        DSV_TRACE_MARK(controlsStart);
 
         // Draw input fields and buttons
-        pushValue.draw(window);
+        pushValue.draw(context);
         
         for (auto& btn : buttons) {
             if (isAnimating) {
@@ -4237,11 +7490,24 @@ void runstackvisualizer(sf::Font& font){
             } else {
                 btn->setAlpha(255);
             }
-            btn->draw(window);
+            btn->draw(context);
         }
 
+        workloadPanel.draw(context);
+        DSV_TRACE_RECORD("draw controls", controlsStart);
+        allocHud.endFrame();
+        governor.update(frameClock.getElapsedTime());
+        governor.drawHud(context);
+        allocHud.draw(context);
+        renderHud.draw(context);
+        renderHud.endFrame(context);
+
+        DSV_TRACE_MARK(displayStart);
         window.display();
-    }        
+        DSV_TRACE_RECORD("display", displayStart);
+    }
+
+    snapshot.save();
 }
 
 void runqueuevisualizer(sf::Font& font){
@@ -4268,112 +7534,171 @@ void runqueuevisualizer(sf::Font& font){
                         sf::Color(150, 0, 0, 200), sf::Color::White));
 
 
-    // Animation state tracking
-    bool isAnimating = false;
-    bool animationComplete = false;
-    enum class Operation { None, Enqueue, Dequeue, Front};
-    Operation currentOperation = Operation::None;
-    int operationValue = 0;
+    // Enqueue animates at the back and dequeue/peek at the front, so the two
+    // ends run side by side. Each end holds one element in flight, so operations
+    // on the same end queue up behind each other.
+    AnimationTracks tracks;
+    const AnimationRegion backEnd{AnimationRegion::END - 1, AnimationRegion::END, true};
+    const AnimationRegion frontEnd{0, 1, true};
+    sf::Text trackStatus("", font, 16);
+    trackStatus.setPosition(50.f, 400.f);
+    trackStatus.setFillColor(sf::Color(200, 200, 200));
 
     // Update button actions
-    buttons[0]->setAction([&]() {  // Insert button
-        if (!isAnimating && !enqueueValue.isEmpty()) {
-            operationValue = std::stoi(enqueueValue.getText());
-            currentOperation = Operation::Enqueue;
-            isAnimating = true;
-            animationComplete = false;
+    buttons[0]->setAction([&]() {  // Enqueue button
+        if (!enqueueValue.isEmpty()) {
+            int value = std::stoi(enqueueValue.getText());
+            tracks.submit(backEnd,
+                [&queueVis, value](int, bool& done) { queueVis.enqueuevalue(value, done); });
         }
         enqueueValue.clear();
     });
 
-    buttons[1]->setAction([&]() {  // Insert button
-        currentOperation = Operation::Dequeue;
-        isAnimating = true;
-        animationComplete = false;
-    
+    buttons[1]->setAction([&]() {  // Dequeue button
+        tracks.submit(frontEnd,
+            [&queueVis](int, bool& done) { queueVis.dequeuevalue(done); });
     });
 
     buttons[2]->setAction([&]() {  // Peek button
-        currentOperation = Operation::Front;
-        isAnimating = true;
-        animationComplete = false;
+        tracks.submit(frontEnd,
+            [&queueVis](int, bool& done) { queueVis.frontvalue(done); });
     });
 
     buttons[3]->setAction([&]() {  // Back to Menu button
         window.close();
     });
 
+    // Frame-budget driven render quality
+    QualityGovernor governor(font);
+    sf::Clock frameClock;
+    RenderContext context(window);
+    AllocationHud allocHud(font);
+    RenderStatsHud renderHud(font);
+    OperationPhaseTracker phaseTracker;
+
+    // Seeded bulk loads
+    WorkloadPanel workloadPanel(font, {900.f, 100.f});
+    workloadPanel.setAction([&](const std::vector<int>& values) {
+        if (tracks.busy()) return false;
+        queueVis.load(values);
+        return true;
+    });
+
+    // Live stream: values enqueue one at a time as the back end frees up and
+    // the rest wait in the panel's bounded ring, so a source faster than the
+    // animation fills it and meets backpressure. Past STREAM_QUEUE_LIMIT the
+    // front is dequeued to keep the queue on screen.
+    StreamPanel streamPanel(font, {900.f, 290.f});
+    const size_t STREAM_QUEUE_LIMIT = 12;
+    bool streamEnqueueing = false;
+    bool streamDequeueing = false;
+
+    // Contents persist in queue.dsvsnap between sessions (F5 save, F6 reload)
+    SnapshotSlot snapshot("queue",
+        [&](const std::string& path, std::string& error) { return core::saveSnapshot(path, "queue", queueVis.values(), error); },
+        [&](const core::SnapshotReader& saved) { queueVis.load(std::vector<int>(saved.values(), saved.values() + saved.count())); });
+    snapshot.restore();
+
     // Main loop
     while (window.isOpen()) {
+        frameClock.restart();
+        DSV_TRACE_ZONE("frame");
+        context.resetStats();
+        allocHud.beginFrame();
+        DSV_TRACE_MARK(eventsStart);
         sf::Event event;
         while (window.pollEvent(event)) {
             if (event.type == sf::Event::Closed) {
                 window.close();
             }
+            handleTraceKey(event);
+            workloadPanel.handleEvent(event, window);
+            snapshot.handleEvent(event, !tracks.busy());
+            streamPanel.handleEvent(event, window);
 
             // Handle input fields
-            if (!isAnimating) {
-                enqueueValue.handleEvent(event,window);
-                
-                for (auto& btn : buttons) {
-                    btn->handleEvent(event, window);
-                }
+            enqueueValue.handleEvent(event,window);
+            
+            for (auto& btn : buttons) {
+                btn->handleEvent(event, window);
             }
         }
 
         // Handle animations
-        if (isAnimating) {
-            switch (currentOperation) {
-                case Operation::Enqueue:
-                    queueVis.enqueuevalue(operationValue, animationComplete);
-                    break;
-                case Operation::Dequeue:
-                    queueVis.dequeuevalue(animationComplete);
-                    break;    
-                case Operation::Front:
-                    queueVis.frontvalue(animationComplete);
-                    break;    
-                case Operation::None:
-                    break;
-            }
-            
-            if (animationComplete) {
-                isAnimating = false;
-                currentOperation = Operation::None;
-                
-                // Clear input fields if operation completed
-                switch (currentOperation) {
-                    case Operation::Enqueue:
-                    enqueueValue.clear();
-                        break;
-                    case Operation::Dequeue:
-                        break;    
-                    case Operation::Front:
-                        break;    
-                    case Operation::None:
-                        break;
+        DSV_TRACE_RECORD("events", eventsStart);
+        core::StreamItem arrival;
+        if (!streamEnqueueing && streamPanel.next(arrival)) {
+            streamEnqueueing = true;
+            bool shown = false;
+            tracks.submit(backEnd, [&, arrival, shown](int, bool& done) mutable {
+                if (!shown) {
+                    streamPanel.markShown(arrival.arrivalNs);
+                    shown = true;
                 }
-            }
+                queueVis.enqueuevalue(arrival.value, done);
+                if (done) streamEnqueueing = false;
+            });
         }
+        if (streamPanel.running() && !streamDequeueing && queueVis.size() >= STREAM_QUEUE_LIMIT) {
+            streamDequeueing = true;
+            tracks.submit(frontEnd, [&](int, bool& done) {
+                queueVis.dequeuevalue(done);
+                if (done) streamDequeueing = false;
+            });
+        }
+
+        allocHud.beginSection();
+        bool wasAnimating = tracks.busy();
+        DSV_TRACE_MARK(animateStart);
+        tracks.update();
+
+        OperationPhase phase = phaseTracker.advance(wasAnimating, tracks.busy());
+        allocHud.endAnimate(phase);
+        DSV_TRACE_RECORD(OperationPhaseTracker::zoneName(phase), animateStart);
 
         window.clear(sf::Color(30, 30, 30));
 
-        queueVis.draw(window);
+        allocHud.beginSection();
+        DSV_TRACE_MARK(drawStart);
+        renderHud.beginVisualizer(context);
+        queueVis.quality = governor.getTier();
+        queueVis.draw(context);
+        allocHud.endDraw();
+        renderHud.endVisualizer(context);
+        DSV_TRACE_RECORD("draw visualizer", drawStart);
+        DSV_TRACE_MARK(controlsStart);
 
         // Draw input fields and buttons
-        enqueueValue.draw(window);
+        enqueueValue.draw(context);
         
         for (auto& btn : buttons) {
-            if (isAnimating) {
-                btn->setAlpha(150);
-            } else {
-                btn->setAlpha(255);
-            }
-            btn->draw(window);
+            btn->setAlpha(255);
+            btn->draw(context);
+        }
+
+        if (tracks.busy()) {
+            trackStatus.setString("Animating: " + std::to_string(tracks.runningCount()) + " running, " +
+                                  std::to_string(tracks.waitingCount()) + " waiting");
+            context.draw(trackStatus);
         }
 
+        workloadPanel.draw(context);
+        streamPanel.draw(context);
+        DSV_TRACE_RECORD("draw controls", controlsStart);
+        allocHud.endFrame();
+        governor.update(frameClock.getElapsedTime());
+        governor.drawHud(context);
+        allocHud.draw(context);
+        renderHud.draw(context);
+        renderHud.endFrame(context);
+
+        DSV_TRACE_MARK(displayStart);
         window.display();
-    }        
+        DSV_TRACE_RECORD("display", displayStart);
+        streamPanel.frameDisplayed();
+    }
+
+    snapshot.save();
 }
 
 void runbinarytreevisualizer(sf::Font& font){
@@ -4406,6 +7731,8 @@ void runbinarytreevisualizer(sf::Font& font){
                         sf::Color(0, 100, 0, 200), sf::Color::White));
     buttons.emplace_back(new Button("Back to Menu", font, {50.f, 25.f}, {200.f, 50.f}, 
                         sf::Color(150, 0, 0, 200), sf::Color::White));
+    buttons.emplace_back(new Button("Bulk load: insert each", font, {360.f, 310.f}, {290.f, 36.f}, 
+                        sf::Color(0, 0, 100, 200), sf::Color::White));
 
 
     // Animation state tracking
@@ -4477,13 +7804,56 @@ void runbinarytreevisualizer(sf::Font& font){
         window.close();
     });
 
+    // Generated values either go in one insert at a time (the shape the
+    // order produces, e.g. a chain for sorted input) or become a balanced
+    // tree built in O(n)
+    bool balancedLoads = false;
+    buttons[7]->setAction([&]() {  // Bulk load mode
+        balancedLoads = !balancedLoads;
+        buttons[7]->setLabel(balancedLoads ? "Bulk load: balanced" : "Bulk load: insert each");
+    });
+
+    // Frame-budget driven render quality
+    QualityGovernor governor(font);
+    sf::Clock frameClock;
+    RenderContext context(window);
+    AllocationHud allocHud(font);
+    RenderStatsHud renderHud(font);
+    OperationPhaseTracker phaseTracker;
+
+    // Seeded bulk loads
+    WorkloadPanel workloadPanel(font, {360.f, 150.f});
+    workloadPanel.setAction([&](const std::vector<int>& values) {
+        if (isAnimating) return false;
+        if (balancedLoads) {
+            binarytreeVis.buildBalanced(values);
+        } else {
+            binarytreeVis.load(values);
+        }
+        return true;
+    });
+
+    // Contents persist in binary-tree.dsvsnap between sessions (F5 save, F6 reload)
+    SnapshotSlot snapshot("binary-tree",
+        [&](const std::string& path, std::string& error) { return core::saveSnapshot(path, "binary-tree", binarytreeVis.tree.preorder(), error); },
+        [&](const core::SnapshotReader& saved) { binarytreeVis.loadPreorder(saved.values(), saved.count()); });
+    snapshot.restore();
+
     // Main loop
     while (window.isOpen()) {
+        frameClock.restart();
+        DSV_TRACE_ZONE("frame");
+        context.resetStats();
+        allocHud.beginFrame();
+        DSV_TRACE_MARK(eventsStart);
         sf::Event event;
         while (window.pollEvent(event)) {
             if (event.type == sf::Event::Closed) {
                 window.close();
             }
+            handleTraceKey(event);
+            workloadPanel.handleEvent(event, window);
+            snapshot.handleEvent(event, !isAnimating);
 
             // Handle input fields
             if (!isAnimating) {
@@ -4498,6 +7868,10 @@ void runbinarytreevisualizer(sf::Font& font){
         }
 
         // Handle animations
+        DSV_TRACE_RECORD("events", eventsStart);
+        allocHud.beginSection();
+        bool wasAnimating = isAnimating;
+        DSV_TRACE_MARK(animateStart);
         if (isAnimating) {
             switch (currentOperation) {
                 case Operation::Insert:
@@ -4549,14 +7923,26 @@ void runbinarytreevisualizer(sf::Font& font){
             }
         }
 
+        OperationPhase phase = phaseTracker.advance(wasAnimating, isAnimating);
+        allocHud.endAnimate(phase);
+        DSV_TRACE_RECORD(OperationPhaseTracker::zoneName(phase), animateStart);
+
         window.clear(sf::Color(30, 30, 30));
 
-        binarytreeVis.draw(window);
+        allocHud.beginSection();
+        DSV_TRACE_MARK(drawStart);
+        renderHud.beginVisualizer(context);
+        binarytreeVis.quality = governor.getTier();
+        binarytreeVis.draw(context);
+        allocHud.endDraw();
+        renderHud.endVisualizer(context);
+        DSV_TRACE_RECORD("draw visualizer", drawStart);
+        DSV_TRACE_MARK(controlsStart);
 
         // Draw input fields and buttons
-        insertValue.draw(window);
-        removeValue.draw(window);
-        searchValue.draw(window);
+        insertValue.draw(context);
+        removeValue.draw(context);
+        searchValue.draw(context);
         
         for (auto& btn : buttons) {
             if (isAnimating) {
@@ -4564,14 +7950,696 @@ void runbinarytreevisualizer(sf::Font& font){
             } else {
                 btn->setAlpha(255);
             }
-            btn->draw(window);
+            btn->draw(context);
         }
 
+        workloadPanel.draw(context);
+        DSV_TRACE_RECORD("draw controls", controlsStart);
+        allocHud.endFrame();
+        governor.update(frameClock.getElapsedTime());
+        governor.drawHud(context);
+        allocHud.draw(context);
+        renderHud.draw(context);
+        renderHud.endFrame(context);
+
+        DSV_TRACE_MARK(displayStart);
         window.display();
-    }    
+        DSV_TRACE_RECORD("display", displayStart);
+    }
+
+    snapshot.save();
+}
+
+// Log-log plot of complexity sweeps: every measured point of each series and
+// the curve of its least-error model, with a legend giving the class the
+// slope reads as next to the two best fits.
+class ComplexityPlot {
+private:
+    struct Series {
+        std::string name;
+        sf::Color color;
+        std::vector<core::ComplexitySample> samples;
+        std::vector<core::ComplexityFit> fits;  // Least error first; empty below 3 samples
+    };
+
+    sf::Font& font;
+    sf::FloatRect area;
+    std::vector<Series> series;
+    float xMin = 1.f, xMax = 6.f, yMin = 0.f, yMax = 6.f;  // log10 of the axis ranges
+
+    const size_t MAX_SERIES = 4;
+    const sf::Color COLORS[4] = {sf::Color(255, 165, 0), sf::Color(0, 200, 255),
+                                 sf::Color(120, 220, 80), sf::Color(230, 90, 200)};
+
+    float toX(double n) const {
+        return area.left + (static_cast<float>(std::log10(n)) - xMin) / (xMax - xMin) * area.width;
+    }
+    float toY(double ns) const {
+        float y = (static_cast<float>(std::log10(ns)) - yMin) / (yMax - yMin);
+        return area.top + area.height - std::max(0.f, std::min(1.f, y)) * area.height;
+    }
+
+    // Whole decades around every sample
+    void updateRanges() {
+        double nLow = 1e30, nHigh = 0, tLow = 1e30, tHigh = 0;
+        for (const Series& s : series) {
+            for (const core::ComplexitySample& sample : s.samples) {
+                nLow = std::min(nLow, static_cast<double>(sample.n));
+                nHigh = std::max(nHigh, static_cast<double>(sample.n));
+                tLow = std::min(tLow, std::max(sample.nsPerOp, 0.1));
+                tHigh = std::max(tHigh, std::max(sample.nsPerOp, 0.1));
+            }
+        }
+        if (nHigh == 0) {
+            xMin = 1.f; xMax = 6.f; yMin = 0.f; yMax = 6.f;
+            return;
+        }
+        xMin = std::floor(static_cast<float>(std::log10(nLow)));
+        xMax = std::max(xMin + 1.f, std::ceil(static_cast<float>(std::log10(nHigh))));
+        yMin = std::floor(static_cast<float>(std::log10(tLow)));
+        yMax = std::max(yMin + 1.f, std::ceil(static_cast<float>(std::log10(tHigh))));
+    }
+
+    static std::string sizeLabel(int decade) {
+        static const char* labels[] = {"1", "10", "100", "1k", "10k", "100k", "1M", "10M", "100M"};
+        return decade >= 0 && decade < 9 ? labels[decade] : "1e" + std::to_string(decade);
+    }
+
+    static std::string timeLabel(int decade) {
+        static const char* units[] = {"ns", "us", "ms", "s"};
+        if (decade < 0) return "0.1 ns";
+        int unit = std::min(decade / 3, 3);
+        int zeros = decade - unit * 3;
+        return std::string(zeros == 0 ? "1" : zeros == 1 ? "10" : "100") + " " + units[unit];
+    }
+
+    void drawText(RenderContext& window, const std::string& string, sf::Vector2f pos,
+                  sf::Color color, unsigned size = 14) {
+        sf::Text text(string, font, size);
+        text.setFillColor(color);
+        text.setPosition(pos);
+        window.draw(text);
+    }
+
+public:
+    ComplexityPlot(sf::Font& fontRef, sf::FloatRect plotArea) : font(fontRef), area(plotArea) {}
+
+    void startSeries(const std::string& name) {
+        if (series.size() == MAX_SERIES) {
+            series.erase(series.begin());
+        }
+        // First colour not already on screen
+        sf::Color color = COLORS[0];
+        for (const sf::Color& candidate : COLORS) {
+            bool used = false;
+            for (const Series& s : series) used = used || s.color == candidate;
+            if (!used) { color = candidate; break; }
+        }
+        series.push_back(Series{name, color, {}, {}});
+    }
+
+    // New samples for the series started last; refits it
+    void update(const std::vector<core::ComplexitySample>& samples) {
+        if (series.empty()) return;
+        Series& current = series.back();
+        current.samples = samples;
+        current.fits.clear();
+        if (samples.size() >= 3) {
+            current.fits = core::fitComplexity(samples);
+        }
+        updateRanges();
+    }
+
+    void clear() {
+        series.clear();
+        updateRanges();
+    }
+
+    void draw(RenderContext& window) {
+        sf::RectangleShape frame(sf::Vector2f(area.width, area.height));
+        frame.setPosition(area.left, area.top);
+        frame.setFillColor(sf::Color(40, 40, 40));
+        frame.setOutlineThickness(1.f);
+        frame.setOutlineColor(sf::Color(120, 120, 120));
+        window.draw(frame);
+
+        // Decade grid and labels
+        sf::VertexArray grid(sf::Lines);
+        sf::Color gridColor(70, 70, 70);
+        for (int d = static_cast<int>(xMin); d <= static_cast<int>(xMax); ++d) {
+            float x = toX(std::pow(10.0, d));
+            grid.append(sf::Vertex(sf::Vector2f(x, area.top), gridColor));
+            grid.append(sf::Vertex(sf::Vector2f(x, area.top + area.height), gridColor));
+            drawText(window, sizeLabel(d), {x - 10.f, area.top + area.height + 6.f}, sf::Color(180, 180, 180));
+        }
+        for (int d = static_cast<int>(yMin); d <= static_cast<int>(yMax); ++d) {
+            float y = toY(std::pow(10.0, d));
+            grid.append(sf::Vertex(sf::Vector2f(area.left, y), gridColor));
+            grid.append(sf::Vertex(sf::Vector2f(area.left + area.width, y), gridColor));
+            drawText(window, timeLabel(d), {area.left - 62.f, y - 9.f}, sf::Color(180, 180, 180));
+        }
+        window.draw(grid);
+        drawText(window, "n", {area.left + area.width / 2.f, area.top + area.height + 24.f}, sf::Color::White, 16);
+        drawText(window, "time per operation", {area.left, area.top - 24.f}, sf::Color::White, 16);
+
+        for (size_t i = 0; i < series.size(); ++i) {
+            const Series& s = series[i];
+
+            // Least-error model over the measured range
+            if (!s.fits.empty()) {
+                sf::VertexArray curve(sf::LineStrip);
+                double low = static_cast<double>(s.samples.front().n);
+                double high = static_cast<double>(s.samples.back().n);
+                for (int step = 0; step <= 64; ++step) {
+                    double n = low * std::pow(high / low, step / 64.0);
+                    curve.append(sf::Vertex(sf::Vector2f(toX(n), toY(s.fits[0].predict(n))), s.color));
+                }
+                window.draw(curve);
+            }
+
+            sf::VertexArray points(sf::Quads);
+            for (const core::ComplexitySample& sample : s.samples) {
+                sf::Vector2f p(toX(static_cast<double>(sample.n)), toY(std::max(sample.nsPerOp, 0.1)));
+                appendQuad(points, p - sf::Vector2f(3.f, 3.f), sf::Vector2f(6.f, 6.f), s.color);
+            }
+            window.draw(points);
+
+            std::string legend = s.name + ": ";
+            if (s.fits.empty()) {
+                legend += "measuring...";
+            } else {
+                char fit[128];
+                std::snprintf(fit, sizeof(fit), "slope %.2f: %s   best fit %s (error %.2f), next %s (%.2f)",
+                              s.fits[0].slope, core::complexityName(core::complexityForSlope(s.fits[0].slope)),
+                              core::complexityName(s.fits[0].model), s.fits[0].error,
+                              core::complexityName(s.fits[1].model), s.fits[1].error);
+                legend += fit;
+            }
+            drawText(window, legend, {area.left + 10.f, area.top + 8.f + i * 20.f}, s.color, 15);
+        }
+    }
+};
+
+void runcomplexityexplorer(sf::Font& font){
+    sf::RenderWindow window(sf::VideoMode(1200, 672), "Complexity Explorer");
+    window.setFramerateLimit(60);
+
+    const std::vector<core::SweepOperation>& operations = core::sweepOperations();
+    ComplexityPlot plot(font, sf::FloatRect(420.f, 110.f, 740.f, 470.f));
+    std::unique_ptr<core::ComplexitySweep> sweep;
+    // Each size is measured on a worker so the window keeps drawing. Picks
+    // and Clear wait in `pendingChoice` until the size in progress is done
+    // (the last one wins).
+    std::future<void> measuring;
+    std::function<void()> pendingChoice;
+    auto stepping = [&]() {
+        return measuring.valid() && measuring.wait_for(std::chrono::seconds(0)) != std::future_status::ready;
+    };
+
+    sf::Text title("Complexity Explorer", font, 30);
+    title.setPosition(20.f, 20.f);
+    sf::Text status("Pick an operation to time it on the native structure", font, 18);
+    status.setFillColor(sf::Color(200, 200, 200));
+    status.setPosition(420.f, 620.f);
+
+    // One button per operation, then Clear and Back
+    std::vector<std::unique_ptr<Button>> buttons;
+    for (size_t i = 0; i < operations.size(); ++i) {
+        buttons.emplace_back(new Button(operations[i].name, font, {20.f, 80.f + i * 44.f}, {310.f, 36.f},
+                            sf::Color(0, 0, 100, 200), sf::Color::White));
+        buttons.back()->setAction([&, i]() {
+            pendingChoice = [&, i]() {
+                sweep.reset(new core::ComplexitySweep(operations[i]));
+                plot.startSeries(operations[i].name);
+            };
+        });
+    }
+    buttons.emplace_back(new Button("Clear", font, {20.f, 606.f}, {100.f, 34.f},
+                        sf::Color(100, 100, 0, 200), sf::Color::White));
+    buttons.back()->setAction([&]() {
+        pendingChoice = [&]() {
+            sweep.reset();
+            plot.clear();
+            status.setString("Pick an operation to time it on the native structure");
+        };
+    });
+    buttons.emplace_back(new Button("Back to Menu", font, {975.f, 25.f}, {200.f, 50.f},
+                        sf::Color(150, 0, 0, 200), sf::Color::White));
+    buttons.back()->setAction([&]() {
+        window.close();
+    });
+
+    QualityGovernor governor(font);
+    sf::Clock frameClock;
+    RenderContext context(window);
+    RenderStatsHud renderHud(font);
+
+    while (window.isOpen()) {
+        frameClock.restart();
+        context.resetStats();
+        sf::Event event;
+        while (window.pollEvent(event)) {
+            if (event.type == sf::Event::Closed) {
+                window.close();
+            }
+            for (auto& btn : buttons) {
+                btn->handleEvent(event, window);
+            }
+        }
+
+        // The plot fills in a size at a time as the worker finishes each
+        if (!stepping()) {
+            if (measuring.valid()) {
+                measuring.get();
+                const std::vector<core::ComplexitySample>& samples = sweep->getSamples();
+                plot.update(samples);
+                if (sweep->done()) {
+                    status.setString(std::string(sweep->getOperation().name) + ": n = " +
+                                     std::to_string(samples.front().n) + " .. " +
+                                     std::to_string(samples.back().n) + ", fitted on the larger half");
+                }
+            }
+            if (pendingChoice) {
+                pendingChoice();
+                pendingChoice = nullptr;
+            }
+            if (sweep && !sweep->done()) {
+                status.setString(std::string("Measuring ") + sweep->getOperation().name +
+                                 " at n = " + std::to_string(sweep->nextSize()) + "...");
+                core::ComplexitySweep* current = sweep.get();
+                measuring = std::async(std::launch::async, [current]() { current->step(); });
+            }
+        }
+
+        window.clear(sf::Color(30, 30, 30));
+        renderHud.beginVisualizer(context);
+        plot.draw(context);
+        renderHud.endVisualizer(context);
+        context.draw(title);
+        context.draw(status);
+        for (auto& btn : buttons) {
+            btn->draw(context);
+        }
+        governor.update(frameClock.getElapsedTime());
+        governor.drawHud(context);
+        renderHud.draw(context);
+        renderHud.endFrame(context);
+        window.display();
+    }
+}
+
+// Array and linked list side by side, fed the same operation stream. Each
+// operation starts in both panes at once and the next one waits until both
+// have finished animating. Indices are 0-based in both panes.
+void runcomparisonmode(sf::Font& font){
+    sf::RenderWindow window(sf::VideoMode(1200, 840), "Array vs Linked List");
+    window.setFramerateLimit(60);
+
+    ArrayVisualizer arrayVis(font, {50.f, 380.f}, 60.f, 60.f);
+    Linkedlistvisualizer listVis(font, {50.f, 680.f}, 60.f, 60.f);
+    arrayVis.animationSpeed = 0.05f;
+    NativeCostMeter arrayCost;
+    NativeCostMeter listCost;
+    arrayVis.costMeter = &arrayCost;
+    listVis.costMeter = &listCost;
+
+    const std::vector<int> initialValues = {10, 20, 30, 40, 50};
+    arrayVis.load(initialValues);
+    listVis.load(initialValues);
+
+    TextInput valueInput(font, {50.f, 125.f}, {100.f, 40.f}, "Value:");
+    TextInput indexInput(font, {165.f, 125.f}, {100.f, 40.f}, "Index:");
+
+    struct CompareOperation {
+        Operation kind;
+        int index;
+        int value;
+    };
+    std::deque<CompareOperation> pending;
+    CompareOperation current{Operation::None, 0, 0};
+    bool running = false;
+    bool arrayDone = true;
+    bool listDone = true;
+
+    // Random operations while the size stays where both panes fit on screen
+    bool streaming = false;
+    std::mt19937 streamRng(42);
+    const int STREAM_MIN_SIZE = 3;
+    const int STREAM_MAX_SIZE = 10;
+
+    auto arraySize = [&]() { return static_cast<int>(arrayVis.getArray().size()); };
+    auto submit = [&](Operation kind, bool needsIndex) {
+        if (valueInput.isEmpty() && kind != Operation::Remove) return;
+        if (needsIndex && indexInput.isEmpty()) return;
+        int value = valueInput.isEmpty() ? 0 : std::stoi(valueInput.getText());
+        int index = needsIndex ? std::stoi(indexInput.getText()) : 0;
+        pending.push_back({kind, index, value});
+        valueInput.clear();
+        indexInput.clear();
+    };
+
+    std::vector<std::unique_ptr<Button>> buttons;
+    buttons.emplace_back(new Button("Insert front", font, {280.f, 125.f}, {130.f, 40.f},
+                        sf::Color(0, 100, 0, 200), sf::Color::White));
+    buttons.back()->setAction([&]() { submit(Operation::InsertAtHead, false); });
+    buttons.emplace_back(new Button("Insert end", font, {420.f, 125.f}, {130.f, 40.f},
+                        sf::Color(0, 100, 0, 200), sf::Color::White));
+    buttons.back()->setAction([&]() { submit(Operation::InsertAtTail, false); });
+    buttons.emplace_back(new Button("Insert at", font, {560.f, 125.f}, {130.f, 40.f},
+                        sf::Color(0, 100, 0, 200), sf::Color::White));
+    buttons.back()->setAction([&]() { submit(Operation::Insert, true); });
+    buttons.emplace_back(new Button("Remove at", font, {700.f, 125.f}, {130.f, 40.f},
+                        sf::Color(100, 0, 0, 200), sf::Color::White));
+    buttons.back()->setAction([&]() { submit(Operation::Remove, true); });
+    buttons.emplace_back(new Button("Update at", font, {280.f, 175.f}, {130.f, 40.f},
+                        sf::Color(0, 100, 0, 200), sf::Color::White));
+    buttons.back()->setAction([&]() { submit(Operation::Update, true); });
+    buttons.emplace_back(new Button("Search", font, {420.f, 175.f}, {130.f, 40.f},
+                        sf::Color(100, 100, 0, 200), sf::Color::White));
+    buttons.back()->setAction([&]() { submit(Operation::Search, false); });
+    buttons.emplace_back(new Button("Play stream", font, {560.f, 175.f}, {130.f, 40.f},
+                        sf::Color(0, 0, 100, 200), sf::Color::White));
+    Button& streamButton = *buttons.back();
+    streamButton.setAction([&]() {
+        streaming = !streaming;
+        streamButton.setLabel(streaming ? "Stop stream" : "Play stream");
+    });
+    buttons.emplace_back(new Button("Reset totals", font, {700.f, 175.f}, {130.f, 40.f},
+                        sf::Color(100, 100, 0, 200), sf::Color::White));
+    buttons.back()->setAction([&]() {
+        arrayCost.reset();
+        listCost.reset();
+    });
+    buttons.emplace_back(new Button("Back to Menu", font, {975.f, 25.f}, {200.f, 50.f},
+                        sf::Color(150, 0, 0, 200), sf::Color::White));
+    buttons.back()->setAction([&]() {
+        window.close();
+    });
+
+    // Loads both panes with the same values
+    WorkloadPanel workloadPanel(font, {900.f, 220.f}, 99);
+    workloadPanel.setAction([&](const std::vector<int>& values) {
+        if (running) return false;
+        pending.clear();
+        arrayVis.load(values);
+        listVis.load(values);
+        arrayCost.reset();
+        listCost.reset();
+        return true;
+    });
+
+    sf::Text title("Array vs Linked List", font, 30);
+    title.setPosition(20.f, 20.f);
+    sf::Text status("", font, 16);
+    status.setFillColor(sf::Color(200, 200, 200));
+    status.setPosition(50.f, 180.f);
+    sf::Text arrayHeader("", font, 16);
+    arrayHeader.setPosition(50.f, 235.f);
+    sf::Text listHeader("", font, 16);
+    listHeader.setPosition(50.f, 530.f);
+
+    // Positions past the end are dropped when the operation comes up, since
+    // earlier operations may have changed the size
+    auto valid = [&](const CompareOperation& op) {
+        switch (op.kind) {
+            case Operation::Insert:
+                return op.index >= 0 && op.index <= arraySize();
+            case Operation::Remove:
+            case Operation::Update:
+                return op.index >= 0 && op.index < arraySize();
+            default:
+                return true;
+        }
+    };
+
+    // The list visualizer counts positions from 1
+    auto step = [&](const CompareOperation& op) {
+        switch (op.kind) {
+            case Operation::InsertAtHead:
+                if (!arrayDone) arrayVis.insert(0, op.value, arrayDone);
+                if (!listDone) listVis.insertAtHead(op.value, listDone);
+                break;
+            case Operation::InsertAtTail:
+                if (!arrayDone) arrayVis.insert(arraySize(), op.value, arrayDone);
+                if (!listDone) listVis.insertAtTail(op.value, listDone);
+                break;
+            case Operation::Insert:
+                if (!arrayDone) arrayVis.insert(op.index, op.value, arrayDone);
+                if (!listDone) listVis.insertAtanyposition(op.value, op.index + 1, listDone);
+                break;
+            case Operation::Remove:
+                if (!arrayDone) arrayVis.remove(op.index, arrayDone);
+                if (!listDone) listVis.deletenode(op.index + 1, listDone);
+                break;
+            case Operation::Update:
+                if (!arrayDone) arrayVis.updateValue(op.index, op.value, arrayDone);
+                if (!listDone) listVis.updatenode(op.index + 1, op.value, listDone);
+                break;
+            case Operation::Search:
+                if (!arrayDone) arrayVis.search(op.value, arrayDone);
+                if (!listDone) listVis.searchNode(op.value, listDone);
+                break;
+            default:
+                arrayDone = listDone = true;
+                break;
+        }
+    };
+
+    auto nextStreamOperation = [&]() {
+        int size = arraySize();
+        int value = static_cast<int>(streamRng() % 100);
+        int roll = static_cast<int>(streamRng() % 100);
+        if (size >= STREAM_MAX_SIZE || (size > STREAM_MIN_SIZE && roll < 25)) {
+            return CompareOperation{Operation::Remove, static_cast<int>(streamRng() % size), 0};
+        }
+        if (roll < 45) return CompareOperation{Operation::InsertAtHead, 0, value};
+        if (roll < 60) return CompareOperation{Operation::InsertAtTail, 0, value};
+        if (roll < 80) return CompareOperation{Operation::Insert, static_cast<int>(streamRng() % (size + 1)), value};
+        return CompareOperation{Operation::Search, 0, value};
+    };
+
+    RenderContext context(window);
+
+    while (window.isOpen()) {
+        context.resetStats();
+        sf::Event event;
+        while (window.pollEvent(event)) {
+            if (event.type == sf::Event::Closed) {
+                window.close();
+            }
+            workloadPanel.handleEvent(event, window);
+            valueInput.handleEvent(event, window);
+            indexInput.handleEvent(event, window);
+            for (auto& btn : buttons) {
+                btn->handleEvent(event, window);
+            }
+        }
+
+        if (!running && pending.empty() && streaming) {
+            pending.push_back(nextStreamOperation());
+        }
+        if (!running && !pending.empty()) {
+            current = pending.front();
+            pending.pop_front();
+            if (valid(current)) {
+                running = true;
+                arrayDone = listDone = false;
+            }
+        }
+        if (running) {
+            step(current);
+            running = !(arrayDone && listDone);
+        }
+
+        arrayHeader.setString("Array (contiguous, inserts and removes shift the tail)\n" + arrayCost.summary());
+        listHeader.setString("Linked list (nodes, positions are reached by walking from the head)\n" + listCost.summary());
+        std::string statusText = std::to_string(pending.size()) + " queued";
+        if (arrayCost.total() > 0 && listCost.total() > 0) {
+            char ratio[64];
+            std::snprintf(ratio, sizeof(ratio), "    list / array total time: %.2fx",
+                          listCost.total() / arrayCost.total());
+            statusText += ratio;
+        }
+        status.setString(statusText);
+
+        window.clear(sf::Color(30, 30, 30));
+        arrayVis.draw(context);
+        listVis.draw(context);
+        context.draw(title);
+        context.draw(status);
+        context.draw(arrayHeader);
+        context.draw(listHeader);
+        valueInput.draw(context);
+        indexInput.draw(context);
+        for (auto& btn : buttons) {
+            btn->draw(context);
+        }
+        workloadPanel.draw(context);
+        window.display();
+    }
+}
+
+// Tools that reuse the visualizers (e.g. bench/renderbench.cpp) include this
+// file with DSV_NO_MAIN defined and provide their own main().
+#ifndef DSV_NO_MAIN
+
+// Render the batch's final state offscreen and save it as an image
+bool dumpbatchframe(const std::string& structure, const core::BatchResult& result,
+                    sf::Font& font, const std::string& path) {
+    sf::RenderTexture texture;
+    if (!texture.create(structure == "binary-tree" ? 1800 : 1200, structure == "binary-tree" ? 800 : 672)) {
+        return false;
+    }
+    texture.clear(sf::Color(30, 30, 30));
+    RenderContext context(texture);
+
+    if (structure == "array") {
+        ArrayVisualizer vis(font, {50.f, 500.f}, 60.f, 60.f);
+        vis.load(result.values);
+        vis.draw(context);
+    } else if (structure == "string") {
+        StringVisualizer vis(font, {730.f, 500}, 40.f, 40.f);
+        vis.load(result.text);
+        vis.draw(context);
+    } else if (structure == "linked-list") {
+        Linkedlistvisualizer vis(font, {50.f, 500.f}, 60.f, 60.f);
+        vis.load(result.values);
+        vis.draw(context);
+    } else if (structure == "stack") {
+        StackVisualizer vis(font, {50.f, 500.f}, 60.f, 60.f);
+        vis.load(result.values);
+        vis.draw(context);
+    } else if (structure == "queue") {
+        QueueVisualizer vis(font, {50.f, 500.f}, 60.f, 60.f);
+        vis.load(result.values);
+        vis.draw(context);
+    } else {
+        BinaryTreeVisualizer vis(font, {1100.f, 150.f}, 25.f);
+        vis.load(result.values);
+        vis.draw(context);
+    }
+
+    texture.display();
+    return texture.getTexture().copyToImage().saveToFile(path);
+}
+
+// main --batch <structure> [--verbose] [--show N] [--frame FILE]
+//             [--load SNAPSHOT] [--save SNAPSHOT] < ops.txt
+// Runs the script on stdin against the core structure with no window. See
+// core/batch.h for the operation language. --load starts from a snapshot
+// instead of an empty structure, --save snapshots the final state.
+int runbatchmode(int argc, char** argv) {
+    if (argc < 3 || !core::isBatchStructure(argv[2])) {
+        std::cerr << "usage: main --batch <array|string|linked-list|stack|queue|binary-tree>\n"
+                     "            [--verbose] [--show N] [--frame FILE]\n"
+                     "            [--load SNAPSHOT] [--save SNAPSHOT] < ops.txt\n";
+        return EXIT_FAILURE;
+    }
+    std::string structure = argv[2];
+    core::BatchOptions options;
+    std::string framePath;
+    std::string loadPath;
+    std::string savePath;
+
+    for (int i = 3; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--verbose") {
+            options.verbose = true;
+        } else if (arg == "--show" && i + 1 < argc) {
+            options.showLimit = std::strtoul(argv[++i], nullptr, 10);
+        } else if (arg == "--frame" && i + 1 < argc) {
+            framePath = argv[++i];
+        } else if (arg == "--load" && i + 1 < argc) {
+            loadPath = argv[++i];
+        } else if (arg == "--save" && i + 1 < argc) {
+            savePath = argv[++i];
+        } else {
+            std::cerr << "unknown option '" << arg << "'\n";
+            return EXIT_FAILURE;
+        }
+    }
+
+    core::SnapshotReader snapshot;
+    std::string error;
+    if (!loadPath.empty()) {
+        if (!snapshot.open(loadPath, error)) {
+            std::cerr << error << "\n";
+            return EXIT_FAILURE;
+        }
+        options.initial = &snapshot;
+    }
+
+    std::ios::sync_with_stdio(false);
+    core::BatchResult result;
+    if (!core::runBatch(structure, std::cin, std::cout, std::cerr, options, result)) {
+        return EXIT_FAILURE;
+    }
+
+    if (!savePath.empty()) {
+        bool saved = structure == "string" ? core::saveSnapshot(savePath, result.text, error)
+                                           : core::saveSnapshot(savePath, structure, result.values, error);
+        if (!saved) {
+            std::cerr << error << "\n";
+            return EXIT_FAILURE;
+        }
+    }
+
+    if (!framePath.empty()) {
+        sf::Font font;
+        if (!font.loadFromFile("arial.ttf") || !dumpbatchframe(structure, result, font, framePath)) {
+            std::cerr << "could not write frame to " << framePath << "\n";
+            return EXIT_FAILURE;
+        }
+    }
+    return 0;
+}
+
+// Writes a batch script filling a structure with a generated workload, e.g.
+//   main --generate binary-tree sorted 5000 | main --batch binary-tree
+int rungeneratemode(int argc, char** argv) {
+    core::WorkloadSpec spec;
+    if (argc < 5 || !core::isBatchStructure(argv[2]) || !core::parseWorkload(argv[3], spec.kind)) {
+        std::cerr << "usage: main --generate <array|string|linked-list|stack|queue|binary-tree>\n"
+                     "            <uniform|sorted|reverse|nearly-sorted|zipf|duplicates|zigzag|organ-pipe>\n"
+                     "            <count> [--seed S] [--max V]\n";
+        return EXIT_FAILURE;
+    }
+    spec.count = std::strtoul(argv[4], nullptr, 10);
+
+    for (int i = 5; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--seed" && i + 1 < argc) {
+            spec.seed = std::strtoull(argv[++i], nullptr, 10);
+        } else if (arg == "--max" && i + 1 < argc) {
+            spec.maxValue = std::atoi(argv[++i]);
+        } else {
+            std::cerr << "unknown option '" << arg << "'\n";
+            return EXIT_FAILURE;
+        }
+    }
+
+    std::ios::sync_with_stdio(false);
+    return core::writeFillScript(argv[2], core::generateWorkload(spec), std::cout) ? 0 : EXIT_FAILURE;
 }
 
-int main() {
+int main(int argc, char** argv) {
+#ifdef DSV_TRACE
+    core::Trace::setThreadName("main");
+#endif
+    if (argc > 1 && std::string(argv[1]) == "--batch") {
+        return runbatchmode(argc, argv);
+    }
+    if (argc > 1 && std::string(argv[1]) == "--generate") {
+        return rungeneratemode(argc, argv);
+    }
+    for (int i = 1; i < argc; ++i) {
+        if (std::string(argv[i]) == "--track-allocs") {
+            core::AllocTracker::enable(true);  // Shown in each visualizer's HUD
+        } else if (std::string(argv[i]) == "--render-stats") {
+            RenderStatsHud::enabled = true;
+        }
+    }
+
     // Load font
     sf::Font font;
     if (!font.loadFromFile("arial.ttf")) {
@@ -4618,8 +8686,18 @@ int main() {
             else if(selected == "binary-tree"){
                 runbinarytreevisualizer(font);
             }
+            else if(selected == "complexity"){
+                runcomplexityexplorer(font);
+            }
+            else if(selected == "compare"){
+                runcomparisonmode(font);
+            }
+            else if(selected == "matrix"){
+                runmatrixvisualizer(font);
+            }
         }
     }
 
     return 0;
-}
\ No newline at end of file
+}
+#endif // DSV_NO_MAIN
\ No newline at end of file